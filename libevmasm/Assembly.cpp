@@ -34,19 +34,25 @@
 #include <liblangutil/Exceptions.h>
 
 #include <libsolutil/JSON.h>
+#include <libsolutil/Parallel.h>
+#include <libsolutil/Profiler.h>
 #include <libsolutil/StringUtils.h>
 
 #include <fmt/format.h>
 
+#include <boost/container_hash/hash.hpp>
+
 #include <range/v3/algorithm/any_of.hpp>
 #include <range/v3/view/drop_exactly.hpp>
 #include <range/v3/view/enumerate.hpp>
 #include <range/v3/view/map.hpp>
 
+#include <algorithm>
 #include <fstream>
 #include <limits>
 #include <iterator>
 #include <stack>
+#include <unordered_map>
 
 using namespace solidity;
 using namespace solidity::evmasm;
@@ -54,6 +60,7 @@ using namespace solidity::langutil;
 using namespace solidity::util;
 
 std::map<std::string, std::shared_ptr<std::string const>> Assembly::s_sharedSourceNames;
+std::mutex Assembly::s_sharedSourceNamesMutex;
 
 AssemblyItem const& Assembly::append(AssemblyItem _i)
 {
@@ -62,10 +69,21 @@ AssemblyItem const& Assembly::append(AssemblyItem _i)
 	solAssert(m_currentCodeSection < m_codeSections.size());
 	auto& currentItems = m_codeSections.at(m_currentCodeSection).items;
 	currentItems.emplace_back(std::move(_i));
-	if (!currentItems.back().location().isValid() && m_currentSourceLocation.isValid())
-		currentItems.back().setLocation(m_currentSourceLocation);
-	currentItems.back().m_modifierDepth = m_currentModifierDepth;
-	return currentItems.back();
+	AssemblyItem& item = currentItems.back();
+	if (!item.location().isValid() && m_currentSourceLocation.isValid())
+	{
+		langutil::DebugData::ConstPtr debugData = item.debugData();
+		if (!debugData->originLocation.isValid() && !debugData->astID)
+		{
+			if (!m_currentDebugData)
+				m_currentDebugData = langutil::DebugData::create(m_currentSourceLocation);
+			item.setDebugData(m_currentDebugData);
+		}
+		else
+			item.setLocation(m_currentSourceLocation);
+	}
+	item.m_modifierDepth = m_currentModifierDepth;
+	return item;
 }
 
 unsigned Assembly::codeSize(unsigned subTagSize) const
@@ -683,6 +701,7 @@ void Assembly::encodeAllPossibleSubPathsInAssemblyTree(std::vector<size_t> _path
 
 std::shared_ptr<std::string const> Assembly::sharedSourceName(std::string const& _name) const
 {
+	std::lock_guard lock(s_sharedSourceNamesMutex);
 	if (s_sharedSourceNames.find(_name) == s_sharedSourceNames.end())
 		s_sharedSourceNames[_name] = std::make_shared<std::string>(_name);
 
@@ -774,10 +793,68 @@ AssemblyItem Assembly::newAuxDataLoadN(size_t _offset)
 
 Assembly& Assembly::optimise(OptimiserSettings const& _settings)
 {
+	PROFILER_PROBE("EVMAssemblyOptimiser", probe);
 	optimiseInternal(_settings, {});
 	return *this;
 }
 
+namespace
+{
+
+/// Basic blocks in which the common subexpression eliminator did not find an improvement.
+/// Its result only depends on the types and data of the items of a block and on whether
+/// msize is used, so it would not find an improvement in the same blocks again.
+class UnimprovableBlocks
+{
+public:
+	using Iterator = AssemblyItems::const_iterator;
+
+	/// Forgets all blocks if @a _usesMSize differs from the value the blocks were found with.
+	void setUsesMSize(bool _usesMSize)
+	{
+		if (_usesMSize != m_usesMSize)
+			m_blocks.clear();
+		m_usesMSize = _usesMSize;
+	}
+
+	bool contains(Iterator _begin, Iterator _end) const
+	{
+		auto blocks = m_blocks.find(fingerprint(_begin, _end));
+		return blocks != m_blocks.end() && ranges::any_of(blocks->second, [&](AssemblyItems const& _block) {
+			return std::equal(_block.begin(), _block.end(), _begin, _end);
+		});
+	}
+
+	void insert(Iterator _begin, Iterator _end)
+	{
+		m_blocks[fingerprint(_begin, _end)].emplace_back(_begin, _end);
+	}
+
+private:
+	/// @returns a hash of the types and data of the items, i.e. ignoring their debug data.
+	static size_t fingerprint(Iterator _begin, Iterator _end)
+	{
+		size_t seed = 0;
+		for (auto it = _begin; it != _end; ++it)
+		{
+			boost::hash_combine(seed, it->type());
+			if (it->type() == Operation)
+				boost::hash_combine(seed, it->instruction());
+			else if (it->type() == VerbatimBytecode)
+				boost::hash_range(seed, it->verbatimData().begin(), it->verbatimData().end());
+			else
+				boost::hash_combine(seed, it->data());
+		}
+		return seed;
+	}
+
+	bool m_usesMSize = false;
+	/// Blocks by their fingerprint.
+	std::unordered_map<size_t, std::vector<AssemblyItems>> m_blocks;
+};
+
+}
+
 std::map<u256, u256> const& Assembly::optimiseInternal(
 	OptimiserSettings const& _settings,
 	std::set<size_t> _tagsReferencedFromOutside
@@ -787,24 +864,31 @@ std::map<u256, u256> const& Assembly::optimiseInternal(
 		return *m_tagReplacements;
 
 	// Run optimisation for sub-assemblies.
+	// The tag replacements of a sub-assembly only affect the items referring to that sub-assembly,
+	// so siblings can be optimised concurrently as long as they do not share any assembly that
+	// still needs to be optimised. The replacements are applied afterwards, in order.
 	// TODO: verify and double-check this for EOF.
+	std::vector<std::set<size_t>> referencedTags(m_subs.size());
 	for (size_t subId = 0; subId < m_subs.size(); ++subId)
-	{
-		OptimiserSettings settings = _settings;
-		Assembly& sub = *m_subs[subId];
-		std::set<size_t> referencedTags;
 		for (auto& codeSection: m_codeSections)
-			referencedTags += JumpdestRemover::referencedTags(codeSection.items, subId);
-		std::map<u256, u256> const& subTagReplacements = sub.optimiseInternal(
-			settings,
-			referencedTags
-		);
+			referencedTags[subId] += JumpdestRemover::referencedTags(codeSection.items, subId);
+
+	size_t maxThreads = (m_subs.size() > 1 && subAssembliesIndependent()) ? _settings.maxThreads : 1;
+	OptimiserSettings subSettings = _settings;
+	if (maxThreads > 1)
+		subSettings.maxThreads = 1;
+	std::vector<std::map<u256, u256> const*> subTagReplacements(m_subs.size(), nullptr);
+	util::parallelFor(m_subs.size(), maxThreads, [&](size_t _subId) {
+		subTagReplacements[_subId] = &m_subs[_subId]->optimiseInternal(subSettings, referencedTags[_subId]);
+	});
+
+	for (size_t subId = 0; subId < m_subs.size(); ++subId)
 		// Apply the replacements (can be empty).
 		for (auto& codeSection: m_codeSections)
-			BlockDeduplicator::applyTagReplacement(codeSection.items, subTagReplacements, subId);
-	}
+			BlockDeduplicator::applyTagReplacement(codeSection.items, *subTagReplacements[subId], subId);
 
 	std::map<u256, u256> tagReplacements;
+	UnimprovableBlocks unimprovableBlocks;
 	// Iterate until no new optimisation possibilities are found.
 	for (unsigned count = 1; count > 0;)
 	{
@@ -888,14 +972,24 @@ std::map<u256, u256> const& Assembly::optimiseInternal(
 			bool usesMSize = ranges::any_of(items, [](AssemblyItem const& _i) {
 				return _i == AssemblyItem{Instruction::MSIZE} || _i.type() == VerbatimBytecode;
 			});
+			unimprovableBlocks.setUsesMSize(usesMSize);
 
-			auto iter = items.begin();
-			while (iter != items.end())
+			auto iter = items.cbegin();
+			while (iter != items.cend())
 			{
+				// Blocks the other steps did not change since the previous iteration are skipped.
+				auto blockEnd = CommonSubexpressionEliminator::blockEnd(iter, items.cend(), usesMSize);
+				if (unimprovableBlocks.contains(iter, blockEnd))
+				{
+					copy(iter, blockEnd, back_inserter(optimisedItems));
+					iter = blockEnd;
+					continue;
+				}
+
 				KnownState emptyState;
 				CommonSubexpressionEliminator eliminator{emptyState};
 				auto orig = iter;
-				iter = eliminator.feedItems(iter, items.end(), usesMSize);
+				iter = eliminator.feedItems(iter, items.cend(), usesMSize);
 				bool shouldReplace = false;
 				AssemblyItems optimisedChunk;
 				try
@@ -920,7 +1014,10 @@ std::map<u256, u256> const& Assembly::optimiseInternal(
 					optimisedItems += optimisedChunk;
 				}
 				else
+				{
+					unimprovableBlocks.insert(orig, iter);
 					copy(orig, iter, back_inserter(optimisedItems));
+				}
 			}
 			if (optimisedItems.size() < items.size())
 			{
@@ -943,6 +1040,28 @@ std::map<u256, u256> const& Assembly::optimiseInternal(
 	return *m_tagReplacements;
 }
 
+bool Assembly::subAssembliesIndependent() const
+{
+	std::map<Assembly const*, size_t> owningSubId;
+	std::function<bool(Assembly const&, size_t)> visit = [&](Assembly const& _assembly, size_t _subId) {
+		// Optimised assemblies are not modified any more and can be shared freely.
+		if (_assembly.m_tagReplacements)
+			return true;
+		auto [it, inserted] = owningSubId.emplace(&_assembly, _subId);
+		if (!inserted)
+			return it->second == _subId;
+		for (auto const& sub: _assembly.m_subs)
+			if (!visit(*sub, _subId))
+				return false;
+		return true;
+	};
+
+	for (size_t subId = 0; subId < m_subs.size(); ++subId)
+		if (!visit(*m_subs[subId], subId))
+			return false;
+	return true;
+}
+
 namespace
 {
 template<typename ValueT>
@@ -1752,7 +1871,7 @@ Assembly const* Assembly::subAssemblyById(size_t _subId) const
 Assembly::OptimiserSettings Assembly::OptimiserSettings::translateSettings(frontend::OptimiserSettings const& _settings, langutil::EVMVersion const& _evmVersion)
 {
 	// Constructing it this way so that we notice changes in the fields.
-	evmasm::Assembly::OptimiserSettings asmSettings{false,  false, false, false, false, false, _evmVersion, 0};
+	evmasm::Assembly::OptimiserSettings asmSettings{false,  false, false, false, false, false, _evmVersion, 0, 1};
 	asmSettings.runInliner = _settings.runInliner;
 	asmSettings.runJumpdestRemover = _settings.runJumpdestRemover;
 	asmSettings.runPeephole = _settings.runPeephole;
@@ -38,6 +38,7 @@
 #include <sstream>
 #include <memory>
 #include <map>
+#include <mutex>
 #include <utility>
 
 namespace solidity::evmasm
@@ -151,7 +152,13 @@ public:
 	std::string const& name() const { return m_name; }
 
 	/// Changes the source location used for each appended item.
-	void setSourceLocation(langutil::SourceLocation const& _location) { m_currentSourceLocation = _location; }
+	void setSourceLocation(langutil::SourceLocation const& _location)
+	{
+		if (_location == m_currentSourceLocation)
+			return;
+		m_currentSourceLocation = _location;
+		m_currentDebugData.reset();
+	}
 	langutil::SourceLocation const& currentSourceLocation() const { return m_currentSourceLocation; }
 	langutil::EVMVersion const& evmVersion() const { return m_evmVersion; }
 
@@ -170,6 +177,9 @@ public:
 		/// This specifies an estimate on how often each opcode in this assembly will be executed,
 		/// i.e. use a small value to optimise for size and a large value to optimise for runtime gas usage.
 		size_t expectedExecutionsPerDeployment = frontend::OptimiserSettings{}.expectedExecutionsPerDeployment;
+		/// Maximum number of threads used to optimise independent sub-assemblies concurrently.
+		/// Does not affect the result.
+		size_t maxThreads = 1;
 
 		static OptimiserSettings translateSettings(frontend::OptimiserSettings const& _settings, langutil::EVMVersion const& _evmVersion);
 	};
@@ -240,6 +250,9 @@ protected:
 	/// returns the replaced tags. Also takes an argument containing the tags of this assembly
 	/// that are referenced in a super-assembly.
 	std::map<u256, u256> const& optimiseInternal(OptimiserSettings const& _settings, std::set<size_t> _tagsReferencedFromOutside);
+	/// @returns true if no assembly that is still to be optimised is reachable from more
+	/// than one sub-assembly, i.e. if the sub-assemblies can be optimised concurrently.
+	bool subAssembliesIndependent() const;
 
 	/// For EOF and legacy it calculates approximate size of "pure" code without data.
 	unsigned codeSize(unsigned subTagSize) const;
@@ -328,9 +341,12 @@ protected:
 	/// currently
 	std::string m_name;
 	langutil::SourceLocation m_currentSourceLocation;
+	/// Debug data shared by the items appended at the current source location, created on demand.
+	langutil::DebugData::ConstPtr m_currentDebugData;
 
 	// FIXME: This being static means that the strings won't be freed when they're no longer needed
 	static std::map<std::string, std::shared_ptr<std::string const>> s_sharedSourceNames;
+	static std::mutex s_sharedSourceNamesMutex;
 
 public:
 	size_t m_currentModifierDepth = 0;
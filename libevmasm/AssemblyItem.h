@@ -31,6 +31,8 @@
 #include <libsolutil/Assertions.h>
 #include <optional>
 #include <iostream>
+#include <limits>
+#include <memory>
 #include <sstream>
 
 namespace solidity::evmasm
@@ -91,20 +93,21 @@ public:
 		if (m_type == Operation)
 			m_instruction = Instruction(uint8_t(_data));
 		else
-			m_data = std::make_shared<u256>(std::move(_data));
+			setData(_data);
 	}
 
 	explicit AssemblyItem(AssemblyItemType _type, Instruction _instruction, u256 _data = 0, langutil::DebugData::ConstPtr _debugData = langutil::DebugData::create()):
 		m_type(_type),
 		m_instruction(_instruction),
-		m_data(std::make_shared<u256>(std::move(_data))),
 		m_debugData(std::move(_debugData))
-	{}
+	{
+		setData(_data);
+	}
 
 	explicit AssemblyItem(bytes _verbatimData, size_t _arguments, size_t _returnVariables):
 		m_type(VerbatimBytecode),
 		m_instruction{},
-		m_verbatimBytecode{{_arguments, _returnVariables, std::move(_verbatimData)}},
+		m_verbatimBytecode{std::make_shared<std::tuple<size_t, size_t, bytes> const>(_arguments, _returnVariables, std::move(_verbatimData))},
 		m_debugData{langutil::DebugData::create()}
 	{}
 
@@ -167,8 +170,25 @@ public:
 	void setPushTagSubIdAndTag(size_t _subId, size_t _tag);
 
 	AssemblyItemType type() const { return m_type; }
-	u256 const& data() const { solAssert(m_type != Operation && m_data != nullptr); return *m_data; }
-	void setData(u256 const& _data) { assertThrow(m_type != Operation, util::Exception, ""); m_data = std::make_shared<u256>(_data); }
+	u256 data() const
+	{
+		solAssert(m_type != Operation && m_type != VerbatimBytecode);
+		return m_largeData ? *m_largeData : u256(m_smallData);
+	}
+	void setData(u256 const& _data)
+	{
+		assertThrow(m_type != Operation, util::Exception, "");
+		if (_data <= std::numeric_limits<uint64_t>::max())
+		{
+			m_smallData = static_cast<uint64_t>(_data);
+			m_largeData.reset();
+		}
+		else
+		{
+			m_smallData = 0;
+			m_largeData = std::make_shared<u256 const>(_data);
+		}
+	}
 
 	/// This function is used in `Assembly::assemblyJSON`.
 	/// It returns the name & data of the current assembly item.
@@ -209,8 +229,10 @@ public:
 			return instruction() == _other.instruction();
 		else if (type() == VerbatimBytecode)
 			return *m_verbatimBytecode == *_other.m_verbatimBytecode;
+		else if (m_largeData && _other.m_largeData)
+			return *m_largeData == *_other.m_largeData;
 		else
-			return data() == _other.data();
+			return !m_largeData && !_other.m_largeData && m_smallData == _other.m_smallData;
 	}
 	bool operator!=(AssemblyItem const& _other) const { return !operator==(_other); }
 	/// Less-than operator compatible with operator==.
@@ -222,8 +244,13 @@ public:
 			return instruction() < _other.instruction();
 		else if (type() == VerbatimBytecode)
 			return *m_verbatimBytecode < *_other.m_verbatimBytecode;
+		// Large values are larger than all values stored inline.
+		else if (m_largeData && _other.m_largeData)
+			return *m_largeData < *_other.m_largeData;
+		else if (m_largeData || _other.m_largeData)
+			return !m_largeData;
 		else
-			return data() < _other.data();
+			return m_smallData < _other.m_smallData;
 	}
 
 	/// Shortcut that avoids constructing an AssemblyItem just to perform the comparison.
@@ -312,13 +339,18 @@ private:
 
 	AssemblyItemType m_type;
 	Instruction m_instruction; ///< Only valid if m_type == Operation
-	std::shared_ptr<u256> m_data; ///< Only valid if m_type != Operation
 	std::optional<FunctionSignature> m_functionSignature; ///< Only valid if m_type == CallF or JumpF
+	JumpType m_jumpType = JumpType::Ordinary;
+	/// The data (only valid if m_type != Operation). Values that fit into 64 bits, which includes
+	/// the tags of the assembly itself, are stored inline in m_smallData. Larger values, including
+	/// tags referring to sub-assemblies (which store the sub-assembly above bit 64), are stored in
+	/// m_largeData, which is shared between copies of the item.
+	uint64_t m_smallData = 0;
+	std::shared_ptr<u256 const> m_largeData;
 	/// If m_type == VerbatimBytecode, this holds number of arguments, number of
-	/// return variables and verbatim bytecode.
-	std::optional<std::tuple<size_t, size_t, bytes>> m_verbatimBytecode;
+	/// return variables and verbatim bytecode. Shared between copies of the item.
+	std::shared_ptr<std::tuple<size_t, size_t, bytes> const> m_verbatimBytecode;
 	langutil::DebugData::ConstPtr m_debugData;
-	JumpType m_jumpType = JumpType::Ordinary;
 	/// Pushed value for operations with data to be determined during assembly stage,
 	/// e.g. PushSubSize, PushTag, PushSub, etc.
 	mutable std::shared_ptr<u256> m_pushedValue;
@@ -24,6 +24,7 @@
 
 #pragma once
 
+#include <iterator>
 #include <map>
 #include <ostream>
 #include <set>
@@ -74,6 +75,11 @@ public:
 	template <class AssemblyItemIterator>
 	AssemblyItemIterator feedItems(AssemblyItemIterator _iterator, AssemblyItemIterator _end, bool _msizeImportant);
 
+	/// @returns the iterator pointing at the first item after the items that feedItems
+	/// consumes, i.e. after the basic block starting at @a _iterator and the item breaking it.
+	template <class AssemblyItemIterator>
+	static AssemblyItemIterator blockEnd(AssemblyItemIterator _iterator, AssemblyItemIterator _end, bool _msizeImportant);
+
 	/// @returns the resulting items after optimization.
 	AssemblyItems getOptimizedItems();
 
@@ -179,6 +185,23 @@ AssemblyItemIterator CommonSubexpressionEliminator::feedItems(
 )
 {
 	assertThrow(!m_breakingItem, OptimizerException, "Invalid use of CommonSubexpressionEliminator.");
+	AssemblyItemIterator end = blockEnd(_iterator, _end, _msizeImportant);
+	for (; _iterator != end; ++_iterator)
+		// Only the last item of a block can break it.
+		if (std::next(_iterator) == end && SemanticInformation::breaksCSEAnalysisBlock(*_iterator, _msizeImportant))
+			m_breakingItem = &(*_iterator);
+		else
+			feedItem(*_iterator);
+	return end;
+}
+
+template <class AssemblyItemIterator>
+AssemblyItemIterator CommonSubexpressionEliminator::blockEnd(
+	AssemblyItemIterator _iterator,
+	AssemblyItemIterator _end,
+	bool _msizeImportant
+)
+{
 	unsigned const maxChunkSize = 2000;
 	unsigned chunkSize = 0;
 	for (
@@ -186,9 +209,9 @@ AssemblyItemIterator CommonSubexpressionEliminator::feedItems(
 		_iterator != _end && !SemanticInformation::breaksCSEAnalysisBlock(*_iterator, _msizeImportant) && chunkSize < maxChunkSize;
 		++_iterator, ++chunkSize
 	)
-		feedItem(*_iterator);
+	{}
 	if (_iterator != _end && chunkSize < maxChunkSize)
-		m_breakingItem = &(*_iterator++);
+		++_iterator;
 	return _iterator;
 }
 
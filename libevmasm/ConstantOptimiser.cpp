@@ -24,9 +24,14 @@
 #include <libevmasm/Assembly.h>
 #include <libevmasm/GasMeter.h>
 
+#include <libsolutil/CommonData.h>
+
 using namespace solidity;
 using namespace solidity::evmasm;
 
+std::map<ComputeMethod::RepresentationKey, AssemblyItems> ComputeMethod::s_representations;
+std::mutex ComputeMethod::s_representationsMutex;
+
 unsigned ConstantOptimisationMethod::optimiseConstants(
 	bool _isCreation,
 	size_t _runs,
@@ -226,6 +231,39 @@ AssemblyItems CodeCopyMethod::copyRoutine(AssemblyItem* _pushData) const
 	}
 }
 
+ComputeMethod::ComputeMethod(Params const& _params, u256 const& _value):
+	ConstantOptimisationMethod(_params, _value)
+{
+	// The search starts with the same step budget for every value, so its result only depends on the key.
+	RepresentationKey key{m_value, m_params.isCreation, m_params.runs, m_params.multiplicity, m_params.evmVersion};
+	{
+		std::lock_guard lock(s_representationsMutex);
+		if (AssemblyItems const* routine = util::valueOrNullptr(s_representations, key))
+		{
+			m_routine = *routine;
+			return;
+		}
+	}
+
+	m_routine = findRepresentation(m_value);
+	assertThrow(
+		checkRepresentation(m_value, m_routine),
+		OptimizerException,
+		"Invalid constant expression created."
+	);
+
+	std::lock_guard lock(s_representationsMutex);
+	if (s_representations.size() >= s_maxCachedRepresentations)
+		s_representations.clear();
+	s_representations.emplace(std::move(key), m_routine);
+}
+
+void ComputeMethod::clearRepresentationCache()
+{
+	std::lock_guard lock(s_representationsMutex);
+	s_representations.clear();
+}
+
 AssemblyItems ComputeMethod::findRepresentation(u256 const& _value)
 {
 	if (_value < 0x10000)
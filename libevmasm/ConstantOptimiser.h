@@ -29,6 +29,9 @@
 #include <libsolutil/Numeric.h>
 #include <libsolutil/Assertions.h>
 
+#include <map>
+#include <mutex>
+#include <tuple>
 #include <vector>
 
 namespace solidity::evmasm
@@ -95,7 +98,7 @@ protected:
 	static void replaceConstants(AssemblyItems& _items, std::map<u256, AssemblyItems> const& _replacements);
 
 	Params m_params;
-	u256 const& m_value;
+	u256 m_value;
 };
 
 /**
@@ -132,16 +135,13 @@ protected:
 class ComputeMethod: public ConstantOptimisationMethod
 {
 public:
-	explicit ComputeMethod(Params const& _params, u256 const& _value):
-		ConstantOptimisationMethod(_params, _value)
-	{
-		m_routine = findRepresentation(m_value);
-		assertThrow(
-			checkRepresentation(m_value, m_routine),
-			OptimizerException,
-			"Invalid constant expression created."
-		);
-	}
+	/// Looks up the representation of @a _value in a cache shared by all assemblies of the process
+	/// and only computes it if it is not found there.
+	explicit ComputeMethod(Params const& _params, u256 const& _value);
+
+	/// Empties the cache of representations. The optimiser does not depend on its contents,
+	/// this is only used to compare the results of cold and warm caches.
+	static void clearRepresentationCache();
 
 	bigint gasNeeded() const override { return gasNeeded(m_routine); }
 	AssemblyItems execute(Assembly&) const override
@@ -159,6 +159,14 @@ protected:
 	/// Counter for the complexity of optimization, will stop when it reaches zero.
 	size_t m_maxSteps = 10000;
 	AssemblyItems m_routine;
+
+private:
+	/// The value and the parameters the best representation depends on.
+	using RepresentationKey = std::tuple<u256, bool, size_t, size_t, langutil::EVMVersion>;
+	/// Maximum number of cached representations, the cache is cleared when it is reached.
+	static size_t constexpr s_maxCachedRepresentations = 100000;
+	static std::map<RepresentationKey, AssemblyItems> s_representations;
+	static std::mutex s_representationsMutex;
 };
 
 }
@@ -25,6 +25,8 @@
 #include <libevmasm/AssemblyItem.h>
 #include <libevmasm/SemanticInformation.h>
 
+#include <array>
+
 using namespace solidity;
 using namespace solidity::evmasm;
 
@@ -91,6 +93,14 @@ struct Identity: SimplePeepholeOptimizerMethod<Identity>
 
 struct PushPop: SimplePeepholeOptimizerMethod<PushPop>
 {
+	static bool startsWith(AssemblyItemType _type, Instruction _instruction)
+	{
+		if (_type == Operation)
+			return isDupInstruction(_instruction);
+		return
+			_type == Push || _type == PushTag || _type == PushSub ||
+			_type == PushSubSize || _type == PushProgramSize || _type == PushData || _type == PushLibraryAddress;
+	}
 	static bool applySimple(
 		AssemblyItem const& _push,
 		AssemblyItem const& _pop,
@@ -108,6 +118,10 @@ struct PushPop: SimplePeepholeOptimizerMethod<PushPop>
 
 struct OpPop: SimplePeepholeOptimizerMethod<OpPop>
 {
+	static bool startsWith(AssemblyItemType _type, Instruction /* _instruction */)
+	{
+		return _type == Operation;
+	}
 	static bool applySimple(
 		AssemblyItem const& _op,
 		AssemblyItem const& _pop,
@@ -130,6 +144,10 @@ struct OpPop: SimplePeepholeOptimizerMethod<OpPop>
 
 struct OpStop: SimplePeepholeOptimizerMethod<OpStop>
 {
+	static bool startsWith(AssemblyItemType _type, Instruction /* _instruction */)
+	{
+		return _type == Operation || _type == Push;
+	}
 	static bool applySimple(
 		AssemblyItem const& _op,
 		AssemblyItem const& _stop,
@@ -159,6 +177,10 @@ struct OpStop: SimplePeepholeOptimizerMethod<OpStop>
 
 struct OpReturnRevert: SimplePeepholeOptimizerMethod<OpReturnRevert>
 {
+	static bool startsWith(AssemblyItemType _type, Instruction /* _instruction */)
+	{
+		return _type == Operation || _type == Push;
+	}
 	static bool applySimple(
 		AssemblyItem const& _op,
 		AssemblyItem const& _push,
@@ -188,6 +210,10 @@ struct OpReturnRevert: SimplePeepholeOptimizerMethod<OpReturnRevert>
 
 struct DoubleSwap: SimplePeepholeOptimizerMethod<DoubleSwap>
 {
+	static bool startsWith(AssemblyItemType _type, Instruction _instruction)
+	{
+		return _type == Operation && isSwapInstruction(_instruction);
+	}
 	static size_t applySimple(
 		AssemblyItem const& _s1,
 		AssemblyItem const& _s2,
@@ -200,6 +226,10 @@ struct DoubleSwap: SimplePeepholeOptimizerMethod<DoubleSwap>
 
 struct DoublePush
 {
+	static bool startsWith(AssemblyItemType _type, Instruction /* _instruction */)
+	{
+		return _type == Push;
+	}
 	static bool apply(OptimiserState& _state)
 	{
 		size_t windowSize = 2;
@@ -229,6 +259,10 @@ struct DoublePush
 
 struct CommutativeSwap: SimplePeepholeOptimizerMethod<CommutativeSwap>
 {
+	static bool startsWith(AssemblyItemType _type, Instruction _instruction)
+	{
+		return _type == Operation && _instruction == Instruction::SWAP1;
+	}
 	static bool applySimple(
 		AssemblyItem const& _swap,
 		AssemblyItem const& _op,
@@ -251,6 +285,10 @@ struct CommutativeSwap: SimplePeepholeOptimizerMethod<CommutativeSwap>
 
 struct SwapComparison: SimplePeepholeOptimizerMethod<SwapComparison>
 {
+	static bool startsWith(AssemblyItemType _type, Instruction _instruction)
+	{
+		return _type == Operation && _instruction == Instruction::SWAP1;
+	}
 	static bool applySimple(
 		AssemblyItem const& _swap,
 		AssemblyItem const& _op,
@@ -281,6 +319,10 @@ struct SwapComparison: SimplePeepholeOptimizerMethod<SwapComparison>
 /// Remove swapN after dupN
 struct DupSwap: SimplePeepholeOptimizerMethod<DupSwap>
 {
+	static bool startsWith(AssemblyItemType _type, Instruction _instruction)
+	{
+		return _type == Operation && isDupInstruction(_instruction);
+	}
 	static size_t applySimple(
 		AssemblyItem const& _dupN,
 		AssemblyItem const& _swapN,
@@ -304,6 +346,10 @@ struct DupSwap: SimplePeepholeOptimizerMethod<DupSwap>
 
 struct IsZeroIsZeroJumpI: SimplePeepholeOptimizerMethod<IsZeroIsZeroJumpI>
 {
+	static bool startsWith(AssemblyItemType _type, Instruction _instruction)
+	{
+		return _type == Operation && _instruction == Instruction::ISZERO;
+	}
 	static size_t applySimple(
 		AssemblyItem const& _iszero1,
 		AssemblyItem const& _iszero2,
@@ -330,6 +376,10 @@ struct IsZeroIsZeroJumpI: SimplePeepholeOptimizerMethod<IsZeroIsZeroJumpI>
 
 struct IsZeroIsZeroRJumpI: SimplePeepholeOptimizerMethod<IsZeroIsZeroRJumpI>
 {
+	static bool startsWith(AssemblyItemType _type, Instruction _instruction)
+	{
+		return _type == Operation && _instruction == Instruction::ISZERO;
+	}
 	static size_t applySimple(
 		AssemblyItem const& _iszero1,
 		AssemblyItem const& _iszero2,
@@ -353,6 +403,10 @@ struct IsZeroIsZeroRJumpI: SimplePeepholeOptimizerMethod<IsZeroIsZeroRJumpI>
 
 struct EqIsZeroJumpI: SimplePeepholeOptimizerMethod<EqIsZeroJumpI>
 {
+	static bool startsWith(AssemblyItemType _type, Instruction _instruction)
+	{
+		return _type == Operation && _instruction == Instruction::EQ;
+	}
 	static size_t applySimple(
 		AssemblyItem const& _eq,
 		AssemblyItem const& _iszero,
@@ -380,6 +434,10 @@ struct EqIsZeroJumpI: SimplePeepholeOptimizerMethod<EqIsZeroJumpI>
 
 struct EqIsZeroRJumpI: SimplePeepholeOptimizerMethod<EqIsZeroRJumpI>
 {
+	static bool startsWith(AssemblyItemType _type, Instruction _instruction)
+	{
+		return _type == Operation && _instruction == Instruction::EQ;
+	}
 	static size_t applySimple(
 		AssemblyItem const& _eq,
 		AssemblyItem const& _iszero,
@@ -405,6 +463,10 @@ struct EqIsZeroRJumpI: SimplePeepholeOptimizerMethod<EqIsZeroRJumpI>
 // push_tag_1 jumpi push_tag_2 jump tag_1: -> iszero push_tag_2 jumpi tag_1:
 struct DoubleJump: SimplePeepholeOptimizerMethod<DoubleJump>
 {
+	static bool startsWith(AssemblyItemType _type, Instruction /* _instruction */)
+	{
+		return _type == PushTag;
+	}
 	static size_t applySimple(
 		AssemblyItem const& _pushTag1,
 		AssemblyItem const& _jumpi,
@@ -437,6 +499,10 @@ struct DoubleJump: SimplePeepholeOptimizerMethod<DoubleJump>
 // rjumpi(tag_1) rjump(tag_2) tag_1: -> iszero rjumpi(tag_2) tag_1:
 struct DoubleRJump: SimplePeepholeOptimizerMethod<DoubleRJump>
 {
+	static bool startsWith(AssemblyItemType _type, Instruction /* _instruction */)
+	{
+		return _type == ConditionalRelativeJump;
+	}
 	static size_t applySimple(
 		AssemblyItem const& _rjumpi,
 		AssemblyItem const& _rjump,
@@ -463,6 +529,10 @@ struct DoubleRJump: SimplePeepholeOptimizerMethod<DoubleRJump>
 
 struct JumpToNext: SimplePeepholeOptimizerMethod<JumpToNext>
 {
+	static bool startsWith(AssemblyItemType _type, Instruction /* _instruction */)
+	{
+		return _type == PushTag;
+	}
 	static size_t applySimple(
 		AssemblyItem const& _pushTag,
 		AssemblyItem const& _jump,
@@ -489,6 +559,10 @@ struct JumpToNext: SimplePeepholeOptimizerMethod<JumpToNext>
 
 struct RJumpToNext: SimplePeepholeOptimizerMethod<RJumpToNext>
 {
+	static bool startsWith(AssemblyItemType _type, Instruction /* _instruction */)
+	{
+		return _type == ConditionalRelativeJump || _type == RelativeJump;
+	}
 	static size_t applySimple(
 		AssemblyItem const& _rjump,
 		AssemblyItem const& _tag,
@@ -513,6 +587,10 @@ struct RJumpToNext: SimplePeepholeOptimizerMethod<RJumpToNext>
 
 struct TagConjunctions: SimplePeepholeOptimizerMethod<TagConjunctions>
 {
+	static bool startsWith(AssemblyItemType _type, Instruction /* _instruction */)
+	{
+		return _type == PushTag || _type == Push;
+	}
 	static bool applySimple(
 		AssemblyItem const& _pushTag,
 		AssemblyItem const& _pushConstant,
@@ -548,6 +626,10 @@ struct TagConjunctions: SimplePeepholeOptimizerMethod<TagConjunctions>
 
 struct TruthyAnd: SimplePeepholeOptimizerMethod<TruthyAnd>
 {
+	static bool startsWith(AssemblyItemType _type, Instruction /* _instruction */)
+	{
+		return _type == Push;
+	}
 	static bool applySimple(
 		AssemblyItem const& _push,
 		AssemblyItem const& _not,
@@ -566,6 +648,18 @@ struct TruthyAnd: SimplePeepholeOptimizerMethod<TruthyAnd>
 /// Removes everything after a JUMP (or similar) until the next JUMPDEST.
 struct UnreachableCode
 {
+	static bool startsWith(AssemblyItemType _type, Instruction _instruction)
+	{
+		return _type == Operation && (
+			_instruction == Instruction::JUMP ||
+			_instruction == Instruction::RJUMP ||
+			_instruction == Instruction::RETURN ||
+			_instruction == Instruction::STOP ||
+			_instruction == Instruction::INVALID ||
+			_instruction == Instruction::SELFDESTRUCT ||
+			_instruction == Instruction::REVERT
+		);
+	}
 	static bool apply(OptimiserState& _state)
 	{
 		auto it = _state.items.begin() + static_cast<ptrdiff_t>(_state.i);
@@ -599,6 +693,10 @@ struct UnreachableCode
 
 struct DeduplicateNextTagSize3 : SimplePeepholeOptimizerMethod<DeduplicateNextTagSize3>
 {
+	static bool startsWith(AssemblyItemType _type, Instruction /* _instruction */)
+	{
+		return _type != Tag;
+	}
 	static bool applySimple(
 		AssemblyItem const& _precedingItem,
 		AssemblyItem const& _itemA,
@@ -634,6 +732,10 @@ struct DeduplicateNextTagSize3 : SimplePeepholeOptimizerMethod<DeduplicateNextTa
 
 struct DeduplicateNextTagSize2 : SimplePeepholeOptimizerMethod<DeduplicateNextTagSize2>
 {
+	static bool startsWith(AssemblyItemType _type, Instruction /* _instruction */)
+	{
+		return _type != Tag;
+	}
 	static bool applySimple(
 		AssemblyItem const& _precedingItem,
 		AssemblyItem const& _itemA,
@@ -665,6 +767,10 @@ struct DeduplicateNextTagSize2 : SimplePeepholeOptimizerMethod<DeduplicateNextTa
 
 struct DeduplicateNextTagSize1 : SimplePeepholeOptimizerMethod<DeduplicateNextTagSize1>
 {
+	static bool startsWith(AssemblyItemType _type, Instruction /* _instruction */)
+	{
+		return _type != Tag;
+	}
 	static bool applySimple(
 		AssemblyItem const& _precedingItem,
 		AssemblyItem const& _breakingItem,
@@ -690,16 +796,61 @@ struct DeduplicateNextTagSize1 : SimplePeepholeOptimizerMethod<DeduplicateNextTa
 	}
 };
 
-void applyMethods(OptimiserState&)
+using MethodFunction = bool(*)(OptimiserState&);
+
+/// For each kind of item, the methods that can apply to a window starting with such an item,
+/// in the order in which they are tried. This avoids trying every method at every position.
+/// Each method reports through ``startsWith`` whether it can apply to a window starting with an
+/// item of the given type (and instruction, if the type is ``Operation``).
+class MethodTable
 {
-	assertThrow(false, OptimizerException, "Peephole optimizer failed to apply identity.");
-}
+public:
+	template <typename... Methods>
+	static MethodTable create()
+	{
+		MethodTable table;
+		for (size_t instruction = 0; instruction < 256; ++instruction)
+			table.add<Methods...>(Operation, static_cast<Instruction>(instruction));
+		for (size_t type = 0; type <= VerbatimBytecode; ++type)
+			if (type != Operation)
+				table.add<Methods...>(static_cast<AssemblyItemType>(type), Instruction{});
+		return table;
+	}
 
-template <typename Method, typename... OtherMethods>
-void applyMethods(OptimiserState& _state, Method, OtherMethods... _other)
+	std::vector<MethodFunction> const& methodsStartingWith(AssemblyItem const& _item) const
+	{
+		return m_methods[key(_item.type(), _item.type() == Operation ? _item.instruction() : Instruction{})];
+	}
+
+private:
+	static size_t key(AssemblyItemType _type, Instruction _instruction)
+	{
+		return _type == Operation ? static_cast<size_t>(_instruction) : 256 + static_cast<size_t>(_type);
+	}
+
+	template <typename... Methods>
+	void add(AssemblyItemType _type, Instruction _instruction)
+	{
+		auto& methods = m_methods[key(_type, _instruction)];
+		((Methods::startsWith(_type, _instruction) ? methods.push_back(&Methods::apply) : void()), ...);
+	}
+
+	std::array<std::vector<MethodFunction>, 256 + VerbatimBytecode + 1> m_methods;
+};
+
+/// Number of items the method with the largest window (DeduplicateNextTagSize3) looks at.
+/// Whether a method applies at a position only depends on this many items starting there.
+size_t constexpr maxWindowSize = 8;
+
+/// Applies the first method that applies at the current position, falling back to copying
+/// the item.
+/// @returns true if the item was copied unchanged.
+bool applyMethods(OptimiserState& _state, MethodTable const& _methods)
 {
-	if (!Method::apply(_state))
-		applyMethods(_state, _other...);
+	for (MethodFunction method: _methods.methodsStartingWith(_state.items[_state.i]))
+		if (method(_state))
+			return false;
+	return Identity::apply(_state);
 }
 
 size_t numberOfPops(AssemblyItems const& _items)
@@ -711,37 +862,59 @@ size_t numberOfPops(AssemblyItems const& _items)
 
 bool PeepholeOptimiser::optimise()
 {
+	static MethodTable const methods = MethodTable::create<
+		PushPop,
+		OpPop,
+		OpStop,
+		OpReturnRevert,
+		DoublePush,
+		DoubleSwap,
+		CommutativeSwap,
+		SwapComparison,
+		DupSwap,
+		IsZeroIsZeroJumpI,
+		IsZeroIsZeroRJumpI, // EOF specific
+		EqIsZeroJumpI,
+		EqIsZeroRJumpI,     // EOF specific
+		DoubleJump,
+		DoubleRJump,        // EOF specific
+		JumpToNext,
+		RJumpToNext,        // EOF specific
+		UnreachableCode,
+		DeduplicateNextTagSize3,
+		DeduplicateNextTagSize2,
+		DeduplicateNextTagSize1,
+		TagConjunctions,
+		TruthyAnd
+	>();
+
 	// Avoid referencing immutables too early by using approx. counting in bytesRequired()
 	auto const approx = evmasm::Precision::Approximate;
+
+	// No method applied at the positions of the items the previous call copied unchanged.
+	// If a window only consists of such items, it is the same as back then and no method
+	// applies at its start now either.
+	if (m_unchanged.size() != m_items.size())
+		m_unchanged.assign(m_items.size(), false);
+	std::vector<size_t> unchangedItemsFrom(m_items.size() + 1, 0);
+	for (size_t i = m_items.size(); i > 0; --i)
+		unchangedItemsFrom[i - 1] = m_unchanged[i - 1] ? unchangedItemsFrom[i] + 1 : 0;
+
+	m_optimisedItems.clear();
+	std::vector<bool> unchanged;
 	OptimiserState state {m_items, 0, back_inserter(m_optimisedItems), m_evmVersion};
 	while (state.i < m_items.size())
-		applyMethods(
-			state,
-			PushPop(),
-			OpPop(),
-			OpStop(),
-			OpReturnRevert(),
-			DoublePush(),
-			DoubleSwap(),
-			CommutativeSwap(),
-			SwapComparison(),
-			DupSwap(),
-			IsZeroIsZeroJumpI(),
-			IsZeroIsZeroRJumpI(), // EOF specific
-			EqIsZeroJumpI(),
-			EqIsZeroRJumpI(),     // EOF specific
-			DoubleJump(),
-			DoubleRJump(),        // EOF specific
-			JumpToNext(),
-			RJumpToNext(),        // EOF specific
-			UnreachableCode(),
-			DeduplicateNextTagSize3(),
-			DeduplicateNextTagSize2(),
-			DeduplicateNextTagSize1(),
-			TagConjunctions(),
-			TruthyAnd(),
-			Identity()
-		);
+	{
+		size_t const emittedItems = m_optimisedItems.size();
+		bool copied =
+			unchangedItemsFrom[state.i] >= maxWindowSize ?
+			Identity::apply(state) :
+			applyMethods(state, methods);
+		// Removed items change the window of the preceding item.
+		if (!copied && emittedItems == m_optimisedItems.size() && !unchanged.empty())
+			unchanged.back() = false;
+		unchanged.resize(m_optimisedItems.size(), copied);
+	}
 	if (m_optimisedItems.size() < m_items.size() || (
 		m_optimisedItems.size() == m_items.size() && (
 			evmasm::bytesRequired(m_optimisedItems, 3, m_evmVersion, approx) < evmasm::bytesRequired(m_items, 3, m_evmVersion, approx) ||
@@ -750,6 +923,7 @@ bool PeepholeOptimiser::optimise()
 	))
 	{
 		m_items = std::move(m_optimisedItems);
+		m_unchanged = std::move(unchanged);
 		return true;
 	}
 	else
@@ -50,11 +50,18 @@ public:
 	}
 	virtual ~PeepholeOptimiser() = default;
 
+	/// Performs one pass over the items.
+	/// Repeated calls only try the methods at positions close to the changes of the previous
+	/// pass, so the items must not be modified in between other than by this class.
+	/// @returns true if the items were changed.
 	bool optimise();
 
 private:
 	AssemblyItems& m_items;
 	AssemblyItems m_optimisedItems;
+	/// For each item, whether the previous pass copied it unchanged because no method applied
+	/// at its position.
+	std::vector<bool> m_unchanged;
 	langutil::EVMVersion const m_evmVersion;
 };
 
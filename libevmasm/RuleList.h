@@ -27,6 +27,7 @@
 #include <libevmasm/SimplificationRule.h>
 
 #include <libsolutil/CommonData.h>
+#include <libsolutil/NativeU256.h>
 
 #include <boost/multiprecision/detail/min_max.hpp>
 
@@ -40,14 +41,11 @@
 namespace solidity::evmasm
 {
 
-template <class S> S divWorkaround(S const& _a, S const& _b)
+/// Converts to the allocation-free representation used to fold the operations that would
+/// otherwise need intermediate bigint values.
+inline util::NativeU256 native(u256 const& _value)
 {
-	return (S)(bigint(_a) / bigint(_b));
-}
-
-template <class S> S modWorkaround(S const& _a, S const& _b)
-{
-	return (S)(bigint(_a) % bigint(_b));
+	return util::NativeU256(_value);
 }
 
 // This works around a bug fixed with Boost 1.64.
@@ -80,21 +78,22 @@ std::vector<SimplificationRule<Pattern>> simplificationRuleListPart1(
 {
 	using Word = typename Pattern::Word;
 	using Builtins = typename Pattern::Builtins;
+	static_assert(std::is_same_v<Word, u256>, "Constant folding assumes 256-bit words.");
 	return std::vector<SimplificationRule<Pattern>>{
 		// arithmetic on constants
 		{Builtins::ADD(A, B), [=]{ return A.d() + B.d(); }},
 		{Builtins::MUL(A, B), [=]{ return A.d() * B.d(); }},
 		{Builtins::SUB(A, B), [=]{ return A.d() - B.d(); }},
-		{Builtins::DIV(A, B), [=]{ return B.d() == 0 ? 0 : divWorkaround(A.d(), B.d()); }},
-		{Builtins::SDIV(A, B), [=]{ return B.d() == 0 ? 0 : s2u(divWorkaround(u2s(A.d()), u2s(B.d()))); }},
-		{Builtins::MOD(A, B), [=]{ return B.d() == 0 ? 0 : modWorkaround(A.d(), B.d()); }},
-		{Builtins::SMOD(A, B), [=]{ return B.d() == 0 ? 0 : s2u(modWorkaround(u2s(A.d()), u2s(B.d()))); }},
-		{Builtins::EXP(A, B), [=]{ return Word(boost::multiprecision::powm(bigint(A.d()), bigint(B.d()), bigint(1) << Pattern::WordSize)); }},
+		{Builtins::DIV(A, B), [=]{ return (native(A.d()) / native(B.d())).toU256(); }},
+		{Builtins::SDIV(A, B), [=]{ return util::sdiv(native(A.d()), native(B.d())).toU256(); }},
+		{Builtins::MOD(A, B), [=]{ return (native(A.d()) % native(B.d())).toU256(); }},
+		{Builtins::SMOD(A, B), [=]{ return util::smod(native(A.d()), native(B.d())).toU256(); }},
+		{Builtins::EXP(A, B), [=]{ return util::exp(native(A.d()), native(B.d())).toU256(); }},
 		{Builtins::NOT(A), [=]{ return ~A.d(); }},
 		{Builtins::LT(A, B), [=]() -> Word { return A.d() < B.d() ? 1 : 0; }},
 		{Builtins::GT(A, B), [=]() -> Word { return A.d() > B.d() ? 1 : 0; }},
-		{Builtins::SLT(A, B), [=]() -> Word { return u2s(A.d()) < u2s(B.d()) ? 1 : 0; }},
-		{Builtins::SGT(A, B), [=]() -> Word { return u2s(A.d()) > u2s(B.d()) ? 1 : 0; }},
+		{Builtins::SLT(A, B), [=]() -> Word { return util::slt(native(A.d()), native(B.d())) ? 1 : 0; }},
+		{Builtins::SGT(A, B), [=]() -> Word { return util::sgt(native(A.d()), native(B.d())) ? 1 : 0; }},
 		{Builtins::EQ(A, B), [=]() -> Word { return A.d() == B.d() ? 1 : 0; }},
 		{Builtins::ISZERO(A), [=]() -> Word { return A.d() == 0 ? 1 : 0; }},
 		{Builtins::AND(A, B), [=]{ return A.d() & B.d(); }},
@@ -106,8 +105,8 @@ std::vector<SimplificationRule<Pattern>> simplificationRuleListPart1(
 				0 :
 				(B.d() >> unsigned(8 * (Pattern::WordSize / 8 - 1 - A.d()))) & 0xff;
 		}},
-		{Builtins::ADDMOD(A, B, C), [=]{ return C.d() == 0 ? 0 : Word((bigint(A.d()) + bigint(B.d())) % C.d()); }},
-		{Builtins::MULMOD(A, B, C), [=]{ return C.d() == 0 ? 0 : Word((bigint(A.d()) * bigint(B.d())) % C.d()); }},
+		{Builtins::ADDMOD(A, B, C), [=]{ return util::addmod(native(A.d()), native(B.d()), native(C.d())).toU256(); }},
+		{Builtins::MULMOD(A, B, C), [=]{ return util::mulmod(native(A.d()), native(B.d()), native(C.d())).toU256(); }},
 		{Builtins::SIGNEXTEND(A, B), [=]() -> Word {
 			if (A.d() >= Pattern::WordSize / 8 - 1)
 				return B.d();
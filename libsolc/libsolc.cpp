@@ -24,10 +24,11 @@
 #include <libsolc/libsolc.h>
 #include <libsolidity/interface/StandardCompiler.h>
 #include <libsolidity/interface/Version.h>
-#include <libyul/YulName.h>
+#include <libyul/YulString.h>
 
 #include <cstdlib>
 #include <list>
+#include <memory>
 #include <string>
 
 #include "license.h"
@@ -45,6 +46,10 @@ namespace
 // this may potentially change the pointer that was passed to the caller from solidity_alloc().
 static std::list<std::string> solidityAllocations;
 
+// Keeps the ASTs of the sources of the most recent compilation, so that unchanged sources
+// do not have to be parsed again by the next call to solidity_compile(). Cleared by solidity_reset().
+static auto parsedSourceCache = std::make_shared<frontend::CompilerStack::ParsedSourceCache>();
+
 /// Find the equivalent to @p _data in the list of allocations of solidity_alloc(),
 /// removes it from the list and returns its value.
 ///
@@ -108,6 +113,7 @@ ReadCallback::Callback wrapReadCallback(CStyleReadFileCallback _readCallback, vo
 std::string compile(std::string _input, CStyleReadFileCallback _readCallback, void* _readContext)
 {
 	StandardCompiler compiler(wrapReadCallback(_readCallback, _readContext));
+	compiler.setParsedSourceCache(parsedSourceCache);
 	return compiler.compile(std::move(_input));
 }
 
@@ -153,7 +159,8 @@ extern void solidity_reset() noexcept
 {
 	// This is called right before each compilation, but not at the end, so additional memory
 	// can be freed here.
-	yul::YulStringRepository::reset();
 	solidityAllocations.clear();
+	parsedSourceCache->entries.clear();
+	yul::YulStringRepository::reset();
 }
 }
@@ -361,6 +361,15 @@ FunctionDefinition const* ContractDefinition::nextConstructor(ContractDefinition
 	return nullptr;
 }
 
+void ContractDefinition::resetAnalysis()
+{
+	ASTNode::resetAnalysis();
+	for (auto& interfaceFunctionList: m_interfaceFunctionList)
+		interfaceFunctionList.reset();
+	m_interfaceEvents.reset();
+	m_definedFunctionsByName.reset();
+}
+
 std::multimap<std::string, FunctionDefinition const*> const& ContractDefinition::definedFunctionsByName() const
 {
 	return m_definedFunctionsByName.init([&]{
@@ -126,6 +126,10 @@ public:
 
 	virtual bool experimentalSolidityOnly() const { return false; }
 
+	/// Discards everything attached to this node during analysis, so that it can be analysed
+	/// again as if it had just been parsed.
+	virtual void resetAnalysis() { m_annotation.reset(); }
+
 protected:
 	size_t const m_id = 0;
 
@@ -590,6 +594,8 @@ public:
 	/// @returns the next constructor in the inheritance hierarchy.
 	FunctionDefinition const* nextConstructor(ContractDefinition const& _mostDerivedContract) const;
 
+	void resetAnalysis() override;
+
 private:
 	std::multimap<std::string, FunctionDefinition const*> const& definedFunctionsByName() const;
 
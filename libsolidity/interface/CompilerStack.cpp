@@ -45,6 +45,7 @@
 #include <libsolidity/analysis/ImmutableValidator.h>
 
 #include <libsolidity/ast/AST.h>
+#include <libsolidity/ast/ASTVisitor.h>
 #include <libsolidity/ast/TypeProvider.h>
 #include <libsolidity/ast/ASTJsonImporter.h>
 #include <libsolidity/codegen/Compiler.h>
@@ -84,6 +85,8 @@
 #include <libsolutil/JSON.h>
 #include <libsolutil/Algorithms.h>
 #include <libsolutil/FunctionSelector.h>
+#include <libsolutil/Parallel.h>
+#include <libsolutil/Tracer.h>
 
 #include <boost/algorithm/string/replace.hpp>
 
@@ -109,6 +112,22 @@ using solidity::util::errinfo_comment;
 
 static int g_compilerStackCounts = 0;
 
+namespace
+{
+
+/// Discards the analysis results attached to the nodes of a previously analysed AST.
+class AnalysisReset: public ASTVisitor
+{
+public:
+	bool visitNode(ASTNode& _node) override
+	{
+		_node.resetAnalysis();
+		return true;
+	}
+};
+
+}
+
 CompilerStack::CompilerStack(ReadCallback::Callback _readFile):
 	m_readFile{std::move(_readFile)},
 	m_objectOptimizer(std::make_shared<yul::ObjectOptimizer>()),
@@ -123,6 +142,8 @@ CompilerStack::CompilerStack(ReadCallback::Callback _readFile):
 CompilerStack::~CompilerStack()
 {
 	--g_compilerStackCounts;
+	if (m_parsedSourceCache && m_parsedSourceCache->owner == this)
+		m_parsedSourceCache->owner = nullptr;
 	TypeProvider::reset();
 }
 
@@ -228,6 +249,49 @@ void CompilerStack::setViaIR(bool _viaIR)
 	m_viaIR = _viaIR;
 }
 
+void CompilerStack::setParallelism(size_t _parallelism)
+{
+	solAssert(m_stackState < CompilationSuccessful, "Must set parallelism before compiling.");
+	solAssert(_parallelism > 0, "At least one thread is required.");
+	m_parallelism = _parallelism;
+}
+
+void CompilerStack::setYulCacheDirectory(boost::filesystem::path const& _directory, uint64_t _sizeLimit)
+{
+	solAssert(m_stackState < CompilationSuccessful, "Must set the Yul cache directory before compiling.");
+	m_objectOptimizer->setPersistentCache(
+		std::make_shared<yul::PersistentObjectCache>(_directory, VersionString, _sizeLimit)
+	);
+}
+
+void CompilerStack::setObjectOptimizer(std::shared_ptr<yul::ObjectOptimizer> _objectOptimizer)
+{
+	solAssert(m_stackState < CompilationSuccessful, "Must set the object optimizer before compiling.");
+	solAssert(_objectOptimizer);
+	m_objectOptimizer = std::move(_objectOptimizer);
+}
+
+void CompilerStack::setParsedSourceCache(std::shared_ptr<ParsedSourceCache> _cache)
+{
+	solAssert(m_stackState < Parsed, "Must set the parsed source cache before parsing.");
+	solAssert(
+		!_cache || !_cache->owner || _cache->owner == this,
+		"The parsed source cache is in use by another compiler stack."
+	);
+	if (m_parsedSourceCache && m_parsedSourceCache->owner == this)
+		m_parsedSourceCache->owner = nullptr;
+	m_parsedSourceCache = std::move(_cache);
+	if (m_parsedSourceCache)
+		m_parsedSourceCache->owner = this;
+}
+
+void CompilerStack::setProfiling(bool _profiling)
+{
+	solAssert(m_stackState < Parsed, "Must enable profiling before parsing.");
+	m_profiling = _profiling;
+	m_profiler = _profiling ? std::make_unique<util::Profiler>() : nullptr;
+}
+
 void CompilerStack::setEVMVersion(langutil::EVMVersion _version)
 {
 	solAssert(m_stackState < ParsedAndImported, "Must set EVM version before parsing.");
@@ -318,6 +382,7 @@ void CompilerStack::reset(bool _keepSettings)
 		m_importRemapper.clear();
 		m_libraries.clear();
 		m_viaIR = false;
+		m_parallelism = 1;
 		m_evmVersion = langutil::EVMVersion();
 		m_eofVersion.reset();
 		m_modelCheckerSettings = ModelCheckerSettings{};
@@ -329,7 +394,9 @@ void CompilerStack::reset(bool _keepSettings)
 		m_metadataHash = MetadataHash::IPFS;
 		m_stopAfter = State::CompilationSuccessful;
 		m_compilationSourceType = CompilationSourceType::Solidity;
+		m_profiling = false;
 	}
+	m_profiler = m_profiling ? std::make_unique<util::Profiler>() : nullptr;
 	m_experimentalAnalysis.reset();
 	m_globalContext.reset();
 	m_sourceOrder.clear();
@@ -351,6 +418,7 @@ bool CompilerStack::parse()
 {
 	solAssert(m_stackState == SourcesSet, "Must call parse only after the SourcesSet state.");
 	m_errorReporter.clear();
+	util::Profiler::Scope profilerScope(m_profiler.get());
 
 	if (SemVerVersion{std::string(VersionString)}.isPrerelease())
 		m_errorReporter.warning(3805_error, "This is a pre-release compiler version, please do not use it in production.");
@@ -363,15 +431,58 @@ bool CompilerStack::parse()
 		for (auto const& s: m_sources)
 			sourcesToParse.push_back(s.first);
 
+		std::map<std::string, ParsedSourceCache::Entry> parsedSources;
 		for (size_t i = 0; i < sourcesToParse.size(); ++i)
 		{
 			std::string const& path = sourcesToParse[i];
 			Source& source = m_sources[path];
-			source.ast = parser.parse(*source.charStream);
+			int64_t const previousMaxID = parser.maxID();
+			size_t const previousErrorCount = m_errorReporter.errors().size();
+
+			ParsedSourceCache::Entry const* cached = nullptr;
+			if (m_parsedSourceCache)
+				if (
+					auto it = m_parsedSourceCache->entries.find(path);
+					it != m_parsedSourceCache->entries.end() &&
+					it->second.contentHash == source.keccak256() &&
+					it->second.evmVersion == m_evmVersion &&
+					it->second.eofVersion == m_eofVersion &&
+					it->second.previousMaxID == previousMaxID
+				)
+					cached = &it->second;
+
+			if (cached)
+			{
+				source.ast = cached->ast;
+				AnalysisReset analysisReset;
+				source.ast->accept(analysisReset);
+				parser.skipIDs(cached->maxID);
+			}
+			else
+			{
+				PROFILER_PROBE("Parser", probe);
+				source.ast = parser.parse(*source.charStream);
+			}
+
 			if (!source.ast)
 				solAssert(Error::containsErrors(m_errorReporter.errors()), "Parser returned null but did not report error.");
 			else
 			{
+				// Sources that produced diagnostics are not cached, since a reused AST would not report them again.
+				if (
+					m_parsedSourceCache &&
+					!source.ast->experimentalSolidity() &&
+					m_errorReporter.errors().size() == previousErrorCount
+				)
+					parsedSources[path] = ParsedSourceCache::Entry{
+						source.keccak256(),
+						m_evmVersion,
+						m_eofVersion,
+						previousMaxID,
+						parser.maxID(),
+						source.ast
+					};
+
 				source.ast->annotation().path = path;
 
 				for (auto const& import: ASTNode::filteredNodes<ImportDirective>(source.ast->nodes()))
@@ -407,6 +518,9 @@ bool CompilerStack::parse()
 			}
 		}
 
+		if (m_parsedSourceCache)
+			m_parsedSourceCache->entries = std::move(parsedSources);
+
 		if (Error::containsErrors(m_errorReporter.errors()))
 			return false;
 
@@ -418,7 +532,7 @@ bool CompilerStack::parse()
 	}
 	catch (UnimplementedFeatureError const& _error)
 	{
-		reportUnimplementedFeatureError(_error);
+		reportUnimplementedFeatureError(_error, m_errorReporter);
 		return false;
 	}
 
@@ -428,8 +542,11 @@ bool CompilerStack::parse()
 void CompilerStack::importASTs(std::map<std::string, Json> const& _sources)
 {
 	solAssert(m_stackState == Empty, "Must call importASTs only before the SourcesSet state.");
-	std::map<std::string, ASTPointer<SourceUnit>> reconstructedSources =
-		ASTJsonImporter(m_evmVersion, m_eofVersion).jsonToSourceUnit(_sources);
+	util::Profiler::Scope profilerScope(m_profiler.get());
+	std::map<std::string, ASTPointer<SourceUnit>> reconstructedSources = [&]() {
+		PROFILER_PROBE("ASTJsonImporter", probe);
+		return ASTJsonImporter(m_evmVersion, m_eofVersion).jsonToSourceUnit(_sources);
+	}();
 	for (auto& src: reconstructedSources)
 	{
 		solUnimplementedAssert(!src.second->experimentalSolidity());
@@ -452,13 +569,17 @@ void CompilerStack::importASTs(std::map<std::string, Json> const& _sources)
 bool CompilerStack::analyze()
 {
 	solAssert(m_stackState == ParsedAndImported, "Must call analyze only after parsing was successful.");
+	util::Profiler::Scope profilerScope(m_profiler.get());
 
 	if (!resolveImports())
 		return false;
 
-	for (Source const* source: m_sourceOrder)
-		if (source->ast)
-			Scoper::assignScopes(*source->ast);
+	{
+		PROFILER_PROBE("Scoper", probe);
+		for (Source const* source: m_sourceOrder)
+			if (source->ast)
+				Scoper::assignScopes(*source->ast);
+	}
 
 	bool noErrors = true;
 
@@ -466,28 +587,35 @@ bool CompilerStack::analyze()
 	{
 		bool experimentalSolidity = isExperimentalSolidity();
 
-		SyntaxChecker syntaxChecker(m_errorReporter, m_optimiserSettings.runYulOptimiser);
-		for (Source const* source: m_sourceOrder)
-			if (source->ast && !syntaxChecker.checkSyntax(*source->ast))
-				noErrors = false;
+		{
+			PROFILER_PROBE("SyntaxChecker", probe);
+			SyntaxChecker syntaxChecker(m_errorReporter, m_optimiserSettings.runYulOptimiser);
+			for (Source const* source: m_sourceOrder)
+				if (source->ast && !syntaxChecker.checkSyntax(*source->ast))
+					noErrors = false;
+		}
 
 		m_globalContext = std::make_shared<GlobalContext>(m_evmVersion);
 		// We need to keep the same resolver during the whole process.
 		NameAndTypeResolver resolver(*m_globalContext, m_evmVersion, m_errorReporter, experimentalSolidity);
-		for (Source const* source: m_sourceOrder)
-			if (source->ast && !resolver.registerDeclarations(*source->ast))
-				return false;
+		{
+			PROFILER_PROBE("NameAndTypeResolver", probe);
+			for (Source const* source: m_sourceOrder)
+				if (source->ast && !resolver.registerDeclarations(*source->ast))
+					return false;
 
-		std::map<std::string, SourceUnit const*> sourceUnitsByName;
-		for (auto& source: m_sources)
-			sourceUnitsByName[source.first] = source.second.ast.get();
-		for (Source const* source: m_sourceOrder)
-			if (source->ast && !resolver.performImports(*source->ast, sourceUnitsByName))
-				return false;
+			std::map<std::string, SourceUnit const*> sourceUnitsByName;
+			for (auto& source: m_sources)
+				sourceUnitsByName[source.first] = source.second.ast.get();
+			for (Source const* source: m_sourceOrder)
+				if (source->ast && !resolver.performImports(*source->ast, sourceUnitsByName))
+					return false;
 
-		resolver.warnHomonymDeclarations();
+			resolver.warnHomonymDeclarations();
+		}
 
 		{
+			PROFILER_PROBE("DocStringTagParser", probe);
 			DocStringTagParser docStringTagParser(m_errorReporter);
 			for (Source const* source: m_sourceOrder)
 				if (source->ast && !docStringTagParser.parseDocStrings(*source->ast))
@@ -495,9 +623,12 @@ bool CompilerStack::analyze()
 		}
 
 		// Requires DocStringTagParser
-		for (Source const* source: m_sourceOrder)
-			if (source->ast && !resolver.resolveNamesAndTypes(*source->ast))
-				return false;
+		{
+			PROFILER_PROBE("NameAndTypeResolver", probe);
+			for (Source const* source: m_sourceOrder)
+				if (source->ast && !resolver.resolveNamesAndTypes(*source->ast))
+					return false;
+		}
 
 		if (experimentalSolidity)
 		{
@@ -514,7 +645,7 @@ bool CompilerStack::analyze()
 	}
 	catch (UnimplementedFeatureError const& _error)
 	{
-		reportUnimplementedFeatureError(_error);
+		reportUnimplementedFeatureError(_error, m_errorReporter);
 		noErrors = false;
 	}
 
@@ -530,26 +661,35 @@ bool CompilerStack::analyzeLegacy(bool _noErrorsSoFar)
 {
 	bool noErrors = _noErrorsSoFar;
 
-	DeclarationTypeChecker declarationTypeChecker(m_errorReporter, m_evmVersion);
-	for (Source const* source: m_sourceOrder)
-		if (source->ast && !declarationTypeChecker.check(*source->ast))
-			return false;
+	{
+		PROFILER_PROBE("DeclarationTypeChecker", probe);
+		DeclarationTypeChecker declarationTypeChecker(m_errorReporter, m_evmVersion);
+		for (Source const* source: m_sourceOrder)
+			if (source->ast && !declarationTypeChecker.check(*source->ast))
+				return false;
+	}
 
 	// Requires DeclarationTypeChecker to have run
-	DocStringTagParser docStringTagParser(m_errorReporter);
-	for (Source const* source: m_sourceOrder)
-		if (source->ast && !docStringTagParser.validateDocStringsUsingTypes(*source->ast))
-			noErrors = false;
+	{
+		PROFILER_PROBE("DocStringTagParser", probe);
+		DocStringTagParser docStringTagParser(m_errorReporter);
+		for (Source const* source: m_sourceOrder)
+			if (source->ast && !docStringTagParser.validateDocStringsUsingTypes(*source->ast))
+				noErrors = false;
+	}
 
 	// Next, we check inheritance, overrides, function collisions and other things at
 	// contract or function level.
 	// This also calculates whether a contract is abstract, which is needed by the
 	// type checker.
-	ContractLevelChecker contractLevelChecker(m_errorReporter);
+	{
+		PROFILER_PROBE("ContractLevelChecker", probe);
+		ContractLevelChecker contractLevelChecker(m_errorReporter);
 
-	for (Source const* source: m_sourceOrder)
-		if (auto sourceAst = source->ast)
-			noErrors = contractLevelChecker.check(*sourceAst);
+		for (Source const* source: m_sourceOrder)
+			if (auto sourceAst = source->ast)
+				noErrors = contractLevelChecker.check(*sourceAst);
+	}
 
 	// Now we run full type checks that go down to the expression level. This
 	// cannot be done earlier, because we need cross-contract types and information
@@ -558,14 +698,18 @@ bool CompilerStack::analyzeLegacy(bool _noErrorsSoFar)
 	//
 	// Note: this does not resolve overloaded functions. In order to do that, types of arguments are needed,
 	// which is only done one step later.
-	TypeChecker typeChecker(m_evmVersion, m_eofVersion, m_errorReporter);
-	for (Source const* source: m_sourceOrder)
-		if (source->ast && !typeChecker.checkTypeRequirements(*source->ast))
-			noErrors = false;
+	{
+		PROFILER_PROBE("TypeChecker", probe);
+		TypeChecker typeChecker(m_evmVersion, m_eofVersion, m_errorReporter);
+		for (Source const* source: m_sourceOrder)
+			if (source->ast && !typeChecker.checkTypeRequirements(*source->ast))
+				noErrors = false;
+	}
 
 	if (noErrors)
 	{
 		// Requires ContractLevelChecker and TypeChecker
+		PROFILER_PROBE("DocStringAnalyser", probe);
 		DocStringAnalyser docStringAnalyser(m_errorReporter);
 		for (Source const* source: m_sourceOrder)
 			if (source->ast && !docStringAnalyser.analyseDocStrings(*source->ast))
@@ -575,6 +719,7 @@ bool CompilerStack::analyzeLegacy(bool _noErrorsSoFar)
 	if (noErrors)
 	{
 		// Checks that can only be done when all types of all AST nodes are known.
+		PROFILER_PROBE("PostTypeChecker", probe);
 		PostTypeChecker postTypeChecker(m_errorReporter);
 		for (Source const* source: m_sourceOrder)
 			if (source->ast && !postTypeChecker.check(*source->ast))
@@ -586,29 +731,37 @@ bool CompilerStack::analyzeLegacy(bool _noErrorsSoFar)
 	// Create & assign callgraphs and check for contract dependency cycles
 	if (noErrors)
 	{
+		PROFILER_PROBE("FunctionCallGraphBuilder", probe);
 		createAndAssignCallGraphs();
 		annotateInternalFunctionIDs();
 		findAndReportCyclicContractDependencies();
 	}
 
 	if (noErrors)
+	{
+		PROFILER_PROBE("PostTypeContractLevelChecker", probe);
 		for (Source const* source: m_sourceOrder)
 			if (source->ast && !PostTypeContractLevelChecker{m_errorReporter}.check(*source->ast))
 				noErrors = false;
+	}
 
 	// Check that immutable variables are never read in c'tors and assigned
 	// exactly once
 	if (noErrors)
+	{
+		PROFILER_PROBE("ImmutableValidator", probe);
 		for (Source const* source: m_sourceOrder)
 			if (source->ast)
 				for (ASTPointer<ASTNode> const& node: source->ast->nodes())
 					if (ContractDefinition* contract = dynamic_cast<ContractDefinition*>(node.get()))
 						ImmutableValidator(m_errorReporter, *contract).analyze();
+	}
 
 	if (noErrors)
 	{
 		// Control flow graph generator and analyzer. It can check for issues such as
 		// variable is used before it is assigned to.
+		PROFILER_PROBE("ControlFlowAnalyzer", probe);
 		CFG cfg(m_errorReporter);
 		for (Source const* source: m_sourceOrder)
 			if (source->ast && !cfg.constructFlow(*source->ast))
@@ -628,6 +781,7 @@ bool CompilerStack::analyzeLegacy(bool _noErrorsSoFar)
 	if (noErrors)
 	{
 		// Checks for common mistakes. Only generates warnings.
+		PROFILER_PROBE("StaticAnalyzer", probe);
 		StaticAnalyzer staticAnalyzer(m_errorReporter);
 		for (Source const* source: m_sourceOrder)
 			if (source->ast && !staticAnalyzer.analyze(*source->ast))
@@ -637,6 +791,7 @@ bool CompilerStack::analyzeLegacy(bool _noErrorsSoFar)
 	if (noErrors)
 	{
 		// Check for state mutability in every function.
+		PROFILER_PROBE("ViewPureChecker", probe);
 		std::vector<ASTPointer<ASTNode>> ast;
 		for (Source const* source: m_sourceOrder)
 			if (source->ast)
@@ -649,6 +804,7 @@ bool CompilerStack::analyzeLegacy(bool _noErrorsSoFar)
 	if (noErrors)
 	{
 		// Run SMTChecker
+		PROFILER_PROBE("ModelChecker", probe);
 
 		auto allSources = util::applyMap(m_sourceOrder, [](Source const* _source) { return _source->ast; });
 		if (ModelChecker::isPragmaPresent(allSources))
@@ -674,6 +830,7 @@ bool CompilerStack::analyzeExperimental()
 {
 	solAssert(!m_experimentalAnalysis);
 	solAssert(m_maxAstId && *m_maxAstId >= 0);
+	PROFILER_PROBE("experimental::Analysis", probe);
 	m_experimentalAnalysis = std::make_unique<experimental::Analysis>(m_errorReporter, static_cast<std::uint64_t>(*m_maxAstId));
 	std::vector<std::shared_ptr<SourceUnit const>> sourceAsts;
 	for (Source const* source: m_sourceOrder)
@@ -751,48 +908,24 @@ bool CompilerStack::compile(State _stopAfter)
 	if (m_stackState >= m_stopAfter)
 		return true;
 
-	// Only compile contracts individually which have been requested.
-	std::map<ContractDefinition const*, std::shared_ptr<Compiler const>> otherCompilers;
+	if (m_parallelism > 1 && (!m_threadPool || m_threadPool->workerCount() != m_parallelism - 1))
+		m_threadPool = std::make_unique<util::ThreadPool>(m_parallelism - 1);
+	util::ThreadPool::Scope threadPoolScope(m_parallelism > 1 ? m_threadPool.get() : nullptr);
 
+	// Only compile contracts individually which have been requested.
+	std::vector<ContractDefinition const*> requestedContracts;
 	for (Source const* source: m_sourceOrder)
 		for (ASTPointer<ASTNode> const& node: source->ast->nodes())
 			if (auto contract = dynamic_cast<ContractDefinition const*>(node.get()))
 				if (isRequestedContract(*contract))
-				{
-					PipelineConfig pipelineConfig = requestedPipelineConfig(*contract);
-
-					try
-					{
-						if (pipelineConfig.needIR(m_viaIR))
-							generateIR(*contract, pipelineConfig.needIRCodegenOnly(m_viaIR));
-						if (pipelineConfig.needBytecode())
-						{
-							if (m_viaIR)
-								generateEVMFromIR(*contract);
-							else
-							{
-								if (m_experimentalAnalysis)
-									solThrow(CompilerError, "Legacy codegen after experimental analysis is unsupported.");
-								compileContract(*contract, otherCompilers);
-							}
-						}
-					}
-					catch (Error const& _error)
-					{
-						// Since codegen has no access to the error reporter, the only way for it to
-						// report an error is to throw. In most cases it uses dedicated exceptions,
-						// but CodeGenerationError is one case where someone decided to just throw Error.
-						solAssert(_error.type() == Error::Type::CodeGenerationError);
-						m_errorReporter.error(_error.errorId(), _error.type(), SourceLocation(), _error.what());
-					}
-					catch (UnimplementedFeatureError const& _error)
-					{
-						reportUnimplementedFeatureError(_error);
-					}
+					requestedContracts.push_back(contract);
 
-					if (m_errorReporter.hasErrors())
-						return false;
-				}
+	bool compilationSuccessful =
+		m_viaIR && m_parallelism > 1 ?
+		compileContractsViaIRInParallel(requestedContracts) :
+		compileContractsSequentially(requestedContracts);
+	if (!compilationSuccessful)
+		return false;
 
 	solAssert(!m_errorReporter.hasErrors());
 	m_stackState = CompilationSuccessful;
@@ -800,6 +933,121 @@ bool CompilerStack::compile(State _stopAfter)
 	return true;
 }
 
+bool CompilerStack::compileContractsSequentially(std::vector<ContractDefinition const*> const& _contracts)
+{
+	std::map<ContractDefinition const*, std::shared_ptr<Compiler const>> otherCompilers;
+
+	for (ContractDefinition const* contract: _contracts)
+	{
+		PipelineConfig pipelineConfig = requestedPipelineConfig(*contract);
+
+		runCodegenStep(m_errorReporter, [&]() {
+			if (pipelineConfig.needIR(m_viaIR))
+				generateIR(*contract, pipelineConfig.needIRCodegenOnly(m_viaIR));
+			if (pipelineConfig.needBytecode())
+			{
+				if (m_viaIR)
+					generateEVMFromIR(*contract, m_errorReporter, m_parallelism);
+				else
+				{
+					if (m_experimentalAnalysis)
+						solThrow(CompilerError, "Legacy codegen after experimental analysis is unsupported.");
+					compileContract(*contract, otherCompilers);
+				}
+			}
+		});
+
+		if (m_errorReporter.hasErrors())
+			return false;
+	}
+
+	return true;
+}
+
+bool CompilerStack::compileContractsViaIRInParallel(std::vector<ContractDefinition const*> const& _contracts)
+{
+	solAssert(m_viaIR);
+
+	struct ContractJob
+	{
+		ContractDefinition const* contract = nullptr;
+		PipelineConfig pipelineConfig;
+		/// Errors and warnings in the order in which the sequential pipeline would report them.
+		ErrorList errors;
+	};
+	std::vector<ContractJob> jobs;
+	jobs.reserve(_contracts.size());
+
+	// The IR generator works on the Solidity AST and the type system, neither of which can be
+	// accessed concurrently. It also needs the unoptimized IR of all the dependencies of a contract.
+	// It is cheap compared to the rest of the pipeline though, so it is done up front, in the same
+	// order as in the sequential pipeline. Optimized IR is self-contained, so the remaining steps
+	// do not depend on the compilation of any other contract.
+	std::vector<std::pair<size_t, ContractDefinition const*>> contractsToOptimize;
+	for (ContractDefinition const* contract: _contracts)
+	{
+		ContractJob& job = jobs.emplace_back(ContractJob{contract, requestedPipelineConfig(*contract), {}});
+		ErrorReporter errorReporter(job.errors);
+		std::vector<ContractDefinition const*> contractsToOptimizeForJob;
+		if (job.pipelineConfig.needIR(m_viaIR))
+			runCodegenStep(errorReporter, [&]() {
+				generateUnoptimizedIR(
+					*contract,
+					job.pipelineConfig.needIRCodegenOnly(m_viaIR),
+					errorReporter,
+					contractsToOptimizeForJob
+				);
+			});
+		if (Error::containsErrors(job.errors))
+			break;
+		for (ContractDefinition const* contractToOptimize: contractsToOptimizeForJob)
+			contractsToOptimize.emplace_back(jobs.size() - 1, contractToOptimize);
+	}
+
+	// Threads not needed for optimizing different contracts are used for the Yul objects of each contract.
+	size_t optimizationThreadsPerContract = std::max<size_t>(1, m_parallelism / std::max<size_t>(1, contractsToOptimize.size()));
+	std::vector<ErrorList> optimizationErrors(contractsToOptimize.size());
+	util::parallelFor(contractsToOptimize.size(), m_parallelism, [&](size_t _index) {
+		ErrorReporter errorReporter(optimizationErrors[_index]);
+		runCodegenStep(errorReporter, [&]() {
+			optimizeIR(*contractsToOptimize[_index].second, optimizationThreadsPerContract);
+		});
+	});
+	for (size_t index = 0; index < contractsToOptimize.size(); ++index)
+		jobs[contractsToOptimize[index].first].errors += optimizationErrors[index];
+
+	// The sequential pipeline stops at the first contract that fails to compile. Contracts
+	// compiled before it only depend on IR optimized as a part of their own or earlier jobs.
+	size_t successfulJobs = 0;
+	while (successfulJobs < jobs.size() && !Error::containsErrors(jobs[successfulJobs].errors))
+		++successfulJobs;
+
+	// Threads not needed for compiling different contracts are used for the sub-assemblies of each contract.
+	size_t bytecodeJobs = 0;
+	for (size_t index = 0; index < successfulJobs; ++index)
+		if (jobs[index].pipelineConfig.needBytecode())
+			++bytecodeJobs;
+	size_t threadsPerJob = std::max<size_t>(1, m_parallelism / std::max<size_t>(1, bytecodeJobs));
+	util::parallelFor(successfulJobs, m_parallelism, [&](size_t _index) {
+		ContractJob& job = jobs[_index];
+		if (!job.pipelineConfig.needBytecode())
+			return;
+
+		ErrorReporter errorReporter(job.errors);
+		runCodegenStep(errorReporter, [&]() { generateEVMFromIR(*job.contract, errorReporter, threadsPerJob); });
+	});
+
+	// Report the diagnostics in the same order as the sequential pipeline would.
+	for (ContractJob const& job: jobs)
+	{
+		m_errorReporter.append(job.errors);
+		if (Error::containsErrors(job.errors))
+			return false;
+	}
+
+	return true;
+}
+
 void CompilerStack::link()
 {
 	solAssert(m_stackState >= CompilationSuccessful, "");
@@ -841,6 +1089,11 @@ std::vector<std::string> CompilerStack::contractNames() const
 	return contractNames;
 }
 
+util::Profiler const* CompilerStack::contractProfiler(std::string const& _contractName) const
+{
+	return contract(_contractName).profiler.get();
+}
+
 std::string const CompilerStack::lastContractName(std::optional<std::string> const& _sourceName) const
 {
 	solAssert(m_stackState >= AnalysisSuccessful, "Parsing was not successful.");
@@ -1369,7 +1622,12 @@ void CompilerStack::storeContractDefinitions()
 				// thus contracts can only conflict if declared in the same source file. This
 				// should already cause a double-declaration error elsewhere.
 				if (!m_contracts.count(fullyQualifiedName))
-					m_contracts[fullyQualifiedName].contract = contract;
+				{
+					Contract& compiledContract = m_contracts[fullyQualifiedName];
+					compiledContract.contract = contract;
+					if (m_profiling)
+						compiledContract.profiler = std::make_shared<util::Profiler>();
+				}
 			}
 }
 
@@ -1417,7 +1675,8 @@ bool onlySafeExperimentalFeaturesActivated(std::set<ExperimentalFeature> const&
 void CompilerStack::assembleYul(
 	ContractDefinition const& _contract,
 	std::shared_ptr<evmasm::Assembly> _assembly,
-	std::shared_ptr<evmasm::Assembly> _runtimeAssembly
+	std::shared_ptr<evmasm::Assembly> _runtimeAssembly,
+	ErrorReporter& _errorReporter
 )
 {
 	solAssert(m_stackState >= AnalysisSuccessful, "");
@@ -1429,6 +1688,7 @@ void CompilerStack::assembleYul(
 	try
 	{
 		// Assemble deployment (incl. runtime)  object.
+		PROFILER_PROBE("Assembler", probe);
 		compiledContract.object = compiledContract.evmAssembly->assemble();
 	}
 	catch (evmasm::AssemblyException const& error)
@@ -1442,6 +1702,7 @@ void CompilerStack::assembleYul(
 	try
 	{
 		// Assemble runtime object.
+		PROFILER_PROBE("Assembler", probe);
 		compiledContract.runtimeObject = compiledContract.evmRuntimeAssembly->assemble();
 	}
 	catch (evmasm::AssemblyException const& error)
@@ -1456,7 +1717,7 @@ void CompilerStack::assembleYul(
 		m_evmVersion >= langutil::EVMVersion::spuriousDragon() &&
 		compiledContract.runtimeObject.bytecode.size() > 0x6000
 	)
-		m_errorReporter.warning(
+		_errorReporter.warning(
 			5574_error,
 			_contract.location(),
 			"Contract code size is "s +
@@ -1474,7 +1735,7 @@ void CompilerStack::assembleYul(
 		m_evmVersion >= langutil::EVMVersion::shanghai() &&
 		compiledContract.object.bytecode.size() > 0xC000
 	)
-		m_errorReporter.warning(
+		_errorReporter.warning(
 			3860_error,
 			_contract.location(),
 			"Contract initcode size is "s +
@@ -1505,6 +1766,8 @@ void CompilerStack::compileContract(
 		return;
 
 	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
+	util::Profiler::Scope profilerScope(compiledContract.profiler.get());
+	util::Tracer::Span contractSpan(_contract.fullyQualifiedName(), "contract");
 
 	std::shared_ptr<Compiler> compiler = std::make_shared<Compiler>(m_evmVersion, m_revertStrings, m_optimiserSettings);
 
@@ -1512,16 +1775,32 @@ void CompilerStack::compileContract(
 	bytes cborEncodedMetadata = createCBORMetadata(compiledContract, /* _forIR */ false);
 
 	// Run optimiser and compile the contract.
-	compiler->compileContract(_contract, _otherCompilers, cborEncodedMetadata);
+	{
+		PROFILER_PROBE("ContractCompiler", probe);
+		compiler->compileContract(_contract, _otherCompilers, cborEncodedMetadata);
+	}
 	compiledContract.generatedYulUtilityCode = compiler->generatedYulUtilityCode();
 	compiledContract.runtimeGeneratedYulUtilityCode = compiler->runtimeGeneratedYulUtilityCode();
 
 	_otherCompilers[compiledContract.contract] = compiler;
 
-	assembleYul(_contract, compiler->assemblyPtr(), compiler->runtimeAssemblyPtr());
+	assembleYul(_contract, compiler->assemblyPtr(), compiler->runtimeAssemblyPtr(), m_errorReporter);
 }
 
 void CompilerStack::generateIR(ContractDefinition const& _contract, bool _unoptimizedOnly)
+{
+	std::vector<ContractDefinition const*> contractsToOptimize;
+	generateUnoptimizedIR(_contract, _unoptimizedOnly, m_errorReporter, contractsToOptimize);
+	for (ContractDefinition const* contract: contractsToOptimize)
+		optimizeIR(*contract, m_parallelism);
+}
+
+void CompilerStack::generateUnoptimizedIR(
+	ContractDefinition const& _contract,
+	bool _unoptimizedOnly,
+	ErrorReporter& _errorReporter,
+	std::vector<ContractDefinition const*>& _contractsToOptimize
+)
 {
 	solAssert(m_stackState >= AnalysisSuccessful, "");
 
@@ -1533,7 +1812,7 @@ void CompilerStack::generateIR(ContractDefinition const& _contract, bool _unopti
 	}
 
 	if (!*_contract.sourceUnit().annotation().useABICoderV2)
-		m_errorReporter.warning(
+		_errorReporter.warning(
 			2066_error,
 			_contract.location(),
 			"Contract requests the ABI coder v1, which is incompatible with the IR. "
@@ -1542,17 +1821,21 @@ void CompilerStack::generateIR(ContractDefinition const& _contract, bool _unopti
 
 	std::string dependenciesSource;
 	for (auto const& [dependency, referencee]: _contract.annotation().contractDependencies)
-		generateIR(*dependency, _unoptimizedOnly);
+		generateUnoptimizedIR(*dependency, _unoptimizedOnly, _errorReporter, _contractsToOptimize);
 
 	if (!_contract.canBeDeployed())
 		return;
 
+	util::Profiler::Scope profilerScope(compiledContract.profiler.get());
+	util::Tracer::Span contractSpan(_contract.fullyQualifiedName(), "contract");
+
 	std::map<ContractDefinition const*, std::string_view const> otherYulSources;
 	for (auto const& pair: m_contracts)
 		otherYulSources.emplace(pair.second.contract, pair.second.yulIR ? *pair.second.yulIR : std::string_view{});
 
 	if (m_experimentalAnalysis)
 	{
+		PROFILER_PROBE("experimental::IRGenerator", probe);
 		experimental::IRGenerator generator(
 			m_evmVersion,
 			m_eofVersion,
@@ -1570,6 +1853,7 @@ void CompilerStack::generateIR(ContractDefinition const& _contract, bool _unopti
 	}
 	else
 	{
+		PROFILER_PROBE("IRGenerator", probe);
 		IRGenerator generator(
 			m_evmVersion,
 			m_eofVersion,
@@ -1586,16 +1870,34 @@ void CompilerStack::generateIR(ContractDefinition const& _contract, bool _unopti
 		);
 	}
 
+	yulAssert(compiledContract.yulIR);
+	if (_unoptimizedOnly)
+		// Still validate the generated code.
+		loadGeneratedIR(*compiledContract.yulIR);
+	else
+		_contractsToOptimize.push_back(&_contract);
+}
+
+void CompilerStack::optimizeIR(ContractDefinition const& _contract, size_t _maxThreads)
+{
+	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
+	util::Profiler::Scope profilerScope(compiledContract.profiler.get());
+	util::Tracer::Span contractSpan(_contract.fullyQualifiedName(), "contract");
 	yulAssert(compiledContract.yulIR);
 	YulStack stack = loadGeneratedIR(*compiledContract.yulIR);
-	if (!_unoptimizedOnly)
+	stack.setMaxThreads(_maxThreads);
 	{
+		PROFILER_PROBE("ObjectOptimizer", probe);
 		stack.optimize();
-		compiledContract.yulIROptimized = stack.print();
 	}
+	compiledContract.yulIROptimized = stack.print();
 }
 
-void CompilerStack::generateEVMFromIR(ContractDefinition const& _contract)
+void CompilerStack::generateEVMFromIR(
+	ContractDefinition const& _contract,
+	ErrorReporter& _errorReporter,
+	size_t _maxThreads
+)
 {
 	solAssert(m_stackState >= AnalysisSuccessful, "");
 
@@ -1608,8 +1910,12 @@ void CompilerStack::generateEVMFromIR(ContractDefinition const& _contract)
 	if (!compiledContract.object.bytecode.empty())
 		return;
 
+	util::Profiler::Scope profilerScope(compiledContract.profiler.get());
+	util::Tracer::Span contractSpan(_contract.fullyQualifiedName(), "contract");
+
 	// Re-parse the Yul IR in EVM dialect
 	YulStack stack = loadGeneratedIR(*compiledContract.yulIROptimized);
+	stack.setMaxThreads(_maxThreads);
 
 	std::string deployedName = IRNames::deployedObject(_contract);
 	solAssert(!deployedName.empty(), "");
@@ -1618,11 +1924,11 @@ void CompilerStack::generateEVMFromIR(ContractDefinition const& _contract)
 	if (stack.hasErrors())
 	{
 		for (std::shared_ptr<Error const> const& error: stack.errors())
-			reportIRPostAnalysisError(error.get());
+			reportIRPostAnalysisError(error.get(), _errorReporter);
 		return;
 	}
 
-	assembleYul(_contract, compiledContract.evmAssembly, compiledContract.evmRuntimeAssembly);
+	assembleYul(_contract, compiledContract.evmAssembly, compiledContract.evmRuntimeAssembly, _errorReporter);
 }
 
 CompilerStack::Contract const& CompilerStack::contract(std::string const& _contractName) const
@@ -2014,14 +2320,14 @@ experimental::Analysis const& CompilerStack::experimentalAnalysis() const
 	return *m_experimentalAnalysis;
 }
 
-void CompilerStack::reportUnimplementedFeatureError(UnimplementedFeatureError const& _error)
+void CompilerStack::reportUnimplementedFeatureError(UnimplementedFeatureError const& _error, ErrorReporter& _errorReporter)
 {
 	solAssert(_error.comment(), "Errors must include a message for the user.");
 
-	m_errorReporter.unimplementedFeatureError(1834_error, _error.sourceLocation(), *_error.comment());
+	_errorReporter.unimplementedFeatureError(1834_error, _error.sourceLocation(), *_error.comment());
 }
 
-void CompilerStack::reportIRPostAnalysisError(Error const* _error)
+void CompilerStack::reportIRPostAnalysisError(Error const* _error, ErrorReporter& _errorReporter)
 {
 	solAssert(_error);
 	solAssert(_error->comment(), "Errors must include a message for the user.");
@@ -2031,7 +2337,7 @@ void CompilerStack::reportIRPostAnalysisError(Error const* _error)
 	if (!Error::isError(_error->severity()))
 		return;
 
-	m_errorReporter.error(
+	_errorReporter.error(
 		_error->errorId(),
 		_error->type(),
 		// Ignore the original location. It's likely missing, but even if not, it points at Yul source.
@@ -2040,3 +2346,23 @@ void CompilerStack::reportIRPostAnalysisError(Error const* _error)
 		*_error->comment()
 	);
 }
+
+void CompilerStack::runCodegenStep(ErrorReporter& _errorReporter, std::function<void()> const& _codegenStep)
+{
+	try
+	{
+		_codegenStep();
+	}
+	catch (Error const& _error)
+	{
+		// Since codegen has no access to the error reporter, the only way for it to
+		// report an error is to throw. In most cases it uses dedicated exceptions,
+		// but CodeGenerationError is one case where someone decided to just throw Error.
+		solAssert(_error.type() == Error::Type::CodeGenerationError);
+		_errorReporter.error(_error.errorId(), _error.type(), SourceLocation(), _error.what());
+	}
+	catch (UnimplementedFeatureError const& _error)
+	{
+		reportUnimplementedFeatureError(_error, _errorReporter);
+	}
+}
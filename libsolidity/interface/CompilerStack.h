@@ -48,6 +48,8 @@
 #include <libsolutil/FixedHash.h>
 #include <libsolutil/LazyInit.h>
 #include <libsolutil/JSON.h>
+#include <libsolutil/Parallel.h>
+#include <libsolutil/Profiler.h>
 
 #include <libyul/ObjectOptimizer.h>
 
@@ -133,6 +135,32 @@ public:
 		SolidityAST,
 	};
 
+	/// Source units parsed by earlier compilations, keyed by source unit name.
+	/// A source unit is reused instead of being parsed again if its content and the EVM and EOF
+	/// versions are unchanged and the parser would assign it the same node IDs as before,
+	/// so that reuse is not observable in the output.
+	/// Reused ASTs are not copied, their analysis results are discarded in place. The cache can
+	/// therefore only be used by one CompilerStack at a time, which is enforced by setParsedSourceCache(),
+	/// and the ASTs taken from it must not be accessed after that stack is gone.
+	/// It is not safe for concurrent use.
+	struct ParsedSourceCache
+	{
+		struct Entry
+		{
+			util::h256 contentHash;
+			langutil::EVMVersion evmVersion;
+			std::optional<uint8_t> eofVersion;
+			/// Largest node ID assigned before the source unit was parsed.
+			int64_t previousMaxID = 0;
+			/// Largest node ID assigned after the source unit was parsed.
+			int64_t maxID = 0;
+			std::shared_ptr<SourceUnit> ast;
+		};
+		std::map<std::string, Entry> entries;
+		/// The compiler stack currently using the cache, if any.
+		CompilerStack const* owner = nullptr;
+	};
+
 	/// Indicates which stages of the compilation pipeline were explicitly requested and provides
 	/// logic to determine which ones are effectively needed to accomplish that.
 	/// Note that parsing and analysis are not selectable, since they cannot be skipped.
@@ -223,6 +251,39 @@ public:
 	/// Must be set before parsing.
 	void setViaIR(bool _viaIR);
 
+	/// Sets the maximum number of threads used to optimize the IR and generate bytecode for
+	/// independent contracts concurrently. Only affects compilation via the IR.
+	/// The output does not depend on this setting.
+	/// Must be set before compiling.
+	void setParallelism(size_t _parallelism);
+
+	/// Enables reusing optimized Yul code across compilations by storing it in @a _directory.
+	/// The total size of the stored code is limited to @a _sizeLimit bytes.
+	/// The output does not depend on this setting.
+	/// Must be set before compiling.
+	/// @throws boost::filesystem::filesystem_error if the directory cannot be created.
+	void setYulCacheDirectory(boost::filesystem::path const& _directory, uint64_t _sizeLimit);
+
+	/// Makes the compiler use @a _objectOptimizer, and thereby its cache of optimized Yul code,
+	/// instead of its own. Allows sharing the cache between compilations in the same process.
+	/// The output does not depend on this setting.
+	/// Must be set before compiling.
+	void setObjectOptimizer(std::shared_ptr<yul::ObjectOptimizer> _objectOptimizer);
+
+	/// Sets the cache that parsed source units are taken from and stored into, which allows
+	/// skipping the parser for unchanged sources when the same sources are compiled repeatedly,
+	/// either after reset() or by another CompilerStack. Only the sources of the most recent
+	/// parse are kept in the cache. The output does not depend on this setting.
+	/// The cache is used by this stack until it is destroyed or another cache is set. It must not
+	/// be in use by another CompilerStack, since that stack's ASTs would be modified by this one.
+	/// Must be set before parsing.
+	void setParsedSourceCache(std::shared_ptr<ParsedSourceCache> _cache);
+
+	/// Enables recording the time, number of calls and growth of the peak memory usage of the
+	/// compilation phases. The phases specific to a contract are recorded separately for each contract.
+	/// Must be set before parsing.
+	void setProfiling(bool _profiling);
+
 	/// Set the EVM version used before running compile.
 	/// When called without an argument it will revert to the default version.
 	/// Must be set before parsing.
@@ -314,6 +375,14 @@ public:
 	/// @returns a list of the contract names in the sources.
 	virtual std::vector<std::string> contractNames() const override;
 
+	/// @returns the metrics of the compilation phases that are not specific to any contract,
+	/// like parsing and analysis, or nullptr if profiling is not enabled.
+	util::Profiler const* profiler() const { return m_profiler.get(); }
+
+	/// @returns the metrics of the compilation phases of the given contract, like IR generation,
+	/// optimization and assembly, or nullptr if profiling is not enabled.
+	util::Profiler const* contractProfiler(std::string const& _contractName) const;
+
 	/// @returns the name of the last contract. If _sourceName is defined the last contract of that source will be returned.
 	std::string const lastContractName(std::optional<std::string> const& _sourceName = std::nullopt) const;
 
@@ -455,6 +524,7 @@ private:
 		util::LazyInit<Json const> devDocumentation;
 		mutable std::optional<std::string const> sourceMapping;
 		mutable std::optional<std::string const> runtimeSourceMapping;
+		std::shared_ptr<util::Profiler> profiler; ///< Metrics of the compilation phases of the contract, if profiling.
 	};
 
 	void createAndAssignCallGraphs();
@@ -492,12 +562,27 @@ private:
 	/// @returns false on error.
 	bool analyzeExperimental();
 
+	/// Runs all the code generation steps for the given contracts one by one, in order.
+	/// @returns false on error.
+	bool compileContractsSequentially(std::vector<ContractDefinition const*> const& _contracts);
+
+	/// Generates the IR for the given contracts and then optimizes it and generates bytecode
+	/// concurrently, using up to m_parallelism threads. Produces the same output and reports the
+	/// same errors as compileContractsSequentially().
+	/// @returns false on error.
+	bool compileContractsViaIRInParallel(std::vector<ContractDefinition const*> const& _contracts);
+
+	/// Executes a code generation step, turning the exceptions the code generator uses to report
+	/// problems into errors reported via @a _errorReporter.
+	static void runCodegenStep(langutil::ErrorReporter& _errorReporter, std::function<void()> const& _codegenStep);
+
 	/// Assembles the contract.
 	/// This function should only be internally called by compileContract and generateEVMFromIR.
 	void assembleYul(
 		ContractDefinition const& _contract,
 		std::shared_ptr<evmasm::Assembly> _assembly,
-		std::shared_ptr<evmasm::Assembly> _runtimeAssembly
+		std::shared_ptr<evmasm::Assembly> _runtimeAssembly,
+		langutil::ErrorReporter& _errorReporter
 	);
 
 	/// Compile a single contract.
@@ -518,9 +603,31 @@ private:
 	///     optimized IR, its AST or compilation via IR must not be requested.
 	void generateIR(ContractDefinition const& _contract, bool _unoptimizedOnly);
 
+	/// Generate unoptimized Yul IR for a single contract and its dependencies.
+	/// Instead of optimizing the IR right away, appends the contracts whose IR needs to be optimized
+	/// to @a _contractsToOptimize.
+	/// Not thread-safe.
+	void generateUnoptimizedIR(
+		ContractDefinition const& _contract,
+		bool _unoptimizedOnly,
+		langutil::ErrorReporter& _errorReporter,
+		std::vector<ContractDefinition const*>& _contractsToOptimize
+	);
+
+	/// Optimize the IR generated for a single contract by generateUnoptimizedIR.
+	/// Can be called concurrently for different contracts.
+	/// Uses up to @a _maxThreads threads to optimize the Yul objects of the contract.
+	void optimizeIR(ContractDefinition const& _contract, size_t _maxThreads);
+
 	/// Generate EVM representation for a single contract.
 	/// Depends on output generated by generateIR.
-	void generateEVMFromIR(ContractDefinition const& _contract);
+	/// Can be called concurrently for different contracts.
+	/// Uses up to @a _maxThreads threads to optimise the sub-assemblies of the contract.
+	void generateEVMFromIR(
+		ContractDefinition const& _contract,
+		langutil::ErrorReporter& _errorReporter,
+		size_t _maxThreads
+	);
 
 	/// Links all the known library addresses in the available objects. Any unknown
 	/// library will still be kept as an unlinked placeholder in the objects.
@@ -578,14 +685,21 @@ private:
 		FunctionDefinition const& _function
 	) const;
 
-	void reportUnimplementedFeatureError(langutil::UnimplementedFeatureError const& _error);
-	void reportIRPostAnalysisError(langutil::Error const* _error);
+	static void reportUnimplementedFeatureError(
+		langutil::UnimplementedFeatureError const& _error,
+		langutil::ErrorReporter& _errorReporter
+	);
+	static void reportIRPostAnalysisError(langutil::Error const* _error, langutil::ErrorReporter& _errorReporter);
 
 	ReadCallback::Callback m_readFile;
 	OptimiserSettings m_optimiserSettings;
 	RevertStrings m_revertStrings = RevertStrings::Default;
 	State m_stopAfter = State::CompilationSuccessful;
 	bool m_viaIR = false;
+	size_t m_parallelism = 1;
+	/// Workers used together with the compiling thread when m_parallelism is greater than one.
+	/// Kept across compilations, so that the threads and their thread-local state are reused.
+	std::unique_ptr<util::ThreadPool> m_threadPool;
 	langutil::EVMVersion m_evmVersion;
 	std::optional<uint8_t> m_eofVersion;
 	ModelCheckerSettings m_modelCheckerSettings;
@@ -600,6 +714,9 @@ private:
 	std::vector<Source const*> m_sourceOrder;
 	std::map<std::string const, Contract> m_contracts;
 	std::shared_ptr<yul::ObjectOptimizer> m_objectOptimizer;
+	std::shared_ptr<ParsedSourceCache> m_parsedSourceCache;
+	bool m_profiling = false;
+	std::unique_ptr<util::Profiler> m_profiler;
 
 	langutil::ErrorList m_errorList;
 	langutil::ErrorReporter m_errorReporter;
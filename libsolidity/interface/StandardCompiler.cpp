@@ -27,6 +27,7 @@
 #include <libsolidity/ast/ASTJsonExporter.h>
 #include <libyul/YulStack.h>
 #include <libyul/Exceptions.h>
+#include <libyul/YulString.h>
 #include <libyul/optimiser/Suite.h>
 
 #include <libevmasm/Disassemble.h>
@@ -43,7 +44,9 @@
 #include <boost/algorithm/string/predicate.hpp>
 
 #include <algorithm>
+#include <chrono>
 #include <optional>
+#include <sstream>
 
 using namespace solidity;
 using namespace solidity::yul;
@@ -85,6 +88,24 @@ Json formatFatalError(Error::Type _type, std::string const& _message)
 	return output;
 }
 
+/// @returns the output reporting the exception that is currently being handled.
+Json formatCompilationException()
+{
+	try
+	{
+		throw;
+	}
+	catch (UnimplementedFeatureError const& _exception)
+	{
+		solAssert(_exception.comment(), "Unimplemented feature errors must include a message for the user");
+		return formatFatalError(Error::Type::UnimplementedFeatureError, stringOrDefault(_exception.comment()));
+	}
+	catch (...)
+	{
+		return formatFatalError(Error::Type::InternalCompilerError, "Internal exception in StandardCompiler::compile: " +  boost::current_exception_diagnostic_information());
+	}
+}
+
 Json formatSourceLocation(SourceLocation const* location)
 {
 	if (!location || !location->sourceName)
@@ -198,7 +219,7 @@ bool isArtifactRequested(Json const& _outputSelection, std::string const& _artif
 ///
 /// In @a _outputSelection the use of '*' as a wildcard is permitted.
 ///
-/// @TODO optimise this. Perhaps flatten the structure upfront.
+/// Use ArtifactSelection when checking many artifacts of the same contract.
 ///
 bool isArtifactRequested(Json const& _outputSelection, std::string const& _file, std::string const& _contract, std::string const& _artifact, bool _wildcardMatchesExperimental)
 {
@@ -233,6 +254,54 @@ bool isArtifactRequested(Json const& _outputSelection, std::string const& _file,
 	return false;
 }
 
+/// The part of the output selection that applies to a single contract, or to a source unit if the
+/// contract name is empty. Equivalent to isArtifactRequested() above, but looks up the entries for
+/// the file, the contract and their wildcards only once.
+class ArtifactSelection
+{
+public:
+	ArtifactSelection(Json const& _outputSelection, std::string const& _file, std::string const& _contract)
+	{
+		if (!_outputSelection.is_object())
+			return;
+		for (auto const& file: {_file, std::string("*")})
+		{
+			auto fileSelection = _outputSelection.find(file);
+			if (fileSelection == _outputSelection.end() || !fileSelection->is_object())
+				continue;
+			std::vector<std::string> contracts{_contract};
+			if (!_contract.empty())
+				contracts.emplace_back("*");
+			for (auto const& contract: contracts)
+			{
+				auto contractSelection = fileSelection->find(contract);
+				if (contractSelection != fileSelection->end() && contractSelection->is_array())
+					m_selections.push_back(&*contractSelection);
+			}
+		}
+	}
+
+	bool requested(std::string const& _artifact, bool _wildcardMatchesExperimental) const
+	{
+		for (Json const* selection: m_selections)
+			if (isArtifactRequested(*selection, _artifact, _wildcardMatchesExperimental))
+				return true;
+		return false;
+	}
+
+	bool requested(std::vector<std::string> const& _artifacts, bool _wildcardMatchesExperimental) const
+	{
+		for (auto const& artifact: _artifacts)
+			if (requested(artifact, _wildcardMatchesExperimental))
+				return true;
+		return false;
+	}
+
+private:
+	/// The artifact arrays of the matching entries of the output selection.
+	std::vector<Json const*> m_selections;
+};
+
 /// @returns all artifact names of the EVM object, either for creation or deploy time.
 std::vector<std::string> evmObjectComponents(std::string const& _objectKind)
 {
@@ -406,7 +475,7 @@ std::optional<Json> checkAuxiliaryInputKeys(Json const& _input)
 
 std::optional<Json> checkSettingsKeys(Json const& _input)
 {
-	static std::set<std::string> keys{"debug", "evmVersion", "eofVersion", "libraries", "metadata", "modelChecker", "optimizer", "outputSelection", "remappings", "stopAfter", "viaIR"};
+	static std::set<std::string> keys{"debug", "evmVersion", "eofVersion", "libraries", "metadata", "modelChecker", "optimizer", "outputSelection", "parallelism", "remappings", "stopAfter", "viaIR"};
 	return checkKeys(_input, keys, "settings");
 }
 
@@ -797,6 +866,13 @@ std::variant<StandardCompiler::InputsAndSettings, Json> StandardCompiler::parseI
 		ret.viaIR = settings["viaIR"].get<bool>();
 	}
 
+	if (settings.contains("parallelism"))
+	{
+		if (!settings["parallelism"].is_number_unsigned() || settings["parallelism"].get<uint64_t>() == 0)
+			return formatFatalError(Error::Type::JSONError, "\"settings.parallelism\" must be a positive integer.");
+		ret.parallelism = settings["parallelism"].get<size_t>();
+	}
+
 	if (settings.contains("evmVersion"))
 	{
 		if (!settings["evmVersion"].is_string())
@@ -825,7 +901,7 @@ std::variant<StandardCompiler::InputsAndSettings, Json> StandardCompiler::parseI
 
 	if (settings.contains("debug"))
 	{
-		if (auto result = checkKeys(settings["debug"], {"revertStrings", "debugInfo"}, "settings.debug"))
+		if (auto result = checkKeys(settings["debug"], {"revertStrings", "debugInfo", "profile"}, "settings.debug"))
 			return *result;
 
 		if (settings["debug"].contains("revertStrings"))
@@ -867,6 +943,13 @@ std::variant<StandardCompiler::InputsAndSettings, Json> StandardCompiler::parseI
 
 			ret.debugInfoSelection = debugInfoSelection.value();
 		}
+
+		if (settings["debug"].contains("profile"))
+		{
+			if (!settings["debug"]["profile"].is_boolean())
+				return formatFatalError(Error::Type::JSONError, "settings.debug.profile must be a Boolean.");
+			ret.profile = settings["debug"]["profile"].get<bool>();
+		}
 	}
 
 	if (settings.contains("remappings") && !settings["remappings"].is_array())
@@ -1277,11 +1360,19 @@ Json StandardCompiler::importEVMAssembly(StandardCompiler::InputsAndSettings _in
 	return util::removeNullMembers(output);
 }
 
-Json StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inputsAndSettings)
+void StandardCompiler::compileSolidity(
+	StandardCompiler::InputsAndSettings _inputsAndSettings,
+	OutputWriter const& _writeOutput
+)
 {
 	solAssert(_inputsAndSettings.jsonSources.empty());
 
 	CompilerStack compilerStack(m_readFile);
+	if (m_objectOptimizer)
+		compilerStack.setObjectOptimizer(m_objectOptimizer);
+	if (m_parsedSourceCache)
+		compilerStack.setParsedSourceCache(m_parsedSourceCache);
+	compilerStack.setProfiling(_inputsAndSettings.profile);
 
 	StringMap sourceList = std::move(_inputsAndSettings.sources);
 	if (_inputsAndSettings.language == "Solidity")
@@ -1289,6 +1380,7 @@ Json StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inpu
 	for (auto const& smtLib2Response: _inputsAndSettings.smtLib2Responses)
 		compilerStack.addSMTLib2Response(smtLib2Response.first, smtLib2Response.second);
 	compilerStack.setViaIR(_inputsAndSettings.viaIR);
+	compilerStack.setParallelism(_inputsAndSettings.parallelism);
 	compilerStack.setEVMVersion(_inputsAndSettings.evmVersion);
 	compilerStack.setEOFVersion(_inputsAndSettings.eofVersion);
 	compilerStack.setRemappings(std::move(_inputsAndSettings.remappings));
@@ -1407,132 +1499,159 @@ Json StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inpu
 	if (compilationFailed || analysisFailed || !parsingSuccess)
 		solAssert(!errors.empty(), "No error reported, but compilation failed.");
 
-	Json output;
-
-	if (errors.size() > 0)
-		output["errors"] = std::move(errors);
-
+	// The members of the output are written in ascending order of their keys,
+	// i.e. "auxiliaryInputRequested", "contracts", "errors", "profile" and "sources".
 	if (!compilerStack.unhandledSMTLib2Queries().empty())
+	{
+		Json auxiliaryInput;
 		for (std::string const& query: compilerStack.unhandledSMTLib2Queries())
-			output["auxiliaryInputRequested"]["smtlib2queries"]["0x" + util::keccak256(query).hex()] = query;
+			auxiliaryInput["smtlib2queries"]["0x" + util::keccak256(query).hex()] = query;
+		_writeOutput({"auxiliaryInputRequested"}, std::move(auxiliaryInput));
+	}
 
 	bool const wildcardMatchesExperimental = false;
 
-	output["sources"] = Json::object();
-	unsigned sourceIndex = 0;
-	// NOTE: A case that will pass `parsingSuccess && !analysisFailed` but not `analysisSuccess` is
-	// stopAfter: parsing with no parsing errors.
-	if (parsingSuccess && !analysisFailed)
-		for (std::string const& sourceName: compilerStack.sourceNames())
-		{
-			Json sourceResult;
-			sourceResult["id"] = sourceIndex++;
-			if (isArtifactRequested(_inputsAndSettings.outputSelection, sourceName, "", "ast", wildcardMatchesExperimental))
-				sourceResult["ast"] = ASTJsonExporter(compilerStack.state(), compilerStack.sourceIndices()).toJson(compilerStack.ast(sourceName));
-			output["sources"][sourceName] = sourceResult;
-		}
-
-	Json contractsOutput;
+	std::vector<std::pair<std::string, std::string>> contracts;
 	for (std::string const& contractName: analysisSuccess ? compilerStack.contractNames() : std::vector<std::string>())
 	{
 		size_t colon = contractName.rfind(':');
 		solAssert(colon != std::string::npos, "");
-		std::string file = contractName.substr(0, colon);
-		std::string name = contractName.substr(colon + 1);
+		contracts.emplace_back(contractName.substr(0, colon), contractName.substr(colon + 1));
+	}
+	std::sort(contracts.begin(), contracts.end());
+
+	// With profiling enabled, the time spent on generating each artifact is reported in microseconds.
+	using Clock = std::chrono::steady_clock;
+	auto timed = [&](Json& _timings, std::string const& _artifact, auto const& _generate)
+	{
+		if (!_inputsAndSettings.profile)
+			return Json(_generate());
+		Clock::time_point start = Clock::now();
+		Json result = _generate();
+		_timings[_artifact] = Json::number_unsigned_t(
+			std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count()
+		);
+		return result;
+	};
+
+	for (auto const& [file, name]: contracts)
+	{
+		std::string const contractName = file + ":" + name;
+		ArtifactSelection const selection(_inputsAndSettings.outputSelection, file, name);
+		Json artifactTimings = Json::object();
+		auto generate = [&](std::string const& _artifact, auto const& _generate) {
+			return timed(artifactTimings, _artifact, _generate);
+		};
 
 		// ABI, storage layout, documentation and metadata
 		Json contractData;
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "abi", wildcardMatchesExperimental))
-			contractData["abi"] = compilerStack.contractABI(contractName);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "storageLayout", false))
-			contractData["storageLayout"] = compilerStack.storageLayout(contractName);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "transientStorageLayout", false))
-			contractData["transientStorageLayout"] = compilerStack.transientStorageLayout(contractName);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "metadata", wildcardMatchesExperimental))
-			contractData["metadata"] = compilerStack.metadata(contractName);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "userdoc", wildcardMatchesExperimental))
-			contractData["userdoc"] = compilerStack.natspecUser(contractName);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "devdoc", wildcardMatchesExperimental))
-			contractData["devdoc"] = compilerStack.natspecDev(contractName);
+		if (selection.requested("abi", wildcardMatchesExperimental))
+			contractData["abi"] = generate("abi", [&]{ return compilerStack.contractABI(contractName); });
+		if (selection.requested("storageLayout", false))
+			contractData["storageLayout"] = generate("storageLayout", [&]{ return compilerStack.storageLayout(contractName); });
+		if (selection.requested("transientStorageLayout", false))
+			contractData["transientStorageLayout"] = generate("transientStorageLayout", [&]{ return compilerStack.transientStorageLayout(contractName); });
+		if (selection.requested("metadata", wildcardMatchesExperimental))
+			contractData["metadata"] = generate("metadata", [&]{ return compilerStack.metadata(contractName); });
+		if (selection.requested("userdoc", wildcardMatchesExperimental))
+			contractData["userdoc"] = generate("userdoc", [&]{ return compilerStack.natspecUser(contractName); });
+		if (selection.requested("devdoc", wildcardMatchesExperimental))
+			contractData["devdoc"] = generate("devdoc", [&]{ return compilerStack.natspecDev(contractName); });
 
 		// IR
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "ir", wildcardMatchesExperimental))
-			contractData["ir"] = compilerStack.yulIR(contractName).value_or("");
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "irAst", wildcardMatchesExperimental))
-			contractData["irAst"] = compilerStack.yulIRAst(contractName).value_or(Json{});
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "irOptimized", wildcardMatchesExperimental))
-			contractData["irOptimized"] = compilerStack.yulIROptimized(contractName).value_or("");
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "irOptimizedAst", wildcardMatchesExperimental))
-			contractData["irOptimizedAst"] = compilerStack.yulIROptimizedAst(contractName).value_or(Json{});
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "yulCFGJson", wildcardMatchesExperimental))
-			contractData["yulCFGJson"] = compilerStack.yulCFGJson(contractName).value_or(Json{});
+		if (compilationSuccess && selection.requested("ir", wildcardMatchesExperimental))
+			contractData["ir"] = generate("ir", [&]{ return compilerStack.yulIR(contractName).value_or(""); });
+		if (compilationSuccess && selection.requested("irAst", wildcardMatchesExperimental))
+			contractData["irAst"] = generate("irAst", [&]{ return compilerStack.yulIRAst(contractName).value_or(Json{}); });
+		if (compilationSuccess && selection.requested("irOptimized", wildcardMatchesExperimental))
+			contractData["irOptimized"] = generate("irOptimized", [&]{ return compilerStack.yulIROptimized(contractName).value_or(""); });
+		if (compilationSuccess && selection.requested("irOptimizedAst", wildcardMatchesExperimental))
+			contractData["irOptimizedAst"] = generate("irOptimizedAst", [&]{ return compilerStack.yulIROptimizedAst(contractName).value_or(Json{}); });
+		if (compilationSuccess && selection.requested("yulCFGJson", wildcardMatchesExperimental))
+			contractData["yulCFGJson"] = generate("yulCFGJson", [&]{ return compilerStack.yulCFGJson(contractName).value_or(Json{}); });
 
 		// EVM
 		Json evmData;
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.assembly", wildcardMatchesExperimental))
-			evmData["assembly"] = compilerStack.assemblyString(contractName, sourceList);
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.legacyAssembly", wildcardMatchesExperimental))
-			evmData["legacyAssembly"] = compilerStack.assemblyJSON(contractName);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.methodIdentifiers", wildcardMatchesExperimental))
-			evmData["methodIdentifiers"] = compilerStack.interfaceSymbols(contractName)["methods"];
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.gasEstimates", wildcardMatchesExperimental))
-			evmData["gasEstimates"] = compilerStack.gasEstimates(contractName);
-
-		if (compilationSuccess && isArtifactRequested(
-			_inputsAndSettings.outputSelection,
-			file,
-			name,
-			evmObjectComponents("bytecode"),
-			wildcardMatchesExperimental
-		))
+		if (compilationSuccess && selection.requested("evm.assembly", wildcardMatchesExperimental))
+			evmData["assembly"] = generate("evm.assembly", [&]{ return compilerStack.assemblyString(contractName, sourceList); });
+		if (compilationSuccess && selection.requested("evm.legacyAssembly", wildcardMatchesExperimental))
+			evmData["legacyAssembly"] = generate("evm.legacyAssembly", [&]{ return compilerStack.assemblyJSON(contractName); });
+		if (selection.requested("evm.methodIdentifiers", wildcardMatchesExperimental))
+			evmData["methodIdentifiers"] = generate("evm.methodIdentifiers", [&]{ return compilerStack.interfaceSymbols(contractName)["methods"]; });
+		if (compilationSuccess && selection.requested("evm.gasEstimates", wildcardMatchesExperimental))
+			evmData["gasEstimates"] = generate("evm.gasEstimates", [&]{ return compilerStack.gasEstimates(contractName); });
+
+		if (compilationSuccess && selection.requested(evmObjectComponents("bytecode"), wildcardMatchesExperimental))
 		{
 			auto const evmCreationArtifactRequested = [&](std::string const& _element) {
-				return isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.bytecode." + _element, wildcardMatchesExperimental);
+				return selection.requested("evm.bytecode." + _element, wildcardMatchesExperimental);
+			};
+			auto const generateCreationArtifact = [&](std::string const& _element, auto const& _generate) {
+				return generate("evm.bytecode." + _element, _generate);
 			};
 
 			Json creationJSON;
 			if (evmCreationArtifactRequested("object"))
-				creationJSON["object"] = compilerStack.object(contractName).toHex();
+				creationJSON["object"] = generateCreationArtifact("object", [&]{ return compilerStack.object(contractName).toHex(); });
 			if (evmCreationArtifactRequested("opcodes"))
-				creationJSON["opcodes"] = evmasm::disassemble(compilerStack.object(contractName).bytecode, _inputsAndSettings.evmVersion);
+				creationJSON["opcodes"] = generateCreationArtifact("opcodes", [&]{
+					return evmasm::disassemble(compilerStack.object(contractName).bytecode, _inputsAndSettings.evmVersion);
+				});
 			if (evmCreationArtifactRequested("sourceMap"))
-				creationJSON["sourceMap"] = compilerStack.sourceMapping(contractName) ? *compilerStack.sourceMapping(contractName) : "";
+				creationJSON["sourceMap"] = generateCreationArtifact("sourceMap", [&]{
+					return compilerStack.sourceMapping(contractName) ? *compilerStack.sourceMapping(contractName) : "";
+				});
 			if (evmCreationArtifactRequested("functionDebugData"))
-				creationJSON["functionDebugData"] = formatFunctionDebugData(compilerStack.object(contractName).functionDebugData);
+				creationJSON["functionDebugData"] = generateCreationArtifact("functionDebugData", [&]{
+					return formatFunctionDebugData(compilerStack.object(contractName).functionDebugData);
+				});
 			if (evmCreationArtifactRequested("linkReferences"))
-				creationJSON["linkReferences"] = formatLinkReferences(compilerStack.object(contractName).linkReferences);
+				creationJSON["linkReferences"] = generateCreationArtifact("linkReferences", [&]{
+					return formatLinkReferences(compilerStack.object(contractName).linkReferences);
+				});
 			if (evmCreationArtifactRequested("generatedSources"))
-				creationJSON["generatedSources"] = compilerStack.generatedSources(contractName, /* _runtime */ false);
+				creationJSON["generatedSources"] = generateCreationArtifact("generatedSources", [&]{
+					return compilerStack.generatedSources(contractName, /* _runtime */ false);
+				});
 			evmData["bytecode"] = creationJSON;
 		}
 
-		if (compilationSuccess && isArtifactRequested(
-			_inputsAndSettings.outputSelection,
-			file,
-			name,
-			evmObjectComponents("deployedBytecode"),
-			wildcardMatchesExperimental
-		))
+		if (compilationSuccess && selection.requested(evmObjectComponents("deployedBytecode"), wildcardMatchesExperimental))
 		{
 			auto const evmDeployedArtifactRequested = [&](std::string const& _element) {
-				return isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.deployedBytecode." + _element, wildcardMatchesExperimental);
+				return selection.requested("evm.deployedBytecode." + _element, wildcardMatchesExperimental);
+			};
+			auto const generateDeployedArtifact = [&](std::string const& _element, auto const& _generate) {
+				return generate("evm.deployedBytecode." + _element, _generate);
 			};
 
 			Json deployedJSON;
 			if (evmDeployedArtifactRequested("object"))
-				deployedJSON["object"] = compilerStack.runtimeObject(contractName).toHex();
+				deployedJSON["object"] = generateDeployedArtifact("object", [&]{ return compilerStack.runtimeObject(contractName).toHex(); });
 			if (evmDeployedArtifactRequested("opcodes"))
-				deployedJSON["opcodes"] = evmasm::disassemble(compilerStack.runtimeObject(contractName).bytecode, _inputsAndSettings.evmVersion);
+				deployedJSON["opcodes"] = generateDeployedArtifact("opcodes", [&]{
+					return evmasm::disassemble(compilerStack.runtimeObject(contractName).bytecode, _inputsAndSettings.evmVersion);
+				});
 			if (evmDeployedArtifactRequested("sourceMap"))
-				deployedJSON["sourceMap"] = compilerStack.runtimeSourceMapping(contractName) ? *compilerStack.runtimeSourceMapping(contractName) : "";
+				deployedJSON["sourceMap"] = generateDeployedArtifact("sourceMap", [&]{
+					return compilerStack.runtimeSourceMapping(contractName) ? *compilerStack.runtimeSourceMapping(contractName) : "";
+				});
 			if (evmDeployedArtifactRequested("functionDebugData"))
-				deployedJSON["functionDebugData"] = formatFunctionDebugData(compilerStack.runtimeObject(contractName).functionDebugData);
+				deployedJSON["functionDebugData"] = generateDeployedArtifact("functionDebugData", [&]{
+					return formatFunctionDebugData(compilerStack.runtimeObject(contractName).functionDebugData);
+				});
 			if (evmDeployedArtifactRequested("linkReferences"))
-				deployedJSON["linkReferences"] = formatLinkReferences(compilerStack.runtimeObject(contractName).linkReferences);
+				deployedJSON["linkReferences"] = generateDeployedArtifact("linkReferences", [&]{
+					return formatLinkReferences(compilerStack.runtimeObject(contractName).linkReferences);
+				});
 			if (evmDeployedArtifactRequested("immutableReferences"))
-				deployedJSON["immutableReferences"] = formatImmutableReferences(compilerStack.runtimeObject(contractName).immutableReferences);
+				deployedJSON["immutableReferences"] = generateDeployedArtifact("immutableReferences", [&]{
+					return formatImmutableReferences(compilerStack.runtimeObject(contractName).immutableReferences);
+				});
 			if (evmDeployedArtifactRequested("generatedSources"))
-				deployedJSON["generatedSources"] = compilerStack.generatedSources(contractName, /* _runtime */ true);
+				deployedJSON["generatedSources"] = generateDeployedArtifact("generatedSources", [&]{
+					return compilerStack.generatedSources(contractName, /* _runtime */ true);
+				});
 			evmData["deployedBytecode"] = deployedJSON;
 		}
 
@@ -1541,15 +1660,48 @@ Json StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inpu
 
 		if (!contractData.empty())
 		{
-			if (!contractsOutput.contains(file))
-				contractsOutput[file] = Json::object();
-			contractsOutput[file][name] = contractData;
+			if (_inputsAndSettings.profile)
+			{
+				contractData["profile"]["artifacts"] = std::move(artifactTimings);
+				contractData["profile"]["phases"] = compilerStack.contractProfiler(contractName)->toJson();
+			}
+			_writeOutput({"contracts", file, name}, std::move(contractData));
 		}
 	}
-	if (!contractsOutput.empty())
-		output["contracts"] = contractsOutput;
 
-	return output;
+	// The source results are generated before the errors are written, so that an exception
+	// while generating them can still be reported (see compile()).
+	std::vector<std::pair<std::string, Json>> sourceResults;
+	// NOTE: A case that will pass `parsingSuccess && !analysisFailed` but not `analysisSuccess` is
+	// stopAfter: parsing with no parsing errors.
+	if (parsingSuccess && !analysisFailed)
+	{
+		unsigned sourceIndex = 0;
+		for (std::string const& sourceName: compilerStack.sourceNames())
+		{
+			Json sourceResult;
+			sourceResult["id"] = sourceIndex++;
+			Json artifactTimings = Json::object();
+			if (ArtifactSelection(_inputsAndSettings.outputSelection, sourceName, "").requested("ast", wildcardMatchesExperimental))
+				sourceResult["ast"] = timed(artifactTimings, "ast", [&]{
+					return ASTJsonExporter(compilerStack.state(), compilerStack.sourceIndices()).toJson(compilerStack.ast(sourceName));
+				});
+			if (_inputsAndSettings.profile)
+				sourceResult["profile"]["artifacts"] = std::move(artifactTimings);
+			sourceResults.emplace_back(sourceName, std::move(sourceResult));
+		}
+	}
+
+	if (errors.size() > 0)
+		_writeOutput({"errors"}, std::move(errors));
+
+	if (_inputsAndSettings.profile)
+		_writeOutput({"profile"}, Json{{"phases", compilerStack.profiler()->toJson()}});
+
+	if (sourceResults.empty())
+		_writeOutput({"sources"}, Json::object());
+	for (auto&& [sourceName, sourceResult]: sourceResults)
+		_writeOutput({"sources", sourceName}, std::move(sourceResult));
 }
 
 
@@ -1596,6 +1748,15 @@ Json StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 		));
 		return output;
 	}
+	if (_inputsAndSettings.profile)
+	{
+		output["errors"].emplace_back(formatError(
+			Error::Type::JSONError,
+			"general",
+			"Field \"settings.debug.profile\" cannot be used for Yul."
+		));
+		return output;
+	}
 
 	YulStack stack(
 		_inputsAndSettings.evmVersion,
@@ -1604,7 +1765,9 @@ Json StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 		_inputsAndSettings.optimiserSettings,
 		_inputsAndSettings.debugInfoSelection.has_value() ?
 			_inputsAndSettings.debugInfoSelection.value() :
-			DebugInfoSelection::Default()
+			DebugInfoSelection::Default(),
+		nullptr,
+		m_objectOptimizer
 	);
 	std::string const& sourceName = _inputsAndSettings.sources.begin()->first;
 	std::string const& sourceContents = _inputsAndSettings.sources.begin()->second;
@@ -1703,35 +1866,50 @@ Json StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 	return output;
 }
 
-Json StandardCompiler::compile(Json const& _input) noexcept
+void StandardCompiler::compile(Json const& _input, OutputWriter const& _writeOutput)
 {
-	YulStringRepository::reset();
-
-	try
+	// Keeps the YulStrings of this compilation valid if another one resets the repository.
+	YulStringRepository::Scope yulStringScope;
+	auto parsed = parseInput(_input);
+	Json output;
+	if (std::holds_alternative<Json>(parsed))
+		output = std::get<Json>(std::move(parsed));
+	else
 	{
-		auto parsed = parseInput(_input);
-		if (std::holds_alternative<Json>(parsed))
-			return std::get<Json>(std::move(parsed));
 		InputsAndSettings settings = std::get<InputsAndSettings>(std::move(parsed));
-		if (settings.language == "Solidity")
-			return compileSolidity(std::move(settings));
+		if (settings.language == "Solidity" || settings.language == "SolidityAST")
+		{
+			compileSolidity(std::move(settings), _writeOutput);
+			return;
+		}
 		else if (settings.language == "Yul")
-			return compileYul(std::move(settings));
-		else if (settings.language == "SolidityAST")
-			return compileSolidity(std::move(settings));
+			output = compileYul(std::move(settings));
 		else if (settings.language == "EVMAssembly")
-			return importEVMAssembly(std::move(settings));
+			output = importEVMAssembly(std::move(settings));
 		else
-			return formatFatalError(Error::Type::JSONError, "Only \"Solidity\", \"Yul\", \"SolidityAST\" or \"EVMAssembly\" is supported as a language.");
+			output = formatFatalError(Error::Type::JSONError, "Only \"Solidity\", \"Yul\", \"SolidityAST\" or \"EVMAssembly\" is supported as a language.");
 	}
-	catch (UnimplementedFeatureError const& _exception)
+
+	for (auto it = output.begin(); it != output.end(); ++it)
+		_writeOutput({it.key()}, std::move(it.value()));
+}
+
+Json StandardCompiler::compile(Json const& _input) noexcept
+{
+	try
 	{
-		solAssert(_exception.comment(), "Unimplemented feature errors must include a message for the user");
-		return formatFatalError(Error::Type::UnimplementedFeatureError, stringOrDefault(_exception.comment()));
+		Json output;
+		compile(_input, [&](std::vector<std::string> const& _path, Json _value) {
+			Json* member = &output;
+			for (std::string const& key: _path)
+				member = &(*member)[key];
+			*member = std::move(_value);
+		});
+		return output;
 	}
 	catch (...)
 	{
-		return formatFatalError(Error::Type::InternalCompilerError, "Internal exception in StandardCompiler::compile: " +  boost::current_exception_diagnostic_information());
+		return formatCompilationException();
 	}
 }
 
@@ -1752,9 +1930,7 @@ std::string StandardCompiler::compile(std::string const& _input) noexcept
 			return "{\"errors\":[{\"type\":\"JSONError\",\"component\":\"general\",\"severity\":\"error\",\"message\":\"Error parsing input JSON: " + errors + "\"}]}";
 	}
 
-//	std::cout << "Input: " << solidity::util::jsonPrettyPrint(input) << std::endl;
 	Json output = compile(input);
-//	std::cout << "Output: " << solidity::util::jsonPrettyPrint(output) << std::endl;
 
 	try
 	{
@@ -1766,6 +1942,43 @@ std::string StandardCompiler::compile(std::string const& _input) noexcept
 	}
 }
 
+void StandardCompiler::compile(std::string const& _input, std::ostream& _output) noexcept
+{
+	// Indented output and the errors about invalid input are produced from the complete output object.
+	Json input;
+	try
+	{
+		if (m_jsonPrintingFormat.format != util::JsonFormat::Compact || !util::jsonParseStrict(_input, input))
+		{
+			_output << compile(_input);
+			return;
+		}
+	}
+	catch (...)
+	{
+		_output << compile(_input);
+		return;
+	}
+
+	util::JsonObjectStreamWriter writer(_output);
+	try
+	{
+		compile(input, [&](std::vector<std::string> const& _path, Json _value) {
+			writer.write(_path, _value);
+		});
+	}
+	catch (...)
+	{
+		// Members that have already been written cannot be taken back. The exception is reported as
+		// the only entry of "errors", which is possible unless it has been written already. The
+		// members that can fail to be generated are written before it (see compileSolidity()).
+		Json output = formatCompilationException();
+		if (writer.accepts({"errors"}))
+			writer.write({"errors"}, output["errors"]);
+	}
+	writer.finish();
+}
+
 Json StandardCompiler::formatFunctionDebugData(
 	std::map<std::string, evmasm::LinkerObject::FunctionDebugData> const& _debugInfo
 )
@@ -28,7 +28,9 @@
 
 #include <liblangutil/DebugInfoSelection.h>
 
+#include <functional>
 #include <optional>
+#include <ostream>
 #include <utility>
 #include <variant>
 
@@ -58,10 +60,30 @@ public:
 
 	/// Sets all input parameters according to @a _input which conforms to the standardized input
 	/// format, performs compilation and returns a standardized output.
+	/// If an exception occurs, the output only contains the error describing it.
 	Json compile(Json const& _input) noexcept;
 	/// Parses input as JSON and performs the above processing steps, returning a serialized JSON
 	/// output. Parsing errors are returned as regular errors.
 	std::string compile(std::string const& _input) noexcept;
+	/// Same as above, but writes the serialized output to @a _output. In the compact format, the
+	/// output of Solidity compilations is written source by source and contract by contract as it
+	/// is generated, without assembling the whole output in memory. If an exception occurs then, the
+	/// members written before it are kept and the exception is reported as the only entry of "errors".
+	void compile(std::string const& _input, std::ostream& _output) noexcept;
+
+	/// Makes all subsequent compilations use @a _objectOptimizer, so that optimized Yul code is
+	/// reused across calls to compile(). By default every compilation uses a fresh cache.
+	void setObjectOptimizer(std::shared_ptr<yul::ObjectOptimizer> _objectOptimizer)
+	{
+		m_objectOptimizer = std::move(_objectOptimizer);
+	}
+
+	/// Makes all subsequent Solidity compilations take unchanged sources from @a _cache instead of
+	/// parsing them again. By default every compilation parses all of its sources.
+	void setParsedSourceCache(std::shared_ptr<CompilerStack::ParsedSourceCache> _cache)
+	{
+		m_parsedSourceCache = std::move(_cache);
+	}
 
 	static Json formatFunctionDebugData(
 		std::map<std::string, evmasm::LinkerObject::FunctionDebugData> const& _debugInfo
@@ -89,18 +111,27 @@ private:
 		Json outputSelection;
 		ModelCheckerSettings modelCheckerSettings = ModelCheckerSettings{};
 		bool viaIR = false;
+		size_t parallelism = 1;
+		bool profile = false;
 	};
 
+	/// Receives the members of the output in the order and form of util::JsonObjectStreamWriter::write().
+	using OutputWriter = std::function<void(std::vector<std::string> const& _path, Json _value)>;
+
 	/// Parses the input json (and potentially invokes the read callback) and either returns
 	/// it in condensed form or an error as a json object.
 	std::variant<InputsAndSettings, Json> parseInput(Json const& _input);
 
 	std::map<std::string, Json> parseAstFromInput(StringMap const& _sources);
 	Json importEVMAssembly(InputsAndSettings _inputsAndSettings);
-	Json compileSolidity(InputsAndSettings _inputsAndSettings);
+	/// Compiles @a _input and passes the members of the output to @a _writeOutput.
+	void compile(Json const& _input, OutputWriter const& _writeOutput);
+	void compileSolidity(InputsAndSettings _inputsAndSettings, OutputWriter const& _writeOutput);
 	Json compileYul(InputsAndSettings _inputsAndSettings);
 
 	ReadCallback::Callback m_readFile;
+	std::shared_ptr<yul::ObjectOptimizer> m_objectOptimizer;
+	std::shared_ptr<CompilerStack::ParsedSourceCache> m_parsedSourceCache;
 
 	util::JsonFormat m_jsonPrintingFormat;
 };
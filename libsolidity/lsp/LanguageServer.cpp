@@ -30,10 +30,14 @@
 #include <libsolidity/lsp/RenameSymbol.h>
 #include <libsolidity/lsp/SemanticTokensBuilder.h>
 
+#include <libyul/YulString.h>
+
 #include <liblangutil/SourceReferenceExtractor.h>
 #include <liblangutil/CharStream.h>
 
+#include <libsolutil/CommonData.h>
 #include <libsolutil/CommonIO.h>
+#include <libsolutil/Keccak256.h>
 #include <libsolutil/Visitor.h>
 #include <libsolutil/JSON.h>
 
@@ -41,8 +45,13 @@
 #include <boost/filesystem.hpp>
 #include <boost/algorithm/string/predicate.hpp>
 
+#include <range/v3/range/conversion.hpp>
+#include <range/v3/view/map.hpp>
+
+#include <algorithm>
 #include <ostream>
 #include <string>
+#include <thread>
 
 #include <fmt/format.h>
 
@@ -86,6 +95,30 @@ int toDiagnosticSeverity(Error::Type _errorType)
 	return -1;
 }
 
+/// Time to wait for further edits before analyzing the sources after a change.
+std::chrono::milliseconds constexpr analysisDebounceDelay{100};
+
+/// @returns true if requests of the given method are only answered from the analysis
+/// of the source unit they refer to.
+bool answeredFromAnalysis(std::string const& _methodName)
+{
+	return
+		_methodName == "textDocument/definition" ||
+		_methodName == "textDocument/hover" ||
+		_methodName == "textDocument/implementation" ||
+		_methodName == "textDocument/semanticTokens/full";
+}
+
+/// @returns true if messages of the given method change the sources or the way they are analyzed.
+bool changesSources(std::string const& _methodName)
+{
+	return
+		_methodName == "textDocument/didOpen" ||
+		_methodName == "textDocument/didChange" ||
+		_methodName == "textDocument/didClose" ||
+		_methodName == "workspace/didChangeConfiguration";
+}
+
 Json semanticTokensLegend()
 {
 	Json legend;
@@ -134,8 +167,6 @@ Json semanticTokensLegend()
 LanguageServer::LanguageServer(Transport& _transport):
 	m_client{_transport},
 	m_handlers{
-		{"$/cancelRequest", [](auto, auto) {/*nothing for now as we are synchronous */}},
-		{"cancelRequest", [](auto, auto) {/*nothing for now as we are synchronous */}},
 		{"exit", [this](auto, auto) { m_state = (m_state == State::ShutdownRequested ? State::ExitRequested : State::ExitWithoutShutdown); }},
 		{"initialize", std::bind(&LanguageServer::handleInitialize, this, _1, _2)},
 		{"initialized", std::bind(&LanguageServer::handleInitialized, this, _1, _2)},
@@ -189,6 +220,8 @@ void LanguageServer::changeConfiguration(Json const& _settings)
 	}
 
 	m_settingsObject = _settings;
+	// Enforce a full analysis on the next compilation.
+	m_rootSourceUnits.reset();
 	Json jsonIncludePaths = _settings.contains("include-paths") ? _settings["include-paths"] : Json::object();
 
 	if (!jsonIncludePaths.empty())
@@ -236,7 +269,7 @@ std::vector<boost::filesystem::path> LanguageServer::allSolidityFilesFromProject
 	return collectedPaths;
 }
 
-void LanguageServer::compile()
+void LanguageServer::compile(std::set<std::string> const& _requiredSourceUnits, bool _abandonIfOutdated)
 {
 	// For files that are not open, we have to take changes on disk into account,
 	// so we just remove all non-open files.
@@ -262,24 +295,117 @@ void LanguageServer::compile()
 			oldRepository.sourceUnits().at(oldRepository.uriToSourceUnitName(fileName))
 		);
 
-	// TODO: optimize! do not recompile if nothing has changed (file(s) not flagged dirty).
+	auto rootSourceUnits = m_fileRepository.sourceUnits() | ranges::views::keys | ranges::to<std::set<std::string>>;
+	bool const analyzeAll = rootSourceUnits != m_rootSourceUnits;
+	m_rootSourceUnits = std::move(rootSourceUnits);
+
+	if (analyzeAll)
+	{
+		m_analyzedSourceHashes.clear();
+		m_sourceUnitImports.clear();
+		m_diagnosticsBySourceUnit.clear();
+	}
+	else
+		// Reload the imported files that are neither open nor part of the project,
+		// so that changes on disk are noticed.
+		for (std::string const& sourceUnitName: m_analyzedSourceHashes | ranges::views::keys)
+			if (!m_rootSourceUnits->count(sourceUnitName))
+				m_fileRepository.readFile(ReadCallback::kindString(ReadCallback::Kind::ReadFile), sourceUnitName);
+
+	// Collect the source units whose content changed (or that were added or removed) since their last analysis.
+	StringMap const& sourceUnits = m_fileRepository.sourceUnits();
+	std::set<std::string> changedSourceUnits;
+	for (auto const& [sourceUnitName, hash]: m_analyzedSourceHashes)
+		if (!sourceUnits.count(sourceUnitName) || util::keccak256(sourceUnits.at(sourceUnitName)) != hash)
+			changedSourceUnits.insert(sourceUnitName);
+	for (std::string const& sourceUnitName: sourceUnits | ranges::views::keys)
+		if (!m_analyzedSourceHashes.count(sourceUnitName))
+			changedSourceUnits.insert(sourceUnitName);
+
+	// The analysis of a source unit depends on everything it imports, so the units
+	// (transitively) importing a changed unit have to be analyzed again as well.
+	std::set<std::string> outdatedSourceUnits = changedSourceUnits;
+	std::vector<std::string> worklist(changedSourceUnits.begin(), changedSourceUnits.end());
+	while (!worklist.empty())
+	{
+		std::string const sourceUnitName = std::move(worklist.back());
+		worklist.pop_back();
+		for (auto const& [importingSourceUnitName, imports]: m_sourceUnitImports)
+			if (imports.count(sourceUnitName) && outdatedSourceUnits.insert(importingSourceUnitName).second)
+				worklist.push_back(importingSourceUnitName);
+	}
 
+	std::vector<std::string> const analyzedSourceUnits = m_compilerStack.sourceNames();
+	std::set<std::string> sourceUnitsToAnalyze;
+	for (std::string const& sourceUnitName: outdatedSourceUnits)
+		if (sourceUnits.count(sourceUnitName))
+			sourceUnitsToAnalyze.insert(sourceUnitName);
+	for (std::string const& sourceUnitName: _requiredSourceUnits)
+		if (sourceUnits.count(sourceUnitName) && !util::contains(analyzedSourceUnits, sourceUnitName))
+			sourceUnitsToAnalyze.insert(sourceUnitName);
+
+	for (std::string const& sourceUnitName: outdatedSourceUnits)
+		if (!sourceUnits.count(sourceUnitName))
+		{
+			// The source unit is gone, its diagnostics will be cleared.
+			m_analyzedSourceHashes.erase(sourceUnitName);
+			m_sourceUnitImports.erase(sourceUnitName);
+			m_diagnosticsBySourceUnit.erase(sourceUnitName);
+		}
+
+	if (sourceUnitsToAnalyze.empty())
+		return;
+
+	// Keep the units that are still needed by the caller in the compiler stack.
+	for (std::string const& sourceUnitName: _requiredSourceUnits)
+		if (sourceUnits.count(sourceUnitName))
+			sourceUnitsToAnalyze.insert(sourceUnitName);
+
+	lspDebug(fmt::format(
+		"analyzing {} of {} source units",
+		sourceUnitsToAnalyze.size(),
+		sourceUnits.size()
+	));
+
+	StringMap sourcesToAnalyze;
+	for (std::string const& sourceUnitName: sourceUnitsToAnalyze)
+		sourcesToAnalyze[sourceUnitName] = sourceUnits.at(sourceUnitName);
+
+	// Imports of these sources are provided by the file repository.
 	m_compilerStack.reset(false);
-	m_compilerStack.setSources(m_fileRepository.sourceUnits());
-	m_compilerStack.compile(CompilerStack::State::AnalysisSuccessful);
+	// The ASTs of the compiler stack held the only YulStrings, so the strings of earlier analyses can be freed.
+	yul::YulStringRepository::reset();
+	m_compilerStack.setSources(std::move(sourcesToAnalyze));
+	if (m_compilerStack.parse() && !currentRequestCancelled() && !(_abandonIfOutdated && sourceChangeNext()))
+		m_compilerStack.analyze();
+
+	updateDiagnosticsCache();
+	lspRequire(!currentRequestCancelled(), ErrorCode::RequestCancelled, "Request cancelled.");
 }
 
-void LanguageServer::compileAndUpdateDiagnostics()
+void LanguageServer::updateDiagnosticsCache()
 {
-	compile();
+	// If the analysis stopped early, the diagnostics of the compiled units may be incomplete
+	// and the units have to be analyzed again on the next compilation.
+	bool const analysisComplete = m_compilerStack.state() >= CompilerStack::AnalysisSuccessful;
+	StringMap const& sourceUnits = m_fileRepository.sourceUnits();
 
-	// These are the source units we will sent diagnostics to the client for sure,
-	// even if it is just to clear previous diagnostics.
-	std::map<std::string, Json> diagnosticsBySourceUnit;
-	for (std::string const& sourceUnitName: m_fileRepository.sourceUnits() | ranges::views::keys)
-		diagnosticsBySourceUnit[sourceUnitName] = Json::array();
-	for (std::string const& sourceUnitName: m_nonemptyDiagnostics)
-		diagnosticsBySourceUnit[sourceUnitName] = Json::array();
+	for (std::string const& sourceUnitName: m_compilerStack.sourceNames())
+	{
+		m_diagnosticsBySourceUnit.erase(sourceUnitName);
+		if (!sourceUnits.count(sourceUnitName))
+			// Not a file, e.g. a source unit of the standard library.
+			continue;
+
+		m_analyzedSourceHashes[sourceUnitName] = analysisComplete ? util::keccak256(sourceUnits.at(sourceUnitName)) : util::h256{};
+		m_sourceUnitsAnalyzedSincePublishing.insert(sourceUnitName);
+
+		std::set<std::string>& imports = m_sourceUnitImports[sourceUnitName];
+		imports.clear();
+		if (m_compilerStack.state() >= CompilerStack::ParsedAndImported)
+			for (auto const* import: ASTNode::filteredNodes<ImportDirective>(m_compilerStack.ast(sourceUnitName).nodes()))
+				imports.insert(*import->annotation().absolutePath);
+	}
 
 	for (std::shared_ptr<Error const> const& error: m_compilerStack.errors())
 	{
@@ -307,16 +433,56 @@ void LanguageServer::compileAndUpdateDiagnostics()
 				jsonDiag["relatedInformation"].emplace_back(jsonRelated);
 			}
 
-		diagnosticsBySourceUnit[*location->sourceName].emplace_back(jsonDiag);
+		Json& diagnostics = m_diagnosticsBySourceUnit[*location->sourceName];
+		if (diagnostics.is_null())
+			diagnostics = Json::array();
+		diagnostics.emplace_back(std::move(jsonDiag));
+	}
+}
+
+void LanguageServer::requireAnalyzed(std::set<std::string> const& _sourceUnitNames)
+{
+	std::vector<std::string> const analyzedSourceUnits = m_compilerStack.sourceNames();
+	for (std::string const& sourceUnitName: _sourceUnitNames)
+		if (!util::contains(analyzedSourceUnits, sourceUnitName))
+		{
+			compile(_sourceUnitNames);
+			return;
+		}
+}
+
+void LanguageServer::compileAndUpdateDiagnostics()
+{
+	m_analysisDeadline.reset();
+	compile({}, true /* _abandonIfOutdated */);
+	if (sourceChangeNext())
+	{
+		// The diagnostics are outdated already. Analyze again after handling the changes.
+		m_analysisDeadline = std::chrono::steady_clock::now();
+		return;
 	}
 
+	// These are the source units we will sent diagnostics to the client for sure,
+	// even if it is just to clear previous diagnostics.
+	std::map<std::string, Json> diagnosticsBySourceUnit;
+	for (std::string const& sourceUnitName: m_fileRepository.sourceUnits() | ranges::views::keys)
+		diagnosticsBySourceUnit[sourceUnitName] = Json::array();
+	for (std::string const& sourceUnitName: m_nonemptyDiagnostics)
+		diagnosticsBySourceUnit[sourceUnitName] = Json::array();
+	for (auto const& [sourceUnitName, diagnostics]: m_diagnosticsBySourceUnit)
+		diagnosticsBySourceUnit[sourceUnitName] = diagnostics;
+
 	if (m_client.traceValue() != TraceValue::Off)
 	{
 		Json extra;
 		extra["openFileCount"] = Json(diagnosticsBySourceUnit.size());
+		extra["analyzedFiles"] = Json::array();
+		for (std::string const& sourceUnitName: m_sourceUnitsAnalyzedSincePublishing)
+			extra["analyzedFiles"].emplace_back(m_fileRepository.sourceUnitNameToUri(sourceUnitName));
 		m_client.trace("Number of currently open files: " + std::to_string(diagnosticsBySourceUnit.size()), extra);
 	}
 
+	m_sourceUnitsAnalyzedSincePublishing.clear();
 	m_nonemptyDiagnostics.clear();
 	for (auto&& [sourceUnitName, diagnostics]: diagnosticsBySourceUnit)
 	{
@@ -331,7 +497,10 @@ void LanguageServer::compileAndUpdateDiagnostics()
 
 bool LanguageServer::run()
 {
-	while (m_state != State::ExitRequested && m_state != State::ExitWithoutShutdown && !m_client.closed())
+	std::thread worker(&LanguageServer::processMessages, this);
+
+	bool exitReceived = false;
+	while (!exitReceived && !m_client.closed())
 	{
 		MessageID id;
 		try
@@ -347,10 +516,16 @@ bool LanguageServer::run()
 					id = (*jsonMessage)["id"];
 				lspDebug(fmt::format("received method call: {}", methodName));
 
-				if (auto handler = util::valueOrDefault(m_handlers, methodName))
-					handler(id, (*jsonMessage)["params"]);
+				if (methodName == "$/cancelRequest" || methodName == "cancelRequest")
+					// Handled right away, as the cancelled request is likely still queued.
+					cancelRequest((*jsonMessage)["params"]);
 				else
-					m_client.error(id, ErrorCode::MethodNotFound, "Unknown method " + methodName);
+				{
+					exitReceived = methodName == "exit";
+					std::lock_guard lock(m_messageQueueMutex);
+					m_messageQueue.push_back({id, methodName, (*jsonMessage)["params"]});
+					m_messageQueueChanged.notify_all();
+				}
 			}
 			else
 				m_client.error({}, ErrorCode::ParseError, "\"method\" has to be a string.");
@@ -368,9 +543,166 @@ bool LanguageServer::run()
 			m_client.error(id, ErrorCode::InternalError, "Unhandled exception: "s + boost::current_exception_diagnostic_information());
 		}
 	}
+
+	{
+		std::lock_guard lock(m_messageQueueMutex);
+		m_receivingStopped = true;
+		m_messageQueueChanged.notify_all();
+	}
+	worker.join();
+
 	return m_state == State::ExitRequested;
 }
 
+void LanguageServer::processMessages()
+{
+	while (true)
+	{
+		std::unique_lock lock(m_messageQueueMutex);
+		auto const messageAvailable = [&]() { return m_receivingStopped || !m_messageQueue.empty(); };
+		if (m_analysisDeadline)
+			m_messageQueueChanged.wait_until(lock, *m_analysisDeadline, messageAvailable);
+		else
+			m_messageQueueChanged.wait(lock, messageAvailable);
+
+		// Further changes are handled before analyzing, while any other message may depend on the
+		// analysis of the changes received earlier. Requests about a source unit none of the changes
+		// affect are answered from the last analysis right away.
+		bool const analysisDue =
+			m_analysisDeadline &&
+			(m_messageQueue.empty() ?
+				std::chrono::steady_clock::now() >= *m_analysisDeadline :
+				!changesSources(m_messageQueue.front().methodName) &&
+				!answerableFromLastAnalysis(m_messageQueue.front().methodName, m_messageQueue.front().params)
+			);
+		if (analysisDue)
+		{
+			lock.unlock();
+			try
+			{
+				compileAndUpdateDiagnostics();
+			}
+			catch (...)
+			{
+				m_client.error({}, ErrorCode::InternalError, "Unhandled exception: "s + boost::current_exception_diagnostic_information());
+			}
+		}
+		else if (!m_messageQueue.empty())
+		{
+			QueuedMessage message = std::move(m_messageQueue.front());
+			m_messageQueue.pop_front();
+			m_currentRequestId = message.id;
+			m_currentRequestCancelled = false;
+			lock.unlock();
+			handleMessage(message.id, message.methodName, message.params);
+			lock.lock();
+			m_currentRequestId = MessageID{};
+			m_currentRequestCancelled = false;
+		}
+		else if (m_receivingStopped)
+			return;
+	}
+}
+
+void LanguageServer::handleMessage(MessageID const& _id, std::string const& _methodName, Json const& _params)
+{
+	try
+	{
+		if (auto handler = util::valueOrDefault(m_handlers, _methodName))
+			handler(_id, _params);
+		else
+			m_client.error(_id, ErrorCode::MethodNotFound, "Unknown method " + _methodName);
+	}
+	catch (Json::exception const&)
+	{
+		m_client.error(_id, ErrorCode::InvalidParams, "JSON object access error. Most likely due to a badly formatted JSON request message."s);
+	}
+	catch (RequestError const& error)
+	{
+		m_client.error(_id, error.code(), error.comment() ? *error.comment() : ""s);
+	}
+	catch (...)
+	{
+		m_client.error(_id, ErrorCode::InternalError, "Unhandled exception: "s + boost::current_exception_diagnostic_information());
+	}
+}
+
+void LanguageServer::cancelRequest(Json const& _args)
+{
+	lspRequire(
+		_args.contains("id") && !_args["id"].is_null(),
+		ErrorCode::InvalidParams,
+		"Request ID missing."
+	);
+
+	MessageID const& id = _args["id"];
+	{
+		std::lock_guard lock(m_messageQueueMutex);
+		auto message = std::find_if(
+			m_messageQueue.begin(),
+			m_messageQueue.end(),
+			[&](QueuedMessage const& _message) { return _message.id == id; }
+		);
+		if (message == m_messageQueue.end())
+		{
+			// The handler of a request in progress stops at the next opportunity and reports the
+			// cancellation itself. Requests that were handled already or are unknown are ignored.
+			if (m_currentRequestId == id)
+				m_currentRequestCancelled = true;
+			return;
+		}
+		m_messageQueue.erase(message);
+	}
+	m_client.error(id, ErrorCode::RequestCancelled, "Request cancelled.");
+}
+
+bool LanguageServer::sourceChangeNext()
+{
+	std::lock_guard lock(m_messageQueueMutex);
+	return !m_messageQueue.empty() && changesSources(m_messageQueue.front().methodName);
+}
+
+bool LanguageServer::currentRequestCancelled()
+{
+	std::lock_guard lock(m_messageQueueMutex);
+	return m_currentRequestCancelled;
+}
+
+bool LanguageServer::answerableFromLastAnalysis(std::string const& _methodName, Json const& _params) const
+{
+	if (
+		!answeredFromAnalysis(_methodName) ||
+		!_params.contains("textDocument") ||
+		!_params["textDocument"].contains("uri") ||
+		!_params["textDocument"]["uri"].is_string() ||
+		m_compilerStack.state() < CompilerStack::AnalysisSuccessful
+	)
+		return false;
+
+	// The analysis of a source unit is still valid if neither the unit nor anything it (transitively)
+	// imports changed since.
+	StringMap const& sourceUnits = m_fileRepository.sourceUnits();
+	std::vector<std::string> const analyzedSourceUnits = m_compilerStack.sourceNames();
+	std::set<std::string> visited;
+	std::vector<std::string> worklist{m_fileRepository.uriToSourceUnitName(_params["textDocument"]["uri"].get<std::string>())};
+	while (!worklist.empty())
+	{
+		std::string const sourceUnitName = std::move(worklist.back());
+		worklist.pop_back();
+		if (!visited.insert(sourceUnitName).second)
+			continue;
+		if (
+			!util::contains(analyzedSourceUnits, sourceUnitName) ||
+			!sourceUnits.count(sourceUnitName) ||
+			sourceUnits.at(sourceUnitName) != m_compilerStack.charStream(sourceUnitName).source()
+		)
+			return false;
+		if (auto imports = m_sourceUnitImports.find(sourceUnitName); imports != m_sourceUnitImports.end())
+			worklist.insert(worklist.end(), imports->second.begin(), imports->second.end());
+	}
+	return true;
+}
+
 void LanguageServer::requireServerInitialized()
 {
 	lspRequire(
@@ -410,6 +742,7 @@ void LanguageServer::handleInitialize(MessageID _id, Json const& _args)
 		setTrace(_args["trace"]);
 
 	m_fileRepository = FileRepository(rootPath, {});
+	m_rootSourceUnits.reset();
 	if (_args.contains("initializationOptions") && _args["initializationOptions"].is_object())
 		changeConfiguration(_args["initializationOptions"]);
 
@@ -440,10 +773,10 @@ void LanguageServer::semanticTokensFull(MessageID _id, Json const& _args)
 	if (_args.contains("textDocument") && _args["textDocument"].contains("uri"))
 	{
 		auto uri = _args["textDocument"]["uri"];
+		auto const sourceName = m_fileRepository.uriToSourceUnitName(uri.get<std::string>());
 
-		compile();
+		compile({sourceName});
 
-		auto const sourceName = m_fileRepository.uriToSourceUnitName(uri.get<std::string>());
 		SourceUnit const& ast = m_compilerStack.ast(sourceName);
 		m_compilerStack.charStream(sourceName);
 		Json data = SemanticTokensBuilder().build(ast, m_compilerStack.charStream(sourceName));
@@ -543,7 +876,8 @@ void LanguageServer::handleTextDocumentDidChange(Json const& _args)
 				}
 			}
 
-		compileAndUpdateDiagnostics();
+		// Rapid edits are analyzed together once the client pauses.
+		m_analysisDeadline = std::chrono::steady_clock::now() + analysisDebounceDelay;
 	}
 }
 
@@ -573,10 +907,11 @@ ASTNode const* LanguageServer::astNodeAtSourceLocation(std::string const& _sourc
 
 std::tuple<ASTNode const*, int> LanguageServer::astNodeAndOffsetAtSourceLocation(std::string const& _sourceUnitName, LineColumn const& _filePos)
 {
-	if (m_compilerStack.state() < CompilerStack::AnalysisSuccessful)
-		return {nullptr, -1};
 	if (!m_fileRepository.sourceUnits().count(_sourceUnitName))
 		return {nullptr, -1};
+	requireAnalyzed({_sourceUnitName});
+	if (m_compilerStack.state() < CompilerStack::AnalysisSuccessful)
+		return {nullptr, -1};
 
 	std::optional<int> sourcePos = m_compilerStack.charStream(_sourceUnitName).translateLineColumnToPosition(_filePos);
 	if (!sourcePos)
@@ -22,11 +22,17 @@
 #include <libsolidity/interface/CompilerStack.h>
 #include <libsolidity/interface/FileReader.h>
 
+#include <libsolutil/FixedHash.h>
 #include <libsolutil/JSON.h>
 
+#include <chrono>
+#include <condition_variable>
+#include <deque>
 #include <functional>
 #include <map>
+#include <mutex>
 #include <optional>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -57,6 +63,10 @@ enum class FileLoadStrategy
  * Solidity Language Server, managing one LSP client.
  * This implements a subset of LSP version 3.16 that can be found at:
  * https://microsoft.github.io/language-server-protocol/specifications/specification-3-16/
+ *
+ * Messages are received on the thread calling run() and handled in order on a worker thread,
+ * which also analyzes the sources in the background. Everything but the message queue and the
+ * state of the request in progress is only accessed from the worker thread.
  */
 class LanguageServer
 {
@@ -65,6 +75,7 @@ public:
 	explicit LanguageServer(Transport& _transport);
 
 	/// Re-compiles the project and updates the diagnostics pushed to the client.
+	/// Stops early without publishing anything if the client changed the sources in the meantime.
 	void compileAndUpdateDiagnostics();
 
 	/// Loops over incoming messages via the transport layer until shutdown condition is met.
@@ -81,6 +92,10 @@ public:
 	frontend::ASTNode const* astNodeAtSourceLocation(std::string const& _sourceUnitName, langutil::LineColumn const& _filePos);
 	frontend::CompilerStack const& compilerStack() const noexcept { return m_compilerStack; }
 
+	/// Makes sure that the ASTs of the given source units are available via compilerStack(),
+	/// re-analyzing them (and all outdated source units) if needed.
+	void requireAnalyzed(std::set<std::string> const& _sourceUnitNames);
+
 private:
 	/// Checks if the server is initialized (to be used by messages that need it to be initialized).
 	/// Reports an error and returns false if not.
@@ -99,11 +114,37 @@ private:
 	/// Invoked when the server user-supplied configuration changes (initiated by the client).
 	void changeConfiguration(Json const&);
 
-	/// Compile everything until after analysis phase.
-	void compile();
+	/// Compiles until after the analysis phase.
+	/// Only the source units that changed since their last analysis, the source units (transitively)
+	/// importing them and the units in @a _requiredSourceUnits are parsed and analyzed again.
+	/// The diagnostics of all other source units are kept from their last analysis.
+	/// @param _abandonIfOutdated if true, skips the analysis if a change of the sources arrives during parsing.
+	void compile(std::set<std::string> const& _requiredSourceUnits = {}, bool _abandonIfOutdated = false);
+
+	/// Stores the diagnostics reported by the current compiler stack, replacing the ones of
+	/// all source units that were part of the compilation.
+	void updateDiagnosticsCache();
 
 	std::vector<boost::filesystem::path> allSolidityFilesFromProject() const;
 
+	/// Handles the queued messages and analyzes the sources after changes until no more messages
+	/// are received. Runs on the worker thread.
+	void processMessages();
+	/// Invokes the handler of a message, reporting failures to the client.
+	void handleMessage(MessageID const& _id, std::string const& _methodName, Json const& _params);
+	/// Drops the request referenced by a cancellation notification from the queue.
+	/// If its handling already started, marks it as cancelled instead, which makes the handler
+	/// stop before analyzing the sources it needs.
+	void cancelRequest(Json const& _args);
+	/// @returns true if the next message to be handled changes the sources,
+	/// which makes the result of an analysis in progress outdated.
+	bool sourceChangeNext();
+	/// @returns true if the client cancelled the request being handled.
+	bool currentRequestCancelled();
+	/// @returns true if the given message is a request about a single source unit whose analysis
+	/// held by the compiler stack is unaffected by the changes received since.
+	bool answerableFromLastAnalysis(std::string const& _methodName, Json const& _params) const;
+
 	using MessageHandler = std::function<void(MessageID, Json const&)>;
 
 	Json toRange(langutil::SourceLocation const& _location);
@@ -126,6 +167,39 @@ private:
 
 	frontend::CompilerStack m_compilerStack;
 
+	/// Source unit names that were explicitly passed to the compiler on the last compilation,
+	/// i.e. the open files and, depending on the file load strategy, the project files.
+	/// A change of this set causes the whole project to be analyzed again.
+	std::optional<std::set<std::string>> m_rootSourceUnits;
+	/// Hashes of the contents of all source units at the time of their last analysis.
+	/// A zero hash marks a source unit that could not be fully analyzed and has to be analyzed again.
+	std::map<std::string, util::h256> m_analyzedSourceHashes;
+	/// Source units directly imported by each analyzed source unit.
+	std::map<std::string, std::set<std::string>> m_sourceUnitImports;
+	/// Diagnostics of the last analysis of each source unit.
+	std::map<std::string, Json> m_diagnosticsBySourceUnit;
+	/// Source units analyzed since the diagnostics were last published, reported to the client in the trace.
+	std::set<std::string> m_sourceUnitsAnalyzedSincePublishing;
+	/// Point in time at which the sources are analyzed again after a change, unless another change arrives earlier.
+	std::optional<std::chrono::steady_clock::time_point> m_analysisDeadline;
+
+	struct QueuedMessage
+	{
+		MessageID id;
+		std::string methodName;
+		Json params;
+	};
+	/// Received messages waiting to be handled by the worker thread.
+	std::deque<QueuedMessage> m_messageQueue;
+	/// Set once no more messages will be queued. The worker thread stops after handling the remaining ones.
+	bool m_receivingStopped = false;
+	/// ID of the request being handled by the worker thread, null if there is none.
+	MessageID m_currentRequestId;
+	/// Set if the client cancelled the request being handled.
+	bool m_currentRequestCancelled = false;
+	std::mutex m_messageQueueMutex;
+	std::condition_variable m_messageQueueChanged;
+
 	/// User-supplied custom configuration settings (such as EVM version).
 	Json m_settingsObject;
 };
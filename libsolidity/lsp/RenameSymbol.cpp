@@ -22,7 +22,11 @@
 
 #include <fmt/format.h>
 
+#include <range/v3/range/conversion.hpp>
+#include <range/v3/view/map.hpp>
+
 #include <memory>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -53,6 +57,9 @@ void RenameSymbol::operator()(MessageID _id, Json const& _args)
 	std::string const newName = _args["newName"].get<std::string>();
 	std::string const uri = _args["textDocument"]["uri"].get<std::string>();
 
+	// References can be in any source unit.
+	m_server.requireAnalyzed(fileRepository().sourceUnits() | ranges::views::keys | ranges::to<std::set<std::string>>);
+
 	ASTNode const* sourceNode = m_server.astNodeAtSourceLocation(sourceUnitName, lineColumn);
 
 	m_symbolName = {};
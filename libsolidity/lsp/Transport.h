@@ -23,6 +23,7 @@
 #include <functional>
 #include <iosfwd>
 #include <map>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -50,7 +51,8 @@ enum class ErrorCode
 
 	// Defined by the protocol.
 	ServerNotInitialized = -32002,
-	RequestFailed = -32803
+	RequestFailed = -32803,
+	RequestCancelled = -32800
 };
 
 /**
@@ -91,6 +93,8 @@ private:
  *
  * The transport layer API is abstracted to make LSP more testable as well as
  * this way it could be possible to support other transports (HTTP for example) easily.
+ *
+ * Messages may be sent from multiple threads concurrently, while receiving is limited to a single thread.
  */
 class Transport
 {
@@ -111,6 +115,8 @@ public:
 
 private:
 	TraceValue m_logTrace = TraceValue::Off;
+	/// Keeps messages sent from different threads from interleaving.
+	std::mutex m_sendMutex;
 
 protected:
 	/// Reads from the transport and parses the headers until the beginning
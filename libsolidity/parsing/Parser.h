@@ -52,6 +52,13 @@ public:
 
 	/// Returns the maximal AST node ID assigned so far
 	int64_t maxID() const { return m_currentNodeID; }
+	/// Continues assigning node IDs after @a _maxID, as if the nodes up to that ID had been
+	/// created by this parser. Used when a source unit parsed earlier is reused.
+	void skipIDs(int64_t _maxID)
+	{
+		solAssert(_maxID >= m_currentNodeID);
+		m_currentNodeID = _maxID;
+	}
 private:
 	class ASTNodeFactory;
 
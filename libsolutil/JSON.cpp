@@ -26,6 +26,7 @@
 
 #include <boost/algorithm/string.hpp>
 
+#include <algorithm>
 #include <sstream>
 
 namespace solidity::util
@@ -122,6 +123,61 @@ std::string removeNlohmannInternalErrorIdentifier(std::string const& _input)
 	return boost::trim_copy(result);
 }
 
+bool JsonObjectStreamWriter::accepts(std::vector<std::string> const& _path) const
+{
+	if (m_finished || _path.empty())
+		return false;
+	if (m_lastPath.empty())
+		return true;
+	auto [lastIt, pathIt] = std::mismatch(m_lastPath.begin(), m_lastPath.end(), _path.begin(), _path.end());
+	// The paths must differ before either of them ends.
+	return lastIt != m_lastPath.end() && pathIt != _path.end() && *lastIt < *pathIt;
+}
+
+void JsonObjectStreamWriter::write(std::vector<std::string> const& _path, Json const& _value)
+{
+	assertThrow(accepts(_path), BadJsonStreamOrder, "JSON members written out of order.");
+	// Serialise first, so that nothing is written if serialisation fails.
+	std::string value = jsonCompactPrint(_value);
+
+	// Number of objects on the path of the previous member that are also on the new path.
+	size_t common = 0;
+	if (!m_started)
+	{
+		m_output << '{';
+		m_started = true;
+	}
+	else
+	{
+		while (common + 1 < m_lastPath.size() && m_lastPath[common] == _path[common])
+			++common;
+		for (size_t i = common + 1; i < m_lastPath.size(); ++i)
+			m_output << '}';
+		m_output << ',';
+	}
+
+	for (size_t i = common; i < _path.size(); ++i)
+	{
+		m_output << jsonCompactPrint(Json(_path[i])) << ':';
+		if (i + 1 < _path.size())
+			m_output << '{';
+	}
+	m_output << value;
+	m_lastPath = _path;
+}
+
+void JsonObjectStreamWriter::finish()
+{
+	assertThrow(!m_finished, BadJsonStreamOrder, "JSON stream already finished.");
+	if (!m_started)
+		m_output << '{';
+	for (size_t i = 1; i < m_lastPath.size(); ++i)
+		m_output << '}';
+	m_output << '}';
+	m_started = true;
+	m_finished = true;
+}
+
 std::string jsonPrettyPrint(Json const& _input) { return jsonPrint(_input, JsonFormat{JsonFormat::Pretty}); }
 
 std::string jsonCompactPrint(Json const& _input) { return jsonPrint(_input, JsonFormat{JsonFormat::Compact}); }
@@ -24,12 +24,15 @@
 #pragma once
 
 #include <libsolutil/Assertions.h>
+#include <libsolutil/Exceptions.h>
 #include <nlohmann/json.hpp>
 
+#include <ostream>
 #include <string>
 #include <string_view>
 #include <optional>
 #include <limits>
+#include <vector>
 
 namespace solidity
 {
@@ -71,6 +74,37 @@ std::string jsonCompactPrint(Json const& _input);
 /// Serialise the JSON object (@a _input) using specified format (@a _format)
 std::string jsonPrint(Json const& _input, JsonFormat const& _format);
 
+DEV_SIMPLE_EXCEPTION(BadJsonStreamOrder);
+
+/// Serialises a JSON object to a stream member by member, so that the whole object never has to
+/// be held in memory. Members are addressed by the keys leading to them from the top level object
+/// and have to be written in ascending order of these paths. This is also the order used by
+/// nlohmann::json, so the output is identical to jsonCompactPrint() of the equivalent Json object.
+class JsonObjectStreamWriter
+{
+public:
+	explicit JsonObjectStreamWriter(std::ostream& _output): m_output(_output) {}
+
+	/// @returns true if a member can be written at @a _path, i.e. if the path is greater than the
+	/// one of the previously written member and neither of them is a prefix of the other.
+	bool accepts(std::vector<std::string> const& _path) const;
+	/// Writes @a _value as the member at @a _path, opening the enclosing objects as needed.
+	/// Throws BadJsonStreamOrder if the path is not accepted.
+	void write(std::vector<std::string> const& _path, Json const& _value);
+	/// Closes all open objects. Nothing can be written afterwards.
+	void finish();
+
+	/// @returns true if any part of the output has been written.
+	bool started() const { return m_started; }
+
+private:
+	std::ostream& m_output;
+	/// Path of the previously written member.
+	std::vector<std::string> m_lastPath;
+	bool m_started = false;
+	bool m_finished = false;
+};
+
 /// Parse a JSON string (@a _input) with enabled strict-mode and writes resulting JSON object to (@a _json)
 /// \param _input JSON input string
 /// \param _json [out] resulting JSON object
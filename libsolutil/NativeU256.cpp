@@ -0,0 +1,313 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolutil/NativeU256.h>
+
+#include <liblangutil/Exceptions.h>
+
+using namespace solidity;
+using namespace solidity::util;
+
+namespace
+{
+
+/// Maximum number of 32-bit digits of a dividend, i.e. of the 512-bit product in mulmod.
+size_t constexpr maxDigits = 16;
+
+unsigned countLeadingZeros(uint32_t _value)
+{
+	unsigned count = 0;
+	for (uint32_t mask = 0x80000000; (_value & mask) == 0; mask >>= 1)
+		++count;
+	return count;
+}
+
+/// Divides the @a _m digit number @a _u by the @a _n digit number @a _v using Knuth's algorithm D
+/// (The Art of Computer Programming, Vol. 2, 4.3.1) on little-endian 32-bit digits. Requires
+/// _m >= _n >= 1 and the most significant digit of @a _v to be non-zero. Stores the _m - _n + 1
+/// digits of the quotient in @a o_quotient and the @a _n digits of the remainder in @a o_remainder.
+void knuthDivide(
+	uint32_t const* _u,
+	size_t _m,
+	uint32_t const* _v,
+	size_t _n,
+	uint32_t* o_quotient,
+	uint32_t* o_remainder
+)
+{
+	uint64_t constexpr base = uint64_t(1) << 32;
+	if (_n == 1)
+	{
+		uint64_t remainder = 0;
+		for (size_t j = _m; j-- > 0;)
+		{
+			uint64_t current = (remainder << 32) | _u[j];
+			o_quotient[j] = uint32_t(current / _v[0]);
+			remainder = current % _v[0];
+		}
+		o_remainder[0] = uint32_t(remainder);
+		return;
+	}
+
+	// Normalize such that the most significant bit of the divisor is set. Shifting a zero-extended
+	// digit right by 32 yields zero, so no special case is needed for a shift of zero.
+	unsigned shift = countLeadingZeros(_v[_n - 1]);
+	std::array<uint32_t, maxDigits> vn{};
+	std::array<uint32_t, maxDigits + 1> un{};
+	for (size_t i = _n - 1; i > 0; --i)
+		vn[i] = uint32_t((uint64_t(_v[i]) << shift) | (uint64_t(_v[i - 1]) >> (32 - shift)));
+	vn[0] = uint32_t(uint64_t(_v[0]) << shift);
+	un[_m] = uint32_t(uint64_t(_u[_m - 1]) >> (32 - shift));
+	for (size_t i = _m - 1; i > 0; --i)
+		un[i] = uint32_t((uint64_t(_u[i]) << shift) | (uint64_t(_u[i - 1]) >> (32 - shift)));
+	un[0] = uint32_t(uint64_t(_u[0]) << shift);
+
+	for (size_t j = _m - _n + 1; j-- > 0;)
+	{
+		// Estimate the quotient digit, which is then at most one too large.
+		uint64_t numerator = (uint64_t(un[j + _n]) << 32) | un[j + _n - 1];
+		uint64_t qhat = numerator / vn[_n - 1];
+		uint64_t rhat = numerator % vn[_n - 1];
+		while (qhat >= base || qhat * vn[_n - 2] > ((rhat << 32) | un[j + _n - 2]))
+		{
+			--qhat;
+			rhat += vn[_n - 1];
+			if (rhat >= base)
+				break;
+		}
+
+		// Multiply and subtract.
+		int64_t borrow = 0;
+		int64_t difference = 0;
+		for (size_t i = 0; i < _n; ++i)
+		{
+			uint64_t product = qhat * vn[i];
+			difference = int64_t(un[i + j]) - borrow - int64_t(product & 0xffffffff);
+			un[i + j] = uint32_t(difference);
+			borrow = int64_t(product >> 32) - (difference >> 32);
+		}
+		difference = int64_t(un[j + _n]) - borrow;
+		un[j + _n] = uint32_t(difference);
+
+		o_quotient[j] = uint32_t(qhat);
+		if (difference < 0)
+		{
+			// The estimate was one too large, add the divisor back.
+			--o_quotient[j];
+			uint64_t carry = 0;
+			for (size_t i = 0; i < _n; ++i)
+			{
+				uint64_t sum = uint64_t(un[i + j]) + vn[i] + carry;
+				un[i + j] = uint32_t(sum);
+				carry = sum >> 32;
+			}
+			un[j + _n] = uint32_t(un[j + _n] + carry);
+		}
+	}
+
+	for (size_t i = 0; i + 1 < _n; ++i)
+		o_remainder[i] = uint32_t((uint64_t(un[i]) >> shift) | (uint64_t(un[i + 1]) << (32 - shift)));
+	o_remainder[_n - 1] = un[_n - 1] >> shift;
+}
+
+template <size_t N>
+std::array<uint32_t, 2 * N> toDigits(std::array<uint64_t, N> const& _limbs)
+{
+	std::array<uint32_t, 2 * N> digits{};
+	for (size_t i = 0; i < N; ++i)
+	{
+		digits[2 * i] = uint32_t(_limbs[i]);
+		digits[2 * i + 1] = uint32_t(_limbs[i] >> 32);
+	}
+	return digits;
+}
+
+template <size_t N>
+size_t significantDigits(std::array<uint32_t, N> const& _digits)
+{
+	size_t count = N;
+	while (count > 0 && _digits[count - 1] == 0)
+		--count;
+	return count;
+}
+
+/// Divides the little-endian limbs @a _dividend by the non-zero @a _divisor.
+/// The quotient is only computed if @a o_quotient is not null.
+template <size_t N>
+void divideLimbs(
+	std::array<uint64_t, N> const& _dividend,
+	std::array<uint64_t, 4> const& _divisor,
+	std::array<uint64_t, N>* o_quotient,
+	std::array<uint64_t, 4>& o_remainder
+)
+{
+	static_assert(2 * N <= maxDigits);
+	std::array<uint32_t, 2 * N> u = toDigits(_dividend);
+	std::array<uint32_t, 8> v = toDigits(_divisor);
+	size_t m = significantDigits(u);
+	size_t n = significantDigits(v);
+	solAssert(n > 0);
+
+	std::array<uint32_t, 2 * N> quotient{};
+	std::array<uint32_t, 8> remainder{};
+	if (m < n)
+		for (size_t i = 0; i < m; ++i)
+			remainder[i] = u[i];
+	else
+		knuthDivide(u.data(), m, v.data(), n, quotient.data(), remainder.data());
+
+	if (o_quotient)
+		for (size_t i = 0; i < N; ++i)
+			(*o_quotient)[i] = uint64_t(quotient[2 * i]) | (uint64_t(quotient[2 * i + 1]) << 32);
+	for (size_t i = 0; i < 4; ++i)
+		o_remainder[i] = uint64_t(remainder[2 * i]) | (uint64_t(remainder[2 * i + 1]) << 32);
+}
+
+NativeU256 absoluteValue(NativeU256 const& _value)
+{
+	return _value.isNegative() ? -_value : _value;
+}
+
+}
+
+NativeU256::NativeU256(u256 const& _value)
+{
+	boost::multiprecision::export_bits(_value, m_limbs.begin(), 64, false);
+}
+
+u256 NativeU256::toU256() const
+{
+	u256 result;
+	boost::multiprecision::import_bits(result, m_limbs.begin(), m_limbs.end(), 64, false);
+	return result;
+}
+
+unsigned NativeU256::bitLength() const
+{
+	for (size_t i = 4; i-- > 0;)
+		if (m_limbs[i] != 0)
+		{
+			unsigned length = unsigned(64 * i);
+			for (uint64_t limb = m_limbs[i]; limb != 0; limb >>= 1)
+				++length;
+			return length;
+		}
+	return 0;
+}
+
+void NativeU256::divMod(
+	NativeU256 const& _dividend,
+	NativeU256 const& _divisor,
+	NativeU256& o_quotient,
+	NativeU256& o_remainder
+)
+{
+	// The outputs may alias the inputs.
+	NativeU256 dividend = _dividend;
+	NativeU256 divisor = _divisor;
+	if (divisor.isZero())
+	{
+		o_quotient = o_remainder = NativeU256{};
+		return;
+	}
+	if (dividend.fitsUint64() && divisor.fitsUint64())
+	{
+		o_quotient = dividend.m_limbs[0] / divisor.m_limbs[0];
+		o_remainder = dividend.m_limbs[0] % divisor.m_limbs[0];
+		return;
+	}
+	if (dividend < divisor)
+	{
+		o_quotient = NativeU256{};
+		o_remainder = dividend;
+		return;
+	}
+	divideLimbs(dividend.m_limbs, divisor.m_limbs, &o_quotient.m_limbs, o_remainder.m_limbs);
+}
+
+NativeU256 solidity::util::sdiv(NativeU256 const& _a, NativeU256 const& _b)
+{
+	NativeU256 quotient = absoluteValue(_a) / absoluteValue(_b);
+	return _a.isNegative() != _b.isNegative() ? -quotient : quotient;
+}
+
+NativeU256 solidity::util::smod(NativeU256 const& _a, NativeU256 const& _b)
+{
+	NativeU256 remainder = absoluteValue(_a) % absoluteValue(_b);
+	return _a.isNegative() ? -remainder : remainder;
+}
+
+NativeU256 solidity::util::sar(NativeU256 const& _value, unsigned _amount)
+{
+	if (!_value.isNegative())
+		return _value >> _amount;
+	return ~(~_value >> _amount);
+}
+
+NativeU256 solidity::util::signextend(unsigned _byteIndex, NativeU256 const& _value)
+{
+	if (_byteIndex >= 31)
+		return _value;
+	unsigned signBit = _byteIndex * 8 + 7;
+	NativeU256 mask = (NativeU256(1) << (signBit + 1)) - 1;
+	return _value.bit(signBit) ? (_value | ~mask) : (_value & mask);
+}
+
+NativeU256 solidity::util::addmod(NativeU256 const& _a, NativeU256 const& _b, NativeU256 const& _modulus)
+{
+	if (_modulus.isZero())
+		return NativeU256{};
+	std::array<uint64_t, 5> sum{};
+	uint64_t carry = 0;
+	for (size_t i = 0; i < 4; ++i)
+		sum[i] = detail::addWithCarry(_a.m_limbs[i], _b.m_limbs[i], carry);
+	sum[4] = carry;
+	NativeU256 result;
+	divideLimbs<5>(sum, _modulus.m_limbs, nullptr, result.m_limbs);
+	return result;
+}
+
+NativeU256 solidity::util::mulmod(NativeU256 const& _a, NativeU256 const& _b, NativeU256 const& _modulus)
+{
+	if (_modulus.isZero())
+		return NativeU256{};
+	std::array<uint64_t, 8> product{};
+	for (size_t i = 0; i < 4; ++i)
+	{
+		uint64_t carry = 0;
+		for (size_t j = 0; j < 4; ++j)
+			product[i + j] = detail::multiplyAdd(_a.m_limbs[i], _b.m_limbs[j], product[i + j], carry);
+		product[i + 4] = carry;
+	}
+	NativeU256 result;
+	divideLimbs<8>(product, _modulus.m_limbs, nullptr, result.m_limbs);
+	return result;
+}
+
+NativeU256 solidity::util::exp(NativeU256 _base, NativeU256 const& _exponent)
+{
+	NativeU256 result = 1;
+	unsigned length = _exponent.bitLength();
+	for (unsigned i = 0; i < length; ++i)
+	{
+		if (_exponent.bit(i))
+			result *= _base;
+		_base *= _base;
+	}
+	return result;
+}
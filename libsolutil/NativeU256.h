@@ -0,0 +1,313 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Allocation-free 256-bit integer with EVM semantics.
+ */
+
+#pragma once
+
+#include <libsolutil/Numeric.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace solidity::util
+{
+
+/**
+ * Unsigned 256-bit integer stored in four 64-bit limbs (least significant first).
+ *
+ * All operations wrap around modulo 2**256 and follow the semantics of the corresponding EVM
+ * opcodes, in particular division and modulo by zero result in zero. Signed operations interpret
+ * the value in two's complement. In contrast to u256, no operation allocates or goes through
+ * bigint, which makes this type suitable for hot paths like constant folding.
+ */
+class NativeU256
+{
+public:
+	NativeU256() = default;
+	constexpr NativeU256(uint64_t _value): m_limbs{{_value, 0, 0, 0}} {}
+	explicit NativeU256(u256 const& _value);
+
+	u256 toU256() const;
+
+	uint64_t limb(size_t _index) const { return m_limbs[_index]; }
+	bool isZero() const { return (m_limbs[0] | m_limbs[1] | m_limbs[2] | m_limbs[3]) == 0; }
+	/// @returns true if the most significant bit is set, i.e. the value is negative in two's complement.
+	bool isNegative() const { return (m_limbs[3] >> 63) != 0; }
+	bool bit(unsigned _index) const { return _index < 256 && ((m_limbs[_index / 64] >> (_index % 64)) & 1) != 0; }
+	/// @returns the number of significant bits, i.e. zero for zero and 256 if the most significant bit is set.
+	unsigned bitLength() const;
+	/// @returns true if the value fits into 64 bits.
+	bool fitsUint64() const { return (m_limbs[1] | m_limbs[2] | m_limbs[3]) == 0; }
+
+	NativeU256& operator+=(NativeU256 const& _other);
+	NativeU256& operator-=(NativeU256 const& _other);
+	NativeU256& operator*=(NativeU256 const& _other);
+	NativeU256& operator/=(NativeU256 const& _other);
+	NativeU256& operator%=(NativeU256 const& _other);
+	NativeU256& operator&=(NativeU256 const& _other);
+	NativeU256& operator|=(NativeU256 const& _other);
+	NativeU256& operator^=(NativeU256 const& _other);
+	/// Shifts by at least 256 bits result in zero.
+	NativeU256& operator<<=(unsigned _amount);
+	NativeU256& operator>>=(unsigned _amount);
+
+	NativeU256 operator~() const;
+	NativeU256 operator-() const { return NativeU256{} - *this; }
+
+	friend NativeU256 operator+(NativeU256 _a, NativeU256 const& _b) { return _a += _b; }
+	friend NativeU256 operator-(NativeU256 _a, NativeU256 const& _b) { return _a -= _b; }
+	friend NativeU256 operator*(NativeU256 _a, NativeU256 const& _b) { return _a *= _b; }
+	friend NativeU256 operator/(NativeU256 _a, NativeU256 const& _b) { return _a /= _b; }
+	friend NativeU256 operator%(NativeU256 _a, NativeU256 const& _b) { return _a %= _b; }
+	friend NativeU256 operator&(NativeU256 _a, NativeU256 const& _b) { return _a &= _b; }
+	friend NativeU256 operator|(NativeU256 _a, NativeU256 const& _b) { return _a |= _b; }
+	friend NativeU256 operator^(NativeU256 _a, NativeU256 const& _b) { return _a ^= _b; }
+	friend NativeU256 operator<<(NativeU256 _a, unsigned _amount) { return _a <<= _amount; }
+	friend NativeU256 operator>>(NativeU256 _a, unsigned _amount) { return _a >>= _amount; }
+
+	friend bool operator==(NativeU256 const& _a, NativeU256 const& _b) { return _a.m_limbs == _b.m_limbs; }
+	friend bool operator!=(NativeU256 const& _a, NativeU256 const& _b) { return _a.m_limbs != _b.m_limbs; }
+	friend bool operator<(NativeU256 const& _a, NativeU256 const& _b);
+	friend bool operator>(NativeU256 const& _a, NativeU256 const& _b) { return _b < _a; }
+	friend bool operator<=(NativeU256 const& _a, NativeU256 const& _b) { return !(_b < _a); }
+	friend bool operator>=(NativeU256 const& _a, NativeU256 const& _b) { return !(_a < _b); }
+
+	/// Computes quotient and remainder of the division of @a _dividend by @a _divisor.
+	/// Both are zero if @a _divisor is zero.
+	static void divMod(
+		NativeU256 const& _dividend,
+		NativeU256 const& _divisor,
+		NativeU256& o_quotient,
+		NativeU256& o_remainder
+	);
+
+private:
+	friend NativeU256 addmod(NativeU256 const&, NativeU256 const&, NativeU256 const&);
+	friend NativeU256 mulmod(NativeU256 const&, NativeU256 const&, NativeU256 const&);
+
+	std::array<uint64_t, 4> m_limbs{};
+};
+
+/// Signed division rounding towards zero, zero if @a _b is zero.
+NativeU256 sdiv(NativeU256 const& _a, NativeU256 const& _b);
+/// Signed modulo, the sign of the result is the sign of @a _a. Zero if @a _b is zero.
+NativeU256 smod(NativeU256 const& _a, NativeU256 const& _b);
+bool slt(NativeU256 const& _a, NativeU256 const& _b);
+bool sgt(NativeU256 const& _a, NativeU256 const& _b);
+/// Arithmetic right shift.
+NativeU256 sar(NativeU256 const& _value, unsigned _amount);
+/// Extends the sign of the two's complement number of @a _byteIndex + 1 bytes in @a _value.
+NativeU256 signextend(unsigned _byteIndex, NativeU256 const& _value);
+/// (_a + _b) % _modulus without intermediate truncation, zero if @a _modulus is zero.
+NativeU256 addmod(NativeU256 const& _a, NativeU256 const& _b, NativeU256 const& _modulus);
+/// (_a * _b) % _modulus without intermediate truncation, zero if @a _modulus is zero.
+NativeU256 mulmod(NativeU256 const& _a, NativeU256 const& _b, NativeU256 const& _modulus);
+/// _base ** _exponent modulo 2**256.
+NativeU256 exp(NativeU256 _base, NativeU256 const& _exponent);
+
+namespace detail
+{
+
+#if defined(__SIZEOF_INT128__)
+__extension__ using NativeUint128 = unsigned __int128;
+#endif
+
+/// @returns _a + _b + _carry and sets _carry to the carry out.
+inline uint64_t addWithCarry(uint64_t _a, uint64_t _b, uint64_t& _carry)
+{
+	uint64_t sum = _a + _b;
+	uint64_t carry = sum < _a ? 1 : 0;
+	sum += _carry;
+	carry += sum < _carry ? 1 : 0;
+	_carry = carry;
+	return sum;
+}
+
+/// @returns _a - _b - _borrow and sets _borrow to the borrow out.
+inline uint64_t subtractWithBorrow(uint64_t _a, uint64_t _b, uint64_t& _borrow)
+{
+	uint64_t difference = _a - _b;
+	uint64_t borrow = _a < _b ? 1 : 0;
+	borrow += difference < _borrow ? 1 : 0;
+	difference -= _borrow;
+	_borrow = borrow;
+	return difference;
+}
+
+/// @returns the low 64 bits of _a * _b + _addend + _carry and sets _carry to the high 64 bits.
+/// The result cannot overflow 128 bits.
+inline uint64_t multiplyAdd(uint64_t _a, uint64_t _b, uint64_t _addend, uint64_t& _carry)
+{
+#if defined(__SIZEOF_INT128__)
+	NativeUint128 product = NativeUint128(_a) * _b + _addend + _carry;
+	_carry = uint64_t(product >> 64);
+	return uint64_t(product);
+#else
+	uint64_t const mask = 0xffffffff;
+	uint64_t aLow = _a & mask;
+	uint64_t aHigh = _a >> 32;
+	uint64_t bLow = _b & mask;
+	uint64_t bHigh = _b >> 32;
+	uint64_t lowLow = aLow * bLow;
+	uint64_t highLow = aHigh * bLow;
+	uint64_t lowHigh = aLow * bHigh;
+	uint64_t highHigh = aHigh * bHigh;
+	uint64_t middle = (lowLow >> 32) + (highLow & mask) + lowHigh;
+	uint64_t low = (middle << 32) | (lowLow & mask);
+	uint64_t high = highHigh + (highLow >> 32) + (middle >> 32);
+	uint64_t carry = 0;
+	low = addWithCarry(low, _addend, carry);
+	high += carry;
+	carry = 0;
+	low = addWithCarry(low, _carry, carry);
+	high += carry;
+	_carry = high;
+	return low;
+#endif
+}
+
+}
+
+inline NativeU256& NativeU256::operator+=(NativeU256 const& _other)
+{
+	uint64_t carry = 0;
+	for (size_t i = 0; i < 4; ++i)
+		m_limbs[i] = detail::addWithCarry(m_limbs[i], _other.m_limbs[i], carry);
+	return *this;
+}
+
+inline NativeU256& NativeU256::operator-=(NativeU256 const& _other)
+{
+	uint64_t borrow = 0;
+	for (size_t i = 0; i < 4; ++i)
+		m_limbs[i] = detail::subtractWithBorrow(m_limbs[i], _other.m_limbs[i], borrow);
+	return *this;
+}
+
+inline NativeU256& NativeU256::operator*=(NativeU256 const& _other)
+{
+	std::array<uint64_t, 4> result{};
+	for (size_t i = 0; i < 4; ++i)
+	{
+		uint64_t carry = 0;
+		for (size_t j = 0; i + j < 4; ++j)
+			result[i + j] = detail::multiplyAdd(m_limbs[i], _other.m_limbs[j], result[i + j], carry);
+	}
+	m_limbs = result;
+	return *this;
+}
+
+inline NativeU256& NativeU256::operator/=(NativeU256 const& _other)
+{
+	NativeU256 remainder;
+	divMod(*this, _other, *this, remainder);
+	return *this;
+}
+
+inline NativeU256& NativeU256::operator%=(NativeU256 const& _other)
+{
+	NativeU256 quotient;
+	divMod(*this, _other, quotient, *this);
+	return *this;
+}
+
+inline NativeU256& NativeU256::operator&=(NativeU256 const& _other)
+{
+	for (size_t i = 0; i < 4; ++i)
+		m_limbs[i] &= _other.m_limbs[i];
+	return *this;
+}
+
+inline NativeU256& NativeU256::operator|=(NativeU256 const& _other)
+{
+	for (size_t i = 0; i < 4; ++i)
+		m_limbs[i] |= _other.m_limbs[i];
+	return *this;
+}
+
+inline NativeU256& NativeU256::operator^=(NativeU256 const& _other)
+{
+	for (size_t i = 0; i < 4; ++i)
+		m_limbs[i] ^= _other.m_limbs[i];
+	return *this;
+}
+
+inline NativeU256& NativeU256::operator<<=(unsigned _amount)
+{
+	if (_amount >= 256)
+		return *this = NativeU256{};
+	size_t limbShift = _amount / 64;
+	unsigned bitShift = _amount % 64;
+	for (size_t i = 4; i-- > 0;)
+	{
+		uint64_t value = i >= limbShift ? m_limbs[i - limbShift] << bitShift : 0;
+		if (bitShift != 0 && i > limbShift)
+			value |= m_limbs[i - limbShift - 1] >> (64 - bitShift);
+		m_limbs[i] = value;
+	}
+	return *this;
+}
+
+inline NativeU256& NativeU256::operator>>=(unsigned _amount)
+{
+	if (_amount >= 256)
+		return *this = NativeU256{};
+	size_t limbShift = _amount / 64;
+	unsigned bitShift = _amount % 64;
+	for (size_t i = 0; i < 4; ++i)
+	{
+		uint64_t value = i + limbShift < 4 ? m_limbs[i + limbShift] >> bitShift : 0;
+		if (bitShift != 0 && i + limbShift + 1 < 4)
+			value |= m_limbs[i + limbShift + 1] << (64 - bitShift);
+		m_limbs[i] = value;
+	}
+	return *this;
+}
+
+inline NativeU256 NativeU256::operator~() const
+{
+	NativeU256 result;
+	for (size_t i = 0; i < 4; ++i)
+		result.m_limbs[i] = ~m_limbs[i];
+	return result;
+}
+
+inline bool operator<(NativeU256 const& _a, NativeU256 const& _b)
+{
+	for (size_t i = 4; i-- > 0;)
+		if (_a.m_limbs[i] != _b.m_limbs[i])
+			return _a.m_limbs[i] < _b.m_limbs[i];
+	return false;
+}
+
+inline bool slt(NativeU256 const& _a, NativeU256 const& _b)
+{
+	if (_a.isNegative() != _b.isNegative())
+		return _a.isNegative();
+	return _a < _b;
+}
+
+inline bool sgt(NativeU256 const& _a, NativeU256 const& _b)
+{
+	return slt(_b, _a);
+}
+
+}
@@ -0,0 +1,197 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolutil/Parallel.h>
+#include <libsolutil/Profiler.h>
+#include <libsolutil/Tracer.h>
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+
+using namespace solidity;
+
+namespace
+{
+
+thread_local util::ThreadPool* currentThreadPool = nullptr;
+
+}
+
+/// Indices to be processed by the threads taking part in a call of parallelFor().
+struct util::ThreadPool::Job
+{
+	Job(size_t _count, std::function<void(size_t)> const& _body):
+		count(_count),
+		body(_body),
+		exceptions(_count),
+		profiler(Profiler::current()),
+		tracer(Tracer::current())
+	{}
+
+	/// Processes indices until there are none left.
+	void work()
+	{
+		for (size_t index = nextIndex++; index < count; index = nextIndex++)
+			try
+			{
+				body(index);
+			}
+			catch (...)
+			{
+				exceptions[index] = std::current_exception();
+			}
+	}
+
+	/// Rethrows the exception thrown for the lowest index, if any.
+	void rethrow() const
+	{
+		for (std::exception_ptr const& exception: exceptions)
+			if (exception)
+				std::rethrow_exception(exception);
+	}
+
+	size_t const count;
+	std::function<void(size_t)> const& body;
+	std::atomic<size_t> nextIndex = 0;
+	std::vector<std::exception_ptr> exceptions;
+	/// Profiler and tracer of the thread that started the job.
+	Profiler* const profiler;
+	Tracer* const tracer;
+	/// Number of workers that may still join the job. Guarded by the mutex of the pool.
+	size_t helperSlots = 0;
+	/// Number of workers currently working on the job. Guarded by the mutex of the pool.
+	size_t activeHelpers = 0;
+};
+
+util::ThreadPool::Scope::Scope(ThreadPool* _threadPool):
+	m_previous(currentThreadPool)
+{
+	currentThreadPool = _threadPool;
+}
+
+util::ThreadPool::Scope::~Scope()
+{
+	currentThreadPool = m_previous;
+}
+
+util::ThreadPool::ThreadPool(size_t _workerCount)
+{
+	m_workers.reserve(_workerCount);
+	for (size_t i = 0; i < _workerCount; ++i)
+		m_workers.emplace_back([this]() { workerLoop(); });
+}
+
+util::ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard lock(m_mutex);
+		m_stopping = true;
+	}
+	m_jobQueued.notify_all();
+	for (std::thread& worker: m_workers)
+		worker.join();
+}
+
+util::ThreadPool* util::ThreadPool::current()
+{
+	return currentThreadPool;
+}
+
+void util::ThreadPool::run(Job& _job, size_t _helperCount)
+{
+	_helperCount = std::min(_helperCount, m_workers.size());
+	if (_helperCount > 0)
+	{
+		{
+			std::lock_guard lock(m_mutex);
+			_job.helperSlots = _helperCount;
+			m_queue.push_back(&_job);
+		}
+		m_jobQueued.notify_all();
+	}
+
+	_job.work();
+
+	if (_helperCount > 0)
+	{
+		std::unique_lock lock(m_mutex);
+		// Workers that did not join yet would not find any indices left.
+		if (_job.helperSlots > 0)
+			m_queue.erase(std::find(m_queue.begin(), m_queue.end(), &_job));
+		m_helperFinished.wait(lock, [&]() { return _job.activeHelpers == 0; });
+	}
+}
+
+void util::ThreadPool::workerLoop()
+{
+	Scope threadPoolScope(this);
+	std::unique_lock lock(m_mutex);
+	while (true)
+	{
+		m_jobQueued.wait(lock, [&]() { return m_stopping || !m_queue.empty(); });
+		if (m_stopping)
+			return;
+
+		Job& job = *m_queue.front();
+		if (--job.helperSlots == 0)
+			m_queue.pop_front();
+		++job.activeHelpers;
+		lock.unlock();
+		{
+			Profiler::Scope profilerScope(job.profiler);
+			Tracer::Scope tracerScope(job.tracer);
+			job.work();
+		}
+		lock.lock();
+		--job.activeHelpers;
+		m_helperFinished.notify_all();
+	}
+}
+
+void util::parallelFor(size_t _count, size_t _maxThreads, std::function<void(size_t)> const& _body)
+{
+	size_t const threadCount = std::min(_count, _maxThreads);
+	if (threadCount <= 1)
+	{
+		for (size_t index = 0; index < _count; ++index)
+			_body(index);
+		return;
+	}
+
+	ThreadPool::Job job(_count, _body);
+	if (ThreadPool* threadPool = ThreadPool::current())
+		threadPool->run(job, threadCount - 1);
+	else
+	{
+		auto worker = [&]()
+		{
+			Profiler::Scope profilerScope(job.profiler);
+			Tracer::Scope tracerScope(job.tracer);
+			job.work();
+		};
+		std::vector<std::thread> threads;
+		threads.reserve(threadCount - 1);
+		for (size_t i = 1; i < threadCount; ++i)
+			threads.emplace_back(worker);
+		worker();
+		for (std::thread& thread: threads)
+			thread.join();
+	}
+	job.rethrow();
+}
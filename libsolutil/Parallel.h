@@ -0,0 +1,115 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Helpers for running independent pieces of work concurrently.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace solidity::util
+{
+
+/// Set of worker threads that are started once and then run the calls of parallelFor()
+/// for as long as the pool exists. Reusing the threads avoids the cost of starting new ones
+/// and keeps the thread-local state built up by earlier calls, e.g. caches of the optimiser.
+///
+/// parallelFor() uses the pool active in the calling thread, if any. Use ThreadPool::Scope to
+/// activate a pool. Calls made on the workers see the same pool as active, so nested calls
+/// use it too. The thread that calls parallelFor() always takes part in the work and
+/// never waits for a worker to become idle, which means that nested calls cannot deadlock
+/// even when all workers are busy.
+///
+/// The pool must not be destroyed while a call of parallelFor() is using it.
+class ThreadPool
+{
+public:
+	/// Makes the given pool (or none if it is null) the one used by parallelFor() in the current
+	/// thread, until the scope is destroyed.
+	class Scope
+	{
+	public:
+		explicit Scope(ThreadPool* _threadPool);
+		~Scope();
+
+		Scope(Scope const&) = delete;
+		Scope& operator=(Scope const&) = delete;
+
+	private:
+		ThreadPool* m_previous = nullptr;
+	};
+
+	/// Starts @a _workerCount threads in addition to the ones that will call parallelFor().
+	explicit ThreadPool(size_t _workerCount);
+	~ThreadPool();
+
+	ThreadPool(ThreadPool const&) = delete;
+	ThreadPool& operator=(ThreadPool const&) = delete;
+
+	/// @returns the pool used by parallelFor() in the current thread, if any.
+	static ThreadPool* current();
+
+	size_t workerCount() const { return m_workers.size(); }
+
+private:
+	struct Job;
+
+	friend void parallelFor(size_t _count, size_t _maxThreads, std::function<void(size_t)> const& _body);
+
+	/// Processes the indices of @a _job in the calling thread with the help of up to
+	/// @a _helperCount idle workers and returns once all of them are processed.
+	void run(Job& _job, size_t _helperCount);
+	void workerLoop();
+
+	std::mutex m_mutex;
+	/// Notified when a job is queued or the pool is being destroyed.
+	std::condition_variable m_jobQueued;
+	/// Notified when a worker stops working on a job.
+	std::condition_variable m_helperFinished;
+	/// Jobs that can still use more workers, in the order in which they were started.
+	std::deque<Job*> m_queue;
+	bool m_stopping = false;
+	std::vector<std::thread> m_workers;
+};
+
+/// Invokes @a _body once for every index in the range [0, @a _count), distributing the calls over
+/// at most @a _maxThreads threads, the calling thread included. With @a _maxThreads not greater than
+/// one the calls are made sequentially, in order and without spawning any threads.
+///
+/// The threads are taken from the pool active in the calling thread if there is one, in which case
+/// fewer threads are used when not enough workers are idle. Otherwise new threads are started for
+/// the call.
+///
+/// The order in which indices are processed is unspecified, which means that the calls must be
+/// independent of each other and any state they share must be safe for concurrent use.
+///
+/// If any of the calls throws, the exception thrown for the lowest index is rethrown in the calling
+/// thread once all the threads have finished. Calls for the remaining indices may or may not be made.
+///
+/// Probes and spans created by the calls are recorded by the profiler and the tracer active in the
+/// calling thread, if any.
+void parallelFor(size_t _count, size_t _maxThreads, std::function<void(size_t)> const& _body);
+
+}
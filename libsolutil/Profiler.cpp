@@ -24,40 +24,138 @@
 #include <iostream>
 #include <vector>
 
+#if (defined(__linux__) || defined(__APPLE__)) && !defined(__EMSCRIPTEN__)
+#include <sys/resource.h>
+#endif
+
 using namespace std::chrono;
 using namespace solidity;
 
-#ifdef PROFILE_OPTIMIZER_STEPS
+namespace
+{
+
+thread_local util::Profiler* currentProfiler = nullptr;
 
-util::Profiler::Probe::Probe(std::string _scopeName):
-	m_scopeName(std::move(_scopeName)),
-	m_startTime(steady_clock::now())
+/// @returns the peak resident set size of the process in bytes or zero if it cannot be determined.
+size_t peakMemoryUsage()
 {
+#if (defined(__linux__) || defined(__APPLE__)) && !defined(__EMSCRIPTEN__)
+	rusage usage{};
+	if (getrusage(RUSAGE_SELF, &usage) != 0 || usage.ru_maxrss < 0)
+		return 0;
+#ifdef __APPLE__
+	return static_cast<size_t>(usage.ru_maxrss);
+#else
+	return static_cast<size_t>(usage.ru_maxrss) * 1024;
+#endif
+#else
+	return 0;
+#endif
+}
+
+}
+
+util::Profiler::Probe::Probe(std::string_view _scopeName):
+	m_span(_scopeName, "phase")
+{
+	m_profiler = currentProfiler;
+#ifdef PROFILE_OPTIMIZER_STEPS
+	bool const active = true;
+#else
+	bool const active = m_profiler != nullptr;
+#endif
+	if (!active)
+		return;
+
+	m_scopeName = _scopeName;
+	m_startPeakMemoryUsage = peakMemoryUsage();
+	m_startTime = steady_clock::now();
 }
 
 util::Profiler::Probe::~Probe()
 {
+#ifndef PROFILE_OPTIMIZER_STEPS
+	if (!m_profiler)
+		return;
+#endif
+
 	steady_clock::time_point endTime = steady_clock::now();
+	Metrics metrics{
+		duration_cast<microseconds>(endTime - m_startTime),
+		1,
+		peakMemoryUsage() - m_startPeakMemoryUsage
+	};
+	if (m_profiler)
+		m_profiler->record(m_scopeName, metrics);
+#ifdef PROFILE_OPTIMIZER_STEPS
+	singleton().record(m_scopeName, metrics);
+#endif
+}
+
+util::Profiler::Scope::Scope(Profiler* _profiler):
+	m_previous(currentProfiler)
+{
+	currentProfiler = _profiler;
+}
 
-	auto [metricsIt, inserted] = Profiler::singleton().m_metrics.try_emplace(m_scopeName, Metrics{0us, 0});
-	metricsIt->second.durationInMicroseconds += duration_cast<microseconds>(endTime - m_startTime);
-	++metricsIt->second.callCount;
+util::Profiler::Scope::~Scope()
+{
+	currentProfiler = m_previous;
 }
 
 util::Profiler::~Profiler()
 {
-	outputPerformanceMetrics();
+#ifdef PROFILE_OPTIMIZER_STEPS
+	if (m_printOnExit)
+		outputPerformanceMetrics(std::cerr);
+#endif
 }
 
+util::Profiler* util::Profiler::current()
+{
+	return currentProfiler;
+}
+
+#ifdef PROFILE_OPTIMIZER_STEPS
 util::Profiler& util::Profiler::singleton()
 {
 	static Profiler profiler;
+	profiler.m_printOnExit = true;
 	return profiler;
 }
+#endif
 
-void util::Profiler::outputPerformanceMetrics()
+void util::Profiler::record(std::string const& _scopeName, Metrics const& _metrics)
 {
-	std::vector<std::pair<std::string, Metrics>> sortedMetrics(m_metrics.begin(), m_metrics.end());
+	std::lock_guard lock(m_mutex);
+	Metrics& metrics = m_metrics[_scopeName];
+	metrics.durationInMicroseconds += _metrics.durationInMicroseconds;
+	metrics.callCount += _metrics.callCount;
+	metrics.peakMemoryIncrease = std::max(metrics.peakMemoryIncrease, _metrics.peakMemoryIncrease);
+}
+
+std::map<std::string, util::Profiler::Metrics> util::Profiler::metrics() const
+{
+	std::lock_guard lock(m_mutex);
+	return m_metrics;
+}
+
+Json util::Profiler::toJson() const
+{
+	Json result = Json::object();
+	for (auto&& [scopeName, scopeMetrics]: metrics())
+		result[scopeName] = {
+			{"calls", Json::number_unsigned_t(scopeMetrics.callCount)},
+			{"time", Json::number_unsigned_t(scopeMetrics.durationInMicroseconds.count())},
+			{"peakMemoryIncrease", Json::number_unsigned_t(scopeMetrics.peakMemoryIncrease)}
+		};
+	return result;
+}
+
+void util::Profiler::outputPerformanceMetrics(std::ostream& _stream) const
+{
+	std::map<std::string, Metrics> const gatheredMetrics = metrics();
+	std::vector<std::pair<std::string, Metrics>> sortedMetrics(gatheredMetrics.begin(), gatheredMetrics.end());
 	std::sort(
 		sortedMetrics.begin(),
 		sortedMetrics.end(),
@@ -75,24 +173,23 @@ void util::Profiler::outputPerformanceMetrics()
 		totalCallCount += scopeMetrics.callCount;
 	}
 
-	std::cerr << "PERFORMANCE METRICS FOR PROFILED SCOPES\n\n";
-	std::cerr << "| Time % | Time       | Calls   | Scope                          |\n";
-	std::cerr << "|-------:|-----------:|--------:|--------------------------------|\n";
+	_stream << "PERFORMANCE METRICS FOR PROFILED SCOPES\n\n";
+	_stream << "| Time % | Time       | Calls   | Peak memory +  | Scope                          |\n";
+	_stream << "|-------:|-----------:|--------:|---------------:|--------------------------------|\n";
 
 	double totalDurationInSeconds = duration_cast<duration<double>>(totalDurationInMicroseconds).count();
 	for (auto&& [scopeName, scopeMetrics]: sortedMetrics)
 	{
 		double durationInSeconds = duration_cast<duration<double>>(scopeMetrics.durationInMicroseconds).count();
-		double percentage = 100.0 * durationInSeconds / totalDurationInSeconds;
-		std::cerr << fmt::format(
-			"| {:5.1f}% | {:8.3f} s | {:7} | {:30} |\n",
+		double percentage = totalDurationInSeconds > 0 ? 100.0 * durationInSeconds / totalDurationInSeconds : 0.0;
+		_stream << fmt::format(
+			"| {:5.1f}% | {:8.3f} s | {:7} | {:11.1f} MB | {:30} |\n",
 			percentage,
 			durationInSeconds,
 			scopeMetrics.callCount,
+			static_cast<double>(scopeMetrics.peakMemoryIncrease) / (1024.0 * 1024.0),
 			scopeName
 		);
 	}
-	std::cerr << fmt::format("| {:5.1f}% | {:8.3f} s | {:7} | {:30} |\n", 100.0, totalDurationInSeconds, totalCallCount, "**TOTAL**");
+	_stream << fmt::format("| {:5.1f}% | {:8.3f} s | {:7} | {:>14} | {:30} |\n", 100.0, totalDurationInSeconds, totalCallCount, "", "**TOTAL**");
 }
-
-#endif
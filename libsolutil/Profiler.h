@@ -18,64 +18,113 @@
 
 #pragma once
 
+#include <libsolutil/JSON.h>
+#include <libsolutil/Tracer.h>
+
 #include <chrono>
+#include <cstddef>
 #include <map>
-#include <optional>
+#include <mutex>
+#include <ostream>
 #include <string>
+#include <string_view>
 
-#ifdef PROFILE_OPTIMIZER_STEPS
 #define PROFILER_PROBE(_scopeName, _variable) solidity::util::Profiler::Probe _variable(_scopeName);
-#else
-#define PROFILER_PROBE(_scopeName, _variable) void(0);
-#endif
 
 namespace solidity::util
 {
 
-#ifdef PROFILE_OPTIMIZER_STEPS
-
-/// Simpler profiler class that gathers metrics during program execution and prints them out on exit.
+/// Simple profiler class that gathers metrics about the execution of named scopes.
 ///
 /// To gather metrics, create a Probe instance and let it live until the end of the scope.
-/// The probe will register its creation and destruction time and store the results in the profiler
-/// singleton.
+/// The probe will register its creation and destruction time along with the growth of the
+/// peak memory usage of the process in between and store the results in the profiler that
+/// was active in the current thread when the probe was created. If no profiler is active,
+/// the probe does nothing. Use Profiler::Scope to activate a profiler.
 ///
-/// Use the PROFILER_PROBE macro to create probes conditionally, in a way that will not affect performance
-/// unless profiling is enabled at compilation time via PROFILE_OPTIMIZER_STEPS CMake option.
+/// Use the PROFILER_PROBE macro to create probes. When PROFILE_OPTIMIZER_STEPS CMake option is
+/// enabled at compilation time, all probes are additionally recorded in a global profiler
+/// that prints its metrics to standard error output on exit.
 ///
 /// Scopes are identified by the name supplied to the probe. Using the same name multiple times
 /// will result in metrics for those scopes being aggregated together as if they were the same scope.
+/// Scopes may be nested, in which case the metrics of the outer scope include those of the inner ones.
+///
+/// Probes are also recorded as spans of the category "phase" by the active Tracer, if any.
+///
+/// A profiler may collect metrics from several threads at the same time.
 class Profiler
 {
 public:
+	struct Metrics
+	{
+		std::chrono::microseconds durationInMicroseconds{0};
+		size_t callCount = 0;
+		/// The largest growth of the peak memory usage of the process during a single call, in bytes.
+		/// Always zero on platforms where the peak memory usage cannot be queried.
+		size_t peakMemoryIncrease = 0;
+	};
+
 	class Probe
 	{
 	public:
-		Probe(std::string _scopeName);
+		explicit Probe(std::string_view _scopeName);
 		~Probe();
 
+		Probe(Probe const&) = delete;
+		Probe& operator=(Probe const&) = delete;
+
 	private:
+		Tracer::Span m_span;
+		Profiler* m_profiler = nullptr;
 		std::string m_scopeName;
 		std::chrono::steady_clock::time_point m_startTime;
+		size_t m_startPeakMemoryUsage = 0;
 	};
 
-	static Profiler& singleton();
+	/// Makes the given profiler (or none if it is null) the one recording the probes created
+	/// in the current thread, until the scope is destroyed.
+	class Scope
+	{
+	public:
+		explicit Scope(Profiler* _profiler);
+		~Scope();
 
-private:
-	~Profiler();
+		Scope(Scope const&) = delete;
+		Scope& operator=(Scope const&) = delete;
 
-	struct Metrics
-	{
-		std::chrono::microseconds durationInMicroseconds;
-		size_t callCount;
+	private:
+		Profiler* m_previous = nullptr;
 	};
 
-	/// Summarizes gathered metric and prints a report to standard error output.
-	void outputPerformanceMetrics();
+	Profiler() = default;
+	~Profiler();
 
-	std::map<std::string, Metrics> m_metrics;
-};
+	/// @returns the profiler recording the probes created in the current thread, if any.
+	static Profiler* current();
 
+	/// @returns the metrics gathered so far, keyed by scope name.
+	std::map<std::string, Metrics> metrics() const;
+
+	/// @returns the metrics as a JSON object mapping scope names to objects with the members
+	/// "calls", "time" (in microseconds) and "peakMemoryIncrease" (in bytes).
+	Json toJson() const;
+
+	/// Prints a table summarizing the gathered metrics.
+	void outputPerformanceMetrics(std::ostream& _stream) const;
+
+#ifdef PROFILE_OPTIMIZER_STEPS
+	static Profiler& singleton();
+#endif
+
+private:
+	void record(std::string const& _scopeName, Metrics const& _metrics);
+
+	mutable std::mutex m_mutex;
+	std::map<std::string, Metrics> m_metrics;
+#ifdef PROFILE_OPTIMIZER_STEPS
+	bool m_printOnExit = false;
 #endif
+};
 
 }
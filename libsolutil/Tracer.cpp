@@ -0,0 +1,100 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolutil/Tracer.h>
+
+using namespace std::chrono;
+using namespace solidity;
+
+namespace
+{
+
+thread_local util::Tracer* currentTracer = nullptr;
+
+}
+
+util::Tracer::Span::Span(std::string_view _name, std::string_view _category):
+	m_tracer(currentTracer)
+{
+	if (!m_tracer)
+		return;
+
+	m_name = _name;
+	m_category = _category;
+	m_startTime = Clock::now();
+}
+
+util::Tracer::Span::~Span()
+{
+	if (m_tracer)
+		m_tracer->record(std::move(m_name), std::move(m_category), m_startTime, Clock::now());
+}
+
+util::Tracer::Scope::Scope(Tracer* _tracer):
+	m_previous(currentTracer)
+{
+	currentTracer = _tracer;
+}
+
+util::Tracer::Scope::~Scope()
+{
+	currentTracer = m_previous;
+}
+
+util::Tracer::Tracer():
+	m_startTime(Clock::now())
+{
+}
+
+util::Tracer* util::Tracer::current()
+{
+	return currentTracer;
+}
+
+void util::Tracer::record(std::string _name, std::string _category, Clock::time_point _start, Clock::time_point _end)
+{
+	std::lock_guard lock(m_mutex);
+	size_t threadID = m_threadIDs.try_emplace(std::this_thread::get_id(), m_threadIDs.size()).first->second;
+	m_events.push_back(Event{
+		std::move(_name),
+		std::move(_category),
+		duration_cast<microseconds>(_start - m_startTime),
+		duration_cast<microseconds>(_end - _start),
+		threadID
+	});
+}
+
+Json util::Tracer::toJson() const
+{
+	std::lock_guard lock(m_mutex);
+	Json events = Json::array();
+	for (Event const& event: m_events)
+		events.push_back({
+			{"name", event.name},
+			{"cat", event.category},
+			{"ph", "X"},
+			{"ts", Json::number_integer_t(event.start.count())},
+			{"dur", Json::number_integer_t(event.duration.count())},
+			{"pid", 1},
+			{"tid", Json::number_unsigned_t(event.threadID)}
+		});
+	return {
+		{"traceEvents", std::move(events)},
+		{"displayTimeUnit", "ms"}
+	};
+}
@@ -0,0 +1,110 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+/**
+ * Recording of the execution of the compiler as a timeline.
+ */
+
+#pragma once
+
+#include <libsolutil/JSON.h>
+
+#include <chrono>
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace solidity::util
+{
+
+/// Collects timed spans of the execution of the compiler, possibly from several threads, and
+/// exports them in the Trace Event Format understood by chrome://tracing and Perfetto.
+///
+/// Spans are recorded by creating a Span instance and letting it live until the end of the scope.
+/// The span is recorded in the tracer that was active in the current thread when the span was created.
+/// If no tracer is active, the span does nothing. Use Tracer::Scope to activate a tracer.
+/// Every probe created with PROFILER_PROBE is also recorded as a span.
+class Tracer
+{
+public:
+	using Clock = std::chrono::steady_clock;
+
+	class Span
+	{
+	public:
+		Span(std::string_view _name, std::string_view _category);
+		~Span();
+
+		Span(Span const&) = delete;
+		Span& operator=(Span const&) = delete;
+
+	private:
+		Tracer* m_tracer = nullptr;
+		std::string m_name;
+		std::string m_category;
+		Clock::time_point m_startTime;
+	};
+
+	/// Makes the given tracer (or none if it is null) the one recording the spans created
+	/// in the current thread, until the scope is destroyed.
+	class Scope
+	{
+	public:
+		explicit Scope(Tracer* _tracer);
+		~Scope();
+
+		Scope(Scope const&) = delete;
+		Scope& operator=(Scope const&) = delete;
+
+	private:
+		Tracer* m_previous = nullptr;
+	};
+
+	Tracer();
+
+	/// @returns the tracer recording the spans created in the current thread, if any.
+	static Tracer* current();
+
+	/// @returns the recorded spans as "complete" events of the Trace Event Format, with timestamps
+	/// in microseconds relative to the creation of the tracer. Threads are numbered in the order
+	/// in which they first recorded a span.
+	Json toJson() const;
+
+private:
+	struct Event
+	{
+		std::string name;
+		std::string category;
+		std::chrono::microseconds start;
+		std::chrono::microseconds duration;
+		size_t threadID;
+	};
+
+	void record(std::string _name, std::string _category, Clock::time_point _start, Clock::time_point _end);
+
+	Clock::time_point const m_startTime;
+	mutable std::mutex m_mutex;
+	std::map<std::thread::id, size_t> m_threadIDs;
+	std::vector<Event> m_events;
+};
+
+}
@@ -23,36 +23,35 @@ namespace solidity::yul
 {
 
 LiteralValue::LiteralValue(std::string _builtinStringLiteralValue):
-	m_numericValue(std::nullopt),
-	m_stringValue(std::make_shared<std::string>(std::move(_builtinStringLiteralValue)))
+	m_text(std::make_shared<Text const>(Text{std::move(_builtinStringLiteralValue), true}))
 { }
 
 LiteralValue::LiteralValue(solidity::yul::LiteralValue::Data const& _data, std::optional<std::string> const& _hint):
 	m_numericValue(_data),
-	m_stringValue(_hint ? std::make_shared<std::string>(*_hint) : nullptr)
+	m_text(_hint ? std::make_shared<Text const>(Text{*_hint, false}) : nullptr)
 { }
 
 LiteralValue::Data const& LiteralValue::value() const
 {
 	yulAssert(!unlimited());
-	return *m_numericValue;
+	return m_numericValue;
 }
 
 LiteralValue::BuiltinStringLiteralData const& LiteralValue::builtinStringLiteralValue() const
 {
 	yulAssert(unlimited());
-	return *m_stringValue;
+	return m_text->value;
 }
 
 bool LiteralValue::unlimited() const
 {
-	return !m_numericValue.has_value();
+	return m_text && m_text->unlimited;
 }
 
-LiteralValue::RepresentationHint const& LiteralValue::hint() const
+LiteralValue::RepresentationHint LiteralValue::hint() const
 {
 	yulAssert(!unlimited());
-	return m_stringValue;
+	return m_text ? &m_text->value : nullptr;
 }
 
 bool LiteralValue::operator==(LiteralValue const& _rhs) const
@@ -52,7 +52,8 @@ class LiteralValue {
 public:
 	using Data = u256;
 	using BuiltinStringLiteralData = std::string;
-	using RepresentationHint = std::shared_ptr<std::string>;
+	/// Original representation of a numeric literal, null if unknown.
+	using RepresentationHint = std::string const*;
 
 	LiteralValue() = default;
 	explicit LiteralValue(std::string _builtinStringLiteralValue);
@@ -63,11 +64,20 @@ public:
 	Data const& value() const;
 	BuiltinStringLiteralData const& builtinStringLiteralValue() const;
 	bool unlimited() const;
-	RepresentationHint const& hint() const;
+	RepresentationHint hint() const;
 
 private:
-	std::optional<Data> m_numericValue;
-	std::shared_ptr<std::string> m_stringValue;
+	/// Text shared between copies of a literal: the representation hint of a numeric literal
+	/// or the value of an unlimited literal. Keeping the flag here instead of wrapping the
+	/// numeric value in an optional keeps literals, and thereby all expressions, small.
+	struct Text
+	{
+		std::string value;
+		bool unlimited = false;
+	};
+
+	Data m_numericValue;
+	std::shared_ptr<Text const> m_text;
 };
 struct Literal { langutil::DebugData::ConstPtr debugData; LiteralKind kind; LiteralValue value; };
 /// External / internal identifier or label reference
@@ -67,7 +67,7 @@ langutil::DebugData::ConstPtr Parser::createDebugData() const
 		case UseSourceLocationFrom::Scanner:
 			return DebugData::create(ParserBase::currentLocation(), ParserBase::currentLocation());
 		case UseSourceLocationFrom::LocationOverride:
-			return DebugData::create(m_locationOverride, m_locationOverride);
+			return m_debugDataOverride;
 		case UseSourceLocationFrom::Comments:
 			return DebugData::create(ParserBase::currentLocation(), m_locationFromComment, m_astIDFromComment);
 	}
@@ -80,6 +80,8 @@ void Parser::updateLocationEndFrom(
 ) const
 {
 	solAssert(_debugData, "");
+	if (_debugData->nativeLocation.end == _location.end)
+		return;
 
 	switch (m_useSourceLocationFrom)
 	{
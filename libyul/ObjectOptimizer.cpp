@@ -20,6 +20,7 @@
 
 #include <libyul/AsmAnalysisInfo.h>
 #include <libyul/AsmAnalysis.h>
+#include <libyul/AsmParser.h>
 #include <libyul/AsmPrinter.h>
 #include <libyul/AST.h>
 #include <libyul/Exceptions.h>
@@ -28,12 +29,17 @@
 #include <libyul/optimiser/ASTCopier.h>
 #include <libyul/optimiser/Suite.h>
 
+#include <liblangutil/CharStream.h>
 #include <liblangutil/DebugInfoSelection.h>
+#include <liblangutil/ErrorReporter.h>
 
 #include <libsolutil/Keccak256.h>
+#include <libsolutil/Parallel.h>
+#include <libsolutil/Tracer.h>
 
 #include <boost/algorithm/string.hpp>
 
+#include <algorithm>
 #include <limits>
 #include <numeric>
 
@@ -54,71 +60,186 @@ Dialect const& yul::languageToDialect(Language _language, EVMVersion _version, s
 	util::unreachable();
 }
 
-void ObjectOptimizer::optimize(Object& _object, Settings const& _settings)
+void ObjectOptimizer::optimize(Object& _object, Settings const& _settings, size_t _maxThreads)
 {
 	yulAssert(_object.subId == std::numeric_limits<size_t>::max(), "Not a top-level object.");
 
-	optimize(_object, _settings, true /* _isCreation */);
+	std::vector<std::pair<Object*, bool>> objects;
+	collectObjects(_object, true /* _isCreation */, objects);
+	// Threads not needed for optimizing different objects are used for the functions of each object.
+	size_t threadsPerObject = std::max<size_t>(1, _maxThreads / std::max<size_t>(1, objects.size()));
+	parallelFor(objects.size(), _maxThreads, [&](size_t _index) {
+		optimize(*objects[_index].first, _settings, objects[_index].second, threadsPerObject);
+	});
 }
 
-void ObjectOptimizer::optimize(Object& _object, Settings const& _settings, bool _isCreation)
+void ObjectOptimizer::collectObjects(Object& _object, bool _isCreation, std::vector<std::pair<Object*, bool>>& _objects)
 {
-	yulAssert(_object.code());
-	yulAssert(_object.debugData);
-
 	for (auto& subNode: _object.subObjects)
 		if (auto subObject = dynamic_cast<Object*>(subNode.get()))
 		{
 			bool isCreation = !boost::ends_with(subObject->name, "_deployed");
-			optimize(
-				*subObject,
-				_settings,
-				isCreation
-			);
+			collectObjects(*subObject, isCreation, _objects);
 		}
 
+	_objects.emplace_back(&_object, _isCreation);
+}
+
+void ObjectOptimizer::optimize(Object& _object, Settings const& _settings, bool _isCreation, size_t _maxThreads)
+{
+	yulAssert(_object.code());
+	yulAssert(_object.debugData);
+	Tracer::Span span(_object.name, "object");
+
 	Dialect const& dialect = languageToDialect(_settings.language, _settings.evmVersion, _settings.eofVersion);
 	std::unique_ptr<GasMeter> meter;
 	if (EVMDialect const* evmDialect = dynamic_cast<EVMDialect const*>(&dialect))
 		meter = std::make_unique<GasMeter>(*evmDialect, _isCreation, _settings.expectedExecutionsPerDeployment);
 
 	std::optional<h256> cacheKey = calculateCacheKey(_object.code()->root(), *_object.debugData, _settings, _isCreation);
-	if (cacheKey.has_value() && m_cachedObjects.count(*cacheKey) != 0)
+	if (cacheKey.has_value())
+		if (std::optional<CachedObject> cachedOptimizedObject = cachedObjectOrClaim(*cacheKey))
+		{
+			overwriteWithOptimizedObject(*cachedOptimizedObject, _object);
+			return;
+		}
+
+	try
+	{
+		if (cacheKey.has_value() && m_persistentCache)
+			if (std::optional<CachedObject> storedObject = loadFromPersistentCache(*cacheKey, *_object.debugData, dialect))
+			{
+				storeCachedObject(*cacheKey, *storedObject);
+				overwriteWithOptimizedObject(*storedObject, _object);
+				return;
+			}
+
+		OptimiserSuite::run(
+			meter.get(),
+			_object,
+			_settings.optimizeStackAllocation,
+			_settings.yulOptimiserSteps,
+			_settings.yulOptimiserCleanupSteps,
+			_isCreation ? std::nullopt : std::make_optional(_settings.expectedExecutionsPerDeployment),
+			{},
+			_maxThreads
+		);
+	}
+	catch (...)
+	{
+		if (cacheKey.has_value())
+			releaseCacheKey(*cacheKey);
+		throw;
+	}
+
+	if (cacheKey.has_value())
+	{
+		storeCachedObject(*cacheKey, CachedObject{
+			std::make_shared<Block>(ASTCopier{}.translate(_object.code()->root())),
+			&dialect,
+		});
+		if (m_persistentCache)
+			m_persistentCache->store(
+				*cacheKey,
+				AsmPrinter(dialect, _object.debugData->sourceNames, DebugInfoSelection::All())(_object.code()->root())
+			);
+	}
+}
+
+void ObjectOptimizer::storeCachedObject(util::h256 _cacheKey, CachedObject _cachedObject)
+{
 	{
-		overwriteWithOptimizedObject(*cacheKey, _object);
+		std::lock_guard lock(m_cacheMutex);
+		auto [it, inserted] = m_cachedObjects.try_emplace(_cacheKey);
+		it->second.object = std::move(_cachedObject);
+		if (inserted)
+		{
+			m_usageOrder.push_front(_cacheKey);
+			it->second.usage = m_usageOrder.begin();
+		}
+		else
+			touch(it->second);
+		m_claimedCacheKeys.erase(_cacheKey);
+		evictExcessObjects();
+	}
+	m_cacheKeyReleased.notify_all();
+}
+
+void ObjectOptimizer::setMaxCachedObjects(size_t _maxCachedObjects)
+{
+	std::lock_guard lock(m_cacheMutex);
+	m_maxCachedObjects = _maxCachedObjects;
+	evictExcessObjects();
+}
+
+void ObjectOptimizer::touch(CacheEntry& _entry)
+{
+	m_usageOrder.splice(m_usageOrder.begin(), m_usageOrder, _entry.usage);
+}
+
+void ObjectOptimizer::evictExcessObjects()
+{
+	if (!m_maxCachedObjects.has_value())
 		return;
+	while (m_cachedObjects.size() > *m_maxCachedObjects)
+	{
+		m_cachedObjects.erase(m_usageOrder.back());
+		m_usageOrder.pop_back();
 	}
+}
 
-	OptimiserSuite::run(
-		meter.get(),
-		_object,
-		_settings.optimizeStackAllocation,
-		_settings.yulOptimiserSteps,
-		_settings.yulOptimiserCleanupSteps,
-		_isCreation ? std::nullopt : std::make_optional(_settings.expectedExecutionsPerDeployment),
-		{}
-	);
+std::optional<ObjectOptimizer::CachedObject> ObjectOptimizer::loadFromPersistentCache(
+	util::h256 _cacheKey,
+	ObjectDebugData const& _debugData,
+	Dialect const& _dialect
+) const
+{
+	yulAssert(m_persistentCache);
+	std::optional<std::string> source = m_persistentCache->load(_cacheKey);
+	if (!source.has_value())
+		return std::nullopt;
 
-	if (cacheKey.has_value())
-		storeOptimizedObject(*cacheKey, _object, dialect);
+	// The entry is the printed AST, including the debug info, which is also a part of the cache key.
+	ErrorList errors;
+	ErrorReporter errorReporter(errors);
+	CharStream charStream(std::move(*source), "");
+	std::unique_ptr<AST> ast = Parser(errorReporter, _dialect, _debugData.sourceNames).parse(charStream);
+	if (!ast || errorReporter.hasErrors())
+		return std::nullopt;
+
+	return CachedObject{std::make_shared<Block>(ASTCopier{}.translate(ast->root())), &_dialect};
 }
 
-void ObjectOptimizer::storeOptimizedObject(util::h256 _cacheKey, Object const& _optimizedObject, Dialect const& _dialect)
+std::optional<ObjectOptimizer::CachedObject> ObjectOptimizer::cachedObjectOrClaim(util::h256 _cacheKey)
 {
-	m_cachedObjects[_cacheKey] = CachedObject{
-		std::make_shared<Block>(ASTCopier{}.translate(_optimizedObject.code()->root())),
-		&_dialect,
-	};
+	std::unique_lock lock(m_cacheMutex);
+	m_cacheKeyReleased.wait(lock, [&]() { return !m_claimedCacheKeys.count(_cacheKey); });
+
+	auto it = m_cachedObjects.find(_cacheKey);
+	if (it != m_cachedObjects.end())
+	{
+		touch(it->second);
+		return it->second.object;
+	}
+
+	m_claimedCacheKeys.insert(_cacheKey);
+	return std::nullopt;
 }
 
-void ObjectOptimizer::overwriteWithOptimizedObject(util::h256 _cacheKey, Object& _object) const
+void ObjectOptimizer::releaseCacheKey(util::h256 _cacheKey)
 {
-	yulAssert(m_cachedObjects.count(_cacheKey) != 0);
-	CachedObject const& cachedObject = m_cachedObjects.at(_cacheKey);
+	{
+		std::lock_guard lock(m_cacheMutex);
+		m_claimedCacheKeys.erase(_cacheKey);
+	}
+	m_cacheKeyReleased.notify_all();
+}
 
-	yulAssert(cachedObject.optimizedAST);
-	yulAssert(cachedObject.dialect);
-	_object.setCode(std::make_shared<AST>(*cachedObject.dialect, ASTCopier{}.translate(*cachedObject.optimizedAST)));
+void ObjectOptimizer::overwriteWithOptimizedObject(CachedObject const& _cachedObject, Object& _object)
+{
+	yulAssert(_cachedObject.optimizedAST);
+	yulAssert(_cachedObject.dialect);
+	_object.setCode(std::make_shared<AST>(*_cachedObject.dialect, ASTCopier{}.translate(*_cachedObject.optimizedAST)));
 	yulAssert(_object.code());
 	yulAssert(_object.dialect());
 
@@ -20,14 +20,21 @@
 
 #include <libyul/ASTForward.h>
 #include <libyul/Object.h>
+#include <libyul/PersistentObjectCache.h>
 
 #include <liblangutil/EVMVersion.h>
 
 #include <libsolutil/FixedHash.h>
 
+#include <condition_variable>
+#include <list>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
+#include <set>
+#include <utility>
+#include <vector>
 
 namespace solidity::yul
 {
@@ -48,6 +55,10 @@ Dialect const& languageToDialect(Language _language, langutil::EVMVersion _versi
 /// Caching is performed at the granularity of individual ASTs rather than whole object trees,
 /// which means that reuse is possible even within a single hierarchy, e.g. when creation and
 /// deployed objects have common dependencies.
+///
+/// The cache can be safely used by multiple threads optimizing different objects at the same time.
+/// Only one thread at a time optimizes an AST with a given cache key. Other threads requesting
+/// the same key wait for the result instead of repeating the work.
 class ObjectOptimizer
 {
 public:
@@ -68,10 +79,28 @@ public:
 	/// Recursively optimizes a Yul object with given settings, reusing cached ASTs where possible
 	/// or caching the result otherwise. The object is modified in-place.
 	/// Automatically accounts for the difference between creation and deployed objects.
+	/// The optimization of an object does not depend on the code of any other object, so the
+	/// objects in the hierarchy are distributed over up to @a _maxThreads threads. Threads
+	/// not needed for that are used to optimize independent functions of each object.
 	/// @warning Does not ensure that nativeLocations in the resulting AST match the optimized code.
-	void optimize(Object& _object, Settings const& _settings);
+	void optimize(Object& _object, Settings const& _settings, size_t _maxThreads = 1);
+
+	size_t size() const
+	{
+		std::lock_guard lock(m_cacheMutex);
+		return m_cachedObjects.size();
+	}
 
-	size_t size() const { return m_cachedObjects.size(); }
+	/// Limits the number of optimized objects kept in memory. When the limit is exceeded, the least
+	/// recently used objects are dropped. Unlimited by default.
+	void setMaxCachedObjects(size_t _maxCachedObjects);
+
+	/// Makes the optimizer look for optimized ASTs in @a _persistentCache when they are not cached
+	/// in memory and store newly optimized ones there. Must not be called while optimizing.
+	void setPersistentCache(std::shared_ptr<PersistentObjectCache> _persistentCache)
+	{
+		m_persistentCache = std::move(_persistentCache);
+	}
 
 private:
 	struct CachedObject
@@ -80,10 +109,26 @@ private:
 		Dialect const* dialect;
 	};
 
-	void optimize(Object& _object, Settings const& _settings, bool _isCreation);
+	void optimize(Object& _object, Settings const& _settings, bool _isCreation, size_t _maxThreads);
+
+	/// Appends @a _object and all its sub-objects to @a _objects, sub-objects first, together
+	/// with the information whether they contain creation code.
+	static void collectObjects(Object& _object, bool _isCreation, std::vector<std::pair<Object*, bool>>& _objects);
 
-	void storeOptimizedObject(util::h256 _cacheKey, Object const& _optimizedObject, Dialect const& _dialect);
-	void overwriteWithOptimizedObject(util::h256 _cacheKey, Object& _object) const;
+	/// @returns the cached object for the key if there is one. Otherwise makes the calling thread
+	/// responsible for optimizing the object and returns an empty optional. Waits if another thread
+	/// is already optimizing an object with the same key.
+	/// The caller must release the key by calling either storeCachedObject() or releaseCacheKey().
+	std::optional<CachedObject> cachedObjectOrClaim(util::h256 _cacheKey);
+	void storeCachedObject(util::h256 _cacheKey, CachedObject _cachedObject);
+	void releaseCacheKey(util::h256 _cacheKey);
+
+	std::optional<CachedObject> loadFromPersistentCache(
+		util::h256 _cacheKey,
+		ObjectDebugData const& _debugData,
+		Dialect const& _dialect
+	) const;
+	static void overwriteWithOptimizedObject(CachedObject const& _cachedObject, Object& _object);
 
 	static std::optional<util::h256> calculateCacheKey(
 		Block const& _ast,
@@ -92,7 +137,28 @@ private:
 		bool _isCreation
 	);
 
-	std::map<util::h256, CachedObject> m_cachedObjects;
+	struct CacheEntry
+	{
+		CachedObject object;
+		/// Position of the key in m_usageOrder.
+		std::list<util::h256>::iterator usage;
+	};
+
+	/// Marks @a _entry as the most recently used one. Requires the cache mutex.
+	void touch(CacheEntry& _entry);
+	/// Drops the least recently used entries until the size limit is met. Requires the cache mutex.
+	void evictExcessObjects();
+
+	std::map<util::h256, CacheEntry> m_cachedObjects;
+	/// Keys of m_cachedObjects, the most recently used first.
+	std::list<util::h256> m_usageOrder;
+	std::optional<size_t> m_maxCachedObjects;
+	/// Keys of the objects that are currently being optimized.
+	std::set<util::h256> m_claimedCacheKeys;
+	std::mutex mutable m_cacheMutex;
+	std::condition_variable m_cacheKeyReleased;
+
+	std::shared_ptr<PersistentObjectCache> m_persistentCache;
 };
 
 }
@@ -0,0 +1,187 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libyul/PersistentObjectCache.h>
+
+#include <libsolutil/CommonIO.h>
+#include <libsolutil/Keccak256.h>
+
+#include <algorithm>
+#include <ctime>
+#include <fstream>
+#include <tuple>
+#include <vector>
+
+using namespace solidity;
+using namespace solidity::util;
+using namespace solidity::yul;
+
+namespace fs = boost::filesystem;
+
+namespace
+{
+
+std::string const entryExtension = ".yul";
+std::string const temporaryExtension = ".tmp";
+/// Temporary files that have not been modified for this many seconds are left over by processes
+/// that did not finish writing them. Newer ones may still be in use.
+std::time_t const staleTemporaryFileAge = 60 * 60;
+
+}
+
+PersistentObjectCache::PersistentObjectCache(
+	fs::path _directory,
+	std::string const& _version,
+	std::uint64_t _sizeLimit
+):
+	m_directory(std::move(_directory)),
+	m_versionHash(keccak256(_version)),
+	m_sizeLimit(_sizeLimit)
+{
+	fs::create_directories(m_directory);
+
+	std::lock_guard lock(m_mutex);
+	evict(m_sizeLimit);
+}
+
+std::optional<std::string> PersistentObjectCache::load(h256 const& _key)
+{
+	fs::path path = entryPath(_key);
+	std::ifstream file(path.string(), std::ios::binary);
+	if (!file)
+		return std::nullopt;
+
+	// Each entry starts with a line containing the hash of the content, which protects
+	// against entries that were damaged after they had been written.
+	std::string checksum;
+	std::getline(file, checksum);
+	std::string content = readUntilEnd(file);
+	if (file.bad() || checksum != keccak256(content).hex())
+	{
+		file.close();
+		boost::system::error_code error;
+		fs::remove(path, error);
+		return std::nullopt;
+	}
+
+	// The modification time is used to find the least recently used entries.
+	boost::system::error_code error;
+	fs::last_write_time(path, std::time(nullptr), error);
+	return content;
+}
+
+void PersistentObjectCache::store(h256 const& _key, std::string const& _content)
+{
+	boost::system::error_code error;
+	fs::path temporaryPath = m_directory / fs::unique_path("%%%%-%%%%-%%%%-%%%%" + temporaryExtension, error);
+	if (error)
+		return;
+
+	std::string data = keccak256(_content).hex() + "\n" + _content;
+	{
+		std::ofstream file(temporaryPath.string(), std::ios::binary);
+		file << data;
+		if (!file)
+		{
+			file.close();
+			fs::remove(temporaryPath, error);
+			return;
+		}
+	}
+
+	fs::path path = entryPath(_key);
+	std::lock_guard lock(m_mutex);
+	// An existing entry is replaced, so its size no longer counts towards the total.
+	boost::system::error_code sizeError;
+	std::uint64_t replacedSize = fs::file_size(path, sizeError);
+	if (sizeError)
+		replacedSize = 0;
+
+	fs::rename(temporaryPath, path, error);
+	if (error)
+	{
+		fs::remove(temporaryPath, error);
+		return;
+	}
+
+	m_totalSize -= std::min(m_totalSize, replacedSize);
+	m_totalSize += data.size();
+	if (m_totalSize > m_sizeLimit)
+		// Evict more than necessary so that the directory does not need to be scanned on every store.
+		evict(m_sizeLimit / 4 * 3);
+}
+
+std::uint64_t PersistentObjectCache::totalSize() const
+{
+	std::lock_guard lock(m_mutex);
+	return m_totalSize;
+}
+
+fs::path PersistentObjectCache::entryPath(h256 const& _key) const
+{
+	return m_directory / (keccak256(_key.asBytes() + m_versionHash.asBytes()).hex() + entryExtension);
+}
+
+void PersistentObjectCache::evict(std::uint64_t _targetSize)
+{
+	struct Entry
+	{
+		std::time_t lastUse;
+		fs::path path;
+		std::uint64_t size;
+	};
+	std::vector<Entry> entries;
+	std::uint64_t totalSize = 0;
+
+	// Other processes may modify the directory at the same time, so all errors are ignored.
+	// Temporary files are only removed once they are stale, since they may still be written.
+	std::time_t staleTime = std::time(nullptr) - staleTemporaryFileAge;
+	boost::system::error_code error;
+	for (fs::directory_iterator it(m_directory, error), end; !error && it != end; it.increment(error))
+	{
+		fs::path const& path = it->path();
+		std::string extension = path.extension().string();
+		if (extension != entryExtension && extension != temporaryExtension)
+			continue;
+		boost::system::error_code entryError;
+		std::uint64_t size = fs::file_size(path, entryError);
+		std::time_t lastUse = fs::last_write_time(path, entryError);
+		if (entryError)
+			continue;
+		if (extension == temporaryExtension && lastUse > staleTime)
+			continue;
+		entries.push_back({lastUse, path, size});
+		totalSize += size;
+	}
+
+	if (totalSize > m_sizeLimit)
+	{
+		std::sort(entries.begin(), entries.end(), [](Entry const& _a, Entry const& _b) {
+			return std::tie(_a.lastUse, _a.path) < std::tie(_b.lastUse, _b.path);
+		});
+		for (Entry const& entry: entries)
+		{
+			if (totalSize <= _targetSize)
+				break;
+			if (fs::remove(entry.path, error))
+				totalSize -= entry.size;
+		}
+	}
+
+	m_totalSize = totalSize;
+}
@@ -0,0 +1,81 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Cache of optimized Yul code stored in a directory.
+ */
+
+#pragma once
+
+#include <libsolutil/FixedHash.h>
+
+#include <boost/filesystem.hpp>
+
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+
+namespace solidity::yul
+{
+
+/**
+ * Stores optimized Yul code in a directory, so that it can be reused by later compilations.
+ *
+ * Each entry is stored in a separate file named after its key. Files are written under a temporary
+ * name and then renamed, which makes it safe for multiple threads and processes to share
+ * the directory. When the total size of the entries exceeds the limit, the least recently used
+ * ones are removed. Temporary files are only removed once they are an hour old, because another
+ * process may still be writing them.
+ *
+ * File system errors are not reported. An entry that cannot be read or written is treated as
+ * missing.
+ */
+class PersistentObjectCache
+{
+public:
+	/// Creates @a _directory if it does not exist yet.
+	/// @param _version identifies the compiler version. Entries stored by a different version are
+	/// never returned.
+	/// @param _sizeLimit maximum total size of the entries in bytes.
+	/// @throws boost::filesystem::filesystem_error if the directory cannot be created.
+	PersistentObjectCache(boost::filesystem::path _directory, std::string const& _version, std::uint64_t _sizeLimit);
+
+	/// @returns the content stored under @a _key or an empty optional if there is no such entry.
+	/// Marks the entry as recently used.
+	std::optional<std::string> load(util::h256 const& _key);
+	/// Stores @a _content under @a _key, replacing any existing entry.
+	void store(util::h256 const& _key, std::string const& _content);
+
+	/// @returns the total size of the entries as known to this instance.
+	std::uint64_t totalSize() const;
+
+private:
+	boost::filesystem::path entryPath(util::h256 const& _key) const;
+	/// Removes the least recently used entries until the total size is well below the limit.
+	/// Requires m_mutex to be locked.
+	void evict(std::uint64_t _targetSize);
+
+	boost::filesystem::path const m_directory;
+	util::h256 const m_versionHash;
+	std::uint64_t const m_sizeLimit;
+
+	std::mutex mutable m_mutex;
+	std::uint64_t m_totalSize = 0;
+};
+
+}
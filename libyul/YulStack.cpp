@@ -32,6 +32,7 @@
 #include <libevmasm/Assembly.h>
 #include <liblangutil/Scanner.h>
 #include <liblangutil/SourceReferenceFormatter.h>
+#include <libsolutil/Profiler.h>
 
 #include <boost/algorithm/string.hpp>
 
@@ -57,6 +58,7 @@ bool YulStack::parse(std::string const& _sourceName, std::string const& _source)
 	{
 		m_charStream = std::make_unique<CharStream>(_source, _sourceName);
 		std::shared_ptr<Scanner> scanner = std::make_shared<Scanner>(*m_charStream);
+		PROFILER_PROBE("ObjectParser", probe);
 		m_parserResult = ObjectParser(m_errorReporter, languageToDialect(m_language, m_evmVersion, m_eofVersion)).parse(scanner, false);
 	}
 	catch (UnimplementedFeatureError const& _error)
@@ -136,7 +138,8 @@ void YulStack::optimize()
 				yulOptimiserSteps,
 				yulOptimiserCleanupSteps,
 				m_optimiserSettings.expectedExecutionsPerDeployment
-			}
+			},
+			m_maxThreads
 		);
 
 		// Optimizer does not maintain correct native source locations in the AST.
@@ -153,6 +156,7 @@ bool YulStack::analyzeParsed()
 {
 	yulAssert(m_stackState >= Parsed);
 	yulAssert(m_parserResult, "");
+	PROFILER_PROBE("AsmAnalyzer", probe);
 	return analyzeParsed(*m_parserResult);
 }
 
@@ -193,6 +197,7 @@ bool YulStack::analyzeParsed(Object& _object)
 
 void YulStack::compileEVM(AbstractAssembly& _assembly, bool _optimize) const
 {
+	PROFILER_PROBE("EVMObjectCompiler", probe);
 	EVMObjectCompiler::compile(*m_parserResult, _assembly, _optimize);
 }
 
@@ -318,7 +323,9 @@ YulStack::assembleEVMWithDeployed(std::optional<std::string_view> _deployName)
 	{
 		compileEVM(adapter, optimize);
 
-		assembly.optimise(evmasm::Assembly::OptimiserSettings::translateSettings(m_optimiserSettings, m_evmVersion));
+		auto assemblySettings = evmasm::Assembly::OptimiserSettings::translateSettings(m_optimiserSettings, m_evmVersion);
+		assemblySettings.maxThreads = m_maxThreads;
+		assembly.optimise(assemblySettings);
 
 		std::optional<size_t> subIndex;
 
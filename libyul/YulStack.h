@@ -103,6 +103,10 @@ public:
 		m_objectOptimizer(_objectOptimizer ? std::move(_objectOptimizer) : std::make_shared<ObjectOptimizer>())
 	{}
 
+	/// Sets the maximum number of threads that may be used while optimizing and assembling.
+	/// Does not affect the output.
+	void setMaxThreads(size_t _maxThreads) { m_maxThreads = _maxThreads; }
+
 	/// @returns the char stream used during parsing
 	langutil::CharStream const& charStream(std::string const& _sourceName) const override;
 
@@ -171,6 +175,7 @@ private:
 	std::optional<uint8_t> m_eofVersion;
 	solidity::frontend::OptimiserSettings m_optimiserSettings;
 	langutil::DebugInfoSelection m_debugInfoSelection{};
+	size_t m_maxThreads = 1;
 
 	/// Provider of the Solidity sources that the Yul code was generated from.
 	/// Necessary when code snippets are requested as a part of debug info. When null, code snippets are omitted.
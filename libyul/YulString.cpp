@@ -0,0 +1,128 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libyul/YulString.h>
+
+#include <cstring>
+#include <mutex>
+
+using namespace solidity::yul;
+
+YulStringRepository::Handle YulStringRepository::stringToHandle(std::string_view const _string)
+{
+	if (_string.empty())
+		return { &emptyString(), emptyHash() };
+
+	std::uint64_t lookupKey = lookupHash(_string);
+	Shard& shard = m_shards[lookupKey >> (64 - shardCountBits)];
+	auto find = [&]() -> Handle const*
+	{
+		auto range = shard.lookupHashToHandle.equal_range(lookupKey);
+		for (auto it = range.first; it != range.second; ++it)
+			if (*it->second.string == _string)
+				return &it->second;
+		return nullptr;
+	};
+
+	{
+		std::shared_lock lock(shard.mutex);
+		if (Handle const* handle = find())
+			return *handle;
+	}
+
+	std::unique_lock lock(shard.mutex);
+	// Another thread may have inserted the string in the meantime.
+	if (Handle const* handle = find())
+		return *handle;
+	Handle handle{&shard.strings.emplace_back(_string), hash(_string)};
+	shard.lookupHashToHandle.emplace(lookupKey, handle);
+	return handle;
+}
+
+size_t YulStringRepository::size() const
+{
+	size_t result = 0;
+	for (Shard const& shard: m_shards)
+	{
+		std::shared_lock lock(shard.mutex);
+		result += shard.strings.size();
+	}
+	return result;
+}
+
+void YulStringRepository::reset()
+{
+	YulStringRepository& repository = instance();
+	std::lock_guard lock(repository.m_scopeMutex);
+	if (repository.m_activeScopes > 0)
+		repository.m_resetPending = true;
+	else
+		repository.clear();
+}
+
+YulStringRepository::Scope::Scope()
+{
+	YulStringRepository& repository = instance();
+	std::lock_guard lock(repository.m_scopeMutex);
+	++repository.m_activeScopes;
+}
+
+YulStringRepository::Scope::~Scope()
+{
+	YulStringRepository& repository = instance();
+	std::lock_guard lock(repository.m_scopeMutex);
+	if (--repository.m_activeScopes == 0 && repository.m_resetPending)
+		repository.clear();
+}
+
+void YulStringRepository::clear()
+{
+	for (Shard& shard: m_shards)
+	{
+		std::unique_lock lock(shard.mutex);
+		shard.lookupHashToHandle.clear();
+		shard.strings.clear();
+	}
+	m_resetPending = false;
+}
+
+std::uint64_t YulStringRepository::lookupHash(std::string_view const _string)
+{
+	auto mix = [](std::uint64_t _value) -> std::uint64_t
+	{
+		_value ^= _value >> 33;
+		_value *= 0xff51afd7ed558ccdu;
+		_value ^= _value >> 33;
+		_value *= 0xc4ceb9fe1a85ec53u;
+		_value ^= _value >> 33;
+		return _value;
+	};
+
+	std::uint64_t result = 0x9e3779b97f4a7c15u ^ _string.size();
+	char const* data = _string.data();
+	size_t remaining = _string.size();
+	for (; remaining >= 8; data += 8, remaining -= 8)
+	{
+		std::uint64_t word;
+		std::memcpy(&word, data, 8);
+		result = mix(result ^ word);
+	}
+	std::uint64_t tail = 0;
+	std::memcpy(&tail, data, remaining);
+	return mix(result ^ tail);
+}
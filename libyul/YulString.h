@@ -23,8 +23,12 @@
 
 #include <fmt/format.h>
 
+#include <array>
+#include <deque>
 #include <unordered_map>
 #include <memory>
+#include <mutex>
+#include <shared_mutex>
 #include <vector>
 #include <string>
 #include <string_view>
@@ -35,14 +39,16 @@ namespace solidity::yul
 
 /// Repository for YulStrings.
 /// Owns the string data for all YulStrings, which can be referenced by a Handle.
-/// A Handle consists of an ID (that depends on the insertion order of YulStrings and is potentially
-/// non-deterministic) and a deterministic string hash.
+/// A Handle consists of a pointer to the interned string and a deterministic string hash.
+/// Strings are only removed from the repository by reset(), so a Handle stays valid until then.
+/// The repository is split into shards that are locked independently, so YulStrings can be
+/// created and resolved concurrently from multiple threads.
 class YulStringRepository
 {
 public:
 	struct Handle
 	{
-		size_t id;
+		std::string const* string;
 		std::uint64_t hash;
 	};
 
@@ -52,26 +58,35 @@ public:
 		return inst;
 	}
 
-	Handle stringToHandle(std::string_view const _string)
+	Handle stringToHandle(std::string_view const _string);
+
+	/// @returns the number of strings in the repository.
+	size_t size() const;
+
+	/// Clear the repository.
+	/// If compilations are in progress, i.e. any Scope exists, the repository is only cleared
+	/// once the last of them ends, so it is safe to call this at any compilation boundary.
+	/// Use with care - apart from the YulStrings of the compilations in progress, there cannot be
+	/// any dangling YulString references.
+	static void reset();
+
+	/// Marks a compilation in progress for as long as it exists. The repository is not cleared
+	/// while any Scope exists, so the YulStrings created during the compilation stay valid.
+	/// Every compilation that may run concurrently with a call to reset() has to hold a Scope.
+	class Scope
 	{
-		if (_string.empty())
-			return { 0, emptyHash() };
-		std::uint64_t h = hash(_string);
-		auto range = m_hashToID.equal_range(h);
-		for (auto it = range.first; it != range.second; ++it)
-			if (*m_strings[it->second] == _string)
-				return Handle{it->second, h};
-		m_strings.emplace_back(std::make_shared<std::string>(_string));
-		size_t id = m_strings.size() - 1;
-		m_hashToID.emplace_hint(range.second, std::make_pair(h, id));
-
-		return Handle{id, h};
-	}
-	std::string const& idToString(size_t _id) const { return *m_strings.at(_id); }
+	public:
+		Scope();
+		~Scope();
+		Scope(Scope const&) = delete;
+		Scope& operator=(Scope const&) = delete;
+	};
 
+	/// Deterministic hash used for ordering YulStrings. It is only computed when a string
+	/// is added to the repository.
 	static std::uint64_t hash(std::string_view const v)
 	{
-		// FNV hash - can be replaced by a better one, e.g. xxhash64
+		// FNV hash
 		std::uint64_t hash = emptyHash();
 		for (char c: v)
 		{
@@ -82,45 +97,42 @@ public:
 		return hash;
 	}
 	static constexpr std::uint64_t emptyHash() { return 14695981039346656037u; }
-	/// Clear the repository.
-	/// Use with care - there cannot be any dangling YulString references.
-	/// If references need to be cleared manually, register the callback via
-	/// resetCallback.
-	static void reset()
+	static std::string const& emptyString()
 	{
-		for (auto const& cb: resetCallbacks())
-			cb();
-		instance() = YulStringRepository{};
+		static std::string const empty;
+		return empty;
 	}
-	/// Struct that registers a reset callback as a side-effect of its construction.
-	/// Useful as static local variable to register a reset callback once.
-	struct ResetCallback
-	{
-		ResetCallback(std::function<void()> _fun)
-		{
-			YulStringRepository::resetCallbacks().emplace_back(std::move(_fun));
-		}
-	};
 
 private:
 	YulStringRepository() = default;
 	YulStringRepository(YulStringRepository const&) = delete;
-	YulStringRepository(YulStringRepository&&) = default;
 	YulStringRepository& operator=(YulStringRepository const& _rhs) = delete;
-	YulStringRepository& operator=(YulStringRepository&& _rhs) = default;
 
-	static std::vector<std::function<void()>>& resetCallbacks()
+	/// Hash used to find strings in the repository. Processes eight bytes at a time and
+	/// is not stable across platforms, so it must not influence any output.
+	static std::uint64_t lookupHash(std::string_view const _string);
+
+	/// Removes all strings. Has to be called with m_scopeMutex locked and no Scope in existence.
+	void clear();
+
+	struct Shard
 	{
-		static std::vector<std::function<void()>> callbacks;
-		return callbacks;
-	}
+		mutable std::shared_mutex mutex;
+		/// Stable storage for the interned strings.
+		std::deque<std::string> strings;
+		std::unordered_multimap<std::uint64_t, Handle> lookupHashToHandle;
+	};
+	static constexpr size_t shardCountBits = 6;
+
+	std::array<Shard, size_t(1) << shardCountBits> m_shards;
 
-	std::vector<std::shared_ptr<std::string>> m_strings = {std::make_shared<std::string>()};
-	std::unordered_multimap<std::uint64_t, size_t> m_hashToID = {{emptyHash(), 0}};
+	std::mutex m_scopeMutex;
+	size_t m_activeScopes = 0;
+	bool m_resetPending = false;
 };
 
 /// Wrapper around handles into the YulString repository.
-/// Equality of two YulStrings is determined by comparing their ID.
+/// Equality of two YulStrings is determined by comparing their handles.
 /// The <-operator depends on the string hash and is not consistent
 /// with string comparisons (however, it is still deterministic).
 class YulString
@@ -135,32 +147,29 @@ public:
 
 	/// This is not consistent with the string <-operator!
 	/// First compares the string hashes. If they are equal
-	/// it checks for identical IDs (only identical strings have
-	/// identical IDs and identical strings do not compare as "less").
+	/// it checks for identical handles (only identical strings have
+	/// identical handles and identical strings do not compare as "less").
 	/// If the hashes are identical and the strings are distinct, it
 	/// falls back to string comparison.
 	bool operator<(YulString const& _other) const
 	{
 		if (m_handle.hash < _other.m_handle.hash) return true;
 		if (_other.m_handle.hash < m_handle.hash) return false;
-		if (m_handle.id == _other.m_handle.id) return false;
+		if (m_handle.string == _other.m_handle.string) return false;
 		return str() < _other.str();
 	}
-	/// Equality is determined based on the string ID.
-	bool operator==(YulString const& _other) const { return m_handle.id == _other.m_handle.id; }
-	bool operator!=(YulString const& _other) const { return m_handle.id != _other.m_handle.id; }
+	/// Equality is determined based on the address of the interned string.
+	bool operator==(YulString const& _other) const { return m_handle.string == _other.m_handle.string; }
+	bool operator!=(YulString const& _other) const { return m_handle.string != _other.m_handle.string; }
 
-	bool empty() const { return m_handle.id == 0; }
-	std::string const& str() const
-	{
-		return YulStringRepository::instance().idToString(m_handle.id);
-	}
+	bool empty() const { return m_handle.string->empty(); }
+	std::string const& str() const { return *m_handle.string; }
 
 	uint64_t hash() const { return m_handle.hash; }
 
 private:
-	/// Handle of the string. Assumes that the empty string has ID zero.
-	YulStringRepository::Handle m_handle{ 0, YulStringRepository::emptyHash() };
+	/// Handle of the string. The empty string is never added to the repository.
+	YulStringRepository::Handle m_handle{ &YulStringRepository::emptyString(), YulStringRepository::emptyHash() };
 };
 
 inline YulString operator "" _yulname(char const* _string, std::size_t _size)
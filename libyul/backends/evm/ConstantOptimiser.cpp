@@ -27,7 +27,9 @@
 #include <libyul/Utilities.h>
 
 #include <libsolutil/CommonData.h>
+#include <libsolutil/Parallel.h>
 
+#include <set>
 #include <variant>
 
 using namespace solidity;
@@ -36,6 +38,9 @@ using namespace solidity::util;
 
 using Representation = ConstantOptimiser::Representation;
 
+std::map<ConstantOptimiser::RepresentationKey, std::shared_ptr<Expression const>> ConstantOptimiser::s_representations;
+std::mutex ConstantOptimiser::s_representationsMutex;
+
 namespace
 {
 struct MiniEVMInterpreter
@@ -87,6 +92,68 @@ struct MiniEVMInterpreter
 
 	EVMDialect const& m_dialect;
 };
+
+/// @returns true if no expression computes @a _value more cheaply than a literal, so that
+/// searching for one can be skipped.
+bool literalIsCheapest(u256 const& _value)
+{
+	return _value < 0x10000;
+}
+
+/// Collects the values of the number literals ConstantOptimiser::visit searches representations for.
+struct NumberLiteralCollector: ASTWalker
+{
+	using ASTWalker::operator();
+
+	void visit(Expression const& _e) override
+	{
+		if (Literal const* literal = std::get_if<Literal>(&_e))
+		{
+			if (literal->kind == LiteralKind::Number && !literalIsCheapest(literal->value.value()))
+				values.insert(literal->value.value());
+		}
+		else
+			ASTWalker::visit(_e);
+	}
+
+	std::set<u256> values;
+};
+
+/// @returns a copy of a representation found by RepresentationFinder with the debug data of all
+/// its nodes set to @a _debugData.
+Expression withDebugData(Expression const& _expression, langutil::DebugData::ConstPtr const& _debugData)
+{
+	if (Literal const* literal = std::get_if<Literal>(&_expression))
+		return Literal{_debugData, literal->kind, literal->value};
+
+	FunctionCall const& call = std::get<FunctionCall>(_expression);
+	std::vector<Expression> arguments;
+	for (Expression const& argument: call.arguments)
+		arguments.emplace_back(withDebugData(argument, _debugData));
+	return FunctionCall{
+		_debugData,
+		BuiltinName{_debugData, std::get<BuiltinName>(call.functionName).handle},
+		std::move(arguments)
+	};
+}
+}
+
+void ConstantOptimiser::operator()(Block& _block)
+{
+	if (!m_representationsFound)
+	{
+		m_representationsFound = true;
+		NumberLiteralCollector collector;
+		collector(_block);
+		std::vector<u256> values(collector.values.begin(), collector.values.end());
+		std::vector<std::shared_ptr<Expression const>> representations(values.size());
+		parallelFor(values.size(), m_maxThreads, [&](size_t _index) {
+			representations[_index] = findRepresentation(values[_index]);
+		});
+		for (size_t i = 0; i < values.size(); ++i)
+			m_representations.emplace(values[i], std::move(representations[i]));
+	}
+	ASTModifier::operator()(_block);
 }
 
 void ConstantOptimiser::visit(Expression& _e)
@@ -97,20 +164,57 @@ void ConstantOptimiser::visit(Expression& _e)
 		if (literal.kind != LiteralKind::Number)
 			return;
 
-		if (
-			Expression const* repr =
-				RepresentationFinder(m_dialect, m_meter, debugDataOf(_e), m_cache)
-				.tryFindRepresentation(literal.value.value())
-		)
-			_e = ASTCopier{}.translate(*repr);
+		u256 const& value = literal.value.value();
+		if (literalIsCheapest(value))
+			return;
+		auto representation = m_representations.find(value);
+		if (representation == m_representations.end())
+			representation = m_representations.emplace(value, findRepresentation(value)).first;
+		if (representation->second)
+			_e = withDebugData(*representation->second, debugDataOf(_e));
 	}
 	else
 		ASTModifier::visit(_e);
 }
 
+std::shared_ptr<Expression const> ConstantOptimiser::findRepresentation(u256 const& _value) const
+{
+	// Every search starts with an empty cache and the same step budget, so its result only depends on the key.
+	RepresentationKey key{
+		_value,
+		m_dialect.evmVersion(),
+		m_dialect.eofVersion(),
+		m_dialect.providesObjectAccess(),
+		m_meter.isCreation(),
+		m_meter.runs()
+	};
+	{
+		std::lock_guard lock(s_representationsMutex);
+		if (auto const* representation = util::valueOrNullptr(s_representations, key))
+			return *representation;
+	}
+
+	std::map<u256, Representation> cache;
+	std::shared_ptr<Expression const> representation;
+	if (Expression const* expression = RepresentationFinder(m_dialect, m_meter, nullptr, cache).tryFindRepresentation(_value))
+		representation = std::make_shared<Expression const>(ASTCopier{}.translate(*expression));
+
+	std::lock_guard lock(s_representationsMutex);
+	if (s_representations.size() >= s_maxCachedRepresentations)
+		s_representations.clear();
+	s_representations.emplace(std::move(key), representation);
+	return representation;
+}
+
+void ConstantOptimiser::clearRepresentationCache()
+{
+	std::lock_guard lock(s_representationsMutex);
+	s_representations.clear();
+}
+
 Expression const* RepresentationFinder::tryFindRepresentation(u256 const& _value)
 {
-	if (_value < 0x10000)
+	if (literalIsCheapest(_value))
 		return nullptr;
 
 	Representation const& repr = findRepresentation(_value);
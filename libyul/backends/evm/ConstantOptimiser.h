@@ -34,6 +34,8 @@
 #include <tuple>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <optional>
 
 namespace solidity::yul
 {
@@ -43,18 +45,27 @@ class GasMeter;
 /**
  * Optimisation stage that replaces constants by expressions that compute them.
  *
+ * The representations of the distinct constants in a block are searched for before it is
+ * modified, on up to ``_maxThreads`` threads, and are shared by all optimiser instances of the process.
+ *
  * Prerequisite: None
  */
 class ConstantOptimiser: public ASTModifier
 {
 public:
-	ConstantOptimiser(EVMDialect const& _dialect, GasMeter const& _meter):
+	ConstantOptimiser(EVMDialect const& _dialect, GasMeter const& _meter, size_t _maxThreads = 1):
 		m_dialect(_dialect),
-		m_meter(_meter)
+		m_meter(_meter),
+		m_maxThreads(_maxThreads)
 	{}
 
+	void operator()(Block& _block) override;
 	void visit(Expression& _e) override;
 
+	/// Empties the cache of representations shared by the process. The optimiser does not
+	/// depend on its contents, this is only used to compare the results of cold and warm caches.
+	static void clearRepresentationCache();
+
 	struct Representation
 	{
 		std::unique_ptr<Expression> expression;
@@ -62,9 +73,22 @@ public:
 	};
 
 private:
+	/// @returns an expression that computes @a _value more cheaply than a literal or nullptr
+	/// if there is none. Looks it up in the cache shared by the process first.
+	std::shared_ptr<Expression const> findRepresentation(u256 const& _value) const;
+
 	EVMDialect const& m_dialect;
 	GasMeter const& m_meter;
-	std::map<u256, Representation> m_cache;
+	size_t m_maxThreads = 1;
+	bool m_representationsFound = false;
+	std::map<u256, std::shared_ptr<Expression const>> m_representations;
+
+	/// The value and the parameters of the dialect and the gas meter the best representation depends on.
+	using RepresentationKey = std::tuple<u256, langutil::EVMVersion, std::optional<uint8_t>, bool, bool, bigint>;
+	/// Maximum number of cached representations, the cache is cleared when it is reached.
+	static size_t constexpr s_maxCachedRepresentations = 100000;
+	static std::map<RepresentationKey, std::shared_ptr<Expression const>> s_representations;
+	static std::mutex s_representationsMutex;
 };
 
 class RepresentationFinder
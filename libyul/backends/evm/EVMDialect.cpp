@@ -33,6 +33,7 @@
 #include <range/v3/algorithm/all_of.hpp>
 #include <range/v3/view/enumerate.hpp>
 
+#include <mutex>
 #include <regex>
 #include <utility>
 #include <vector>
@@ -521,6 +522,7 @@ BuiltinFunctionForEVM const& EVMDialect::builtin(BuiltinHandle const& _handle) c
 	if (isVerbatimHandle(_handle))
 	{
 		yulAssert(_handle.id < verbatimIDOffset);
+		std::lock_guard lock(m_verbatimFunctionsMutex);
 		auto const& verbatimFunctionPtr = m_verbatimFunctions[_handle.id];
 		yulAssert(verbatimFunctionPtr);
 		return *verbatimFunctionPtr;
@@ -544,7 +546,8 @@ bool EVMDialect::reservedIdentifier(std::string_view _name) const
 EVMDialect const& EVMDialect::strictAssemblyForEVM(langutil::EVMVersion _evmVersion, std::optional<uint8_t> _eofVersion)
 {
 	static std::map<std::pair<langutil::EVMVersion, std::optional<uint8_t>>, std::unique_ptr<EVMDialect const>> dialects;
-	static YulStringRepository::ResetCallback callback{[&] { dialects.clear(); }};
+	static std::mutex mutex;
+	std::lock_guard lock(mutex);
 	if (!dialects[{_evmVersion, _eofVersion}])
 		dialects[{_evmVersion, _eofVersion}] = std::make_unique<EVMDialect>(_evmVersion, _eofVersion, false);
 	return *dialects[{_evmVersion, _eofVersion}];
@@ -553,7 +556,8 @@ EVMDialect const& EVMDialect::strictAssemblyForEVM(langutil::EVMVersion _evmVers
 EVMDialect const& EVMDialect::strictAssemblyForEVMObjects(langutil::EVMVersion _evmVersion, std::optional<uint8_t> _eofVersion)
 {
 	static std::map<std::pair<langutil::EVMVersion, std::optional<uint8_t>>, std::unique_ptr<EVMDialect const>> dialects;
-	static YulStringRepository::ResetCallback callback{[&] { dialects.clear(); }};
+	static std::mutex mutex;
+	std::lock_guard lock(mutex);
 	if (!dialects[{_evmVersion, _eofVersion}])
 		dialects[{_evmVersion, _eofVersion}] = std::make_unique<EVMDialect>(_evmVersion, _eofVersion, true);
 	return *dialects[{_evmVersion, _eofVersion}];
@@ -620,6 +624,8 @@ BuiltinHandle EVMDialect::verbatimFunction(size_t _arguments, size_t _returnVari
 	auto const verbatimIndex = toContinuousVerbatimIndex(_arguments, _returnVariables);
 	yulAssert(verbatimIndex < verbatimIDOffset);
 
+	// Dialects are shared between threads, so the lazy creation must be synchronized.
+	std::lock_guard lock(m_verbatimFunctionsMutex);
 	if (
 		auto& verbatimFunctionPtr = m_verbatimFunctions[verbatimIndex];
 		!verbatimFunctionPtr
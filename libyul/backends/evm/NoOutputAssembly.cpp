@@ -209,6 +209,8 @@ NoOutputEVMDialect::NoOutputEVMDialect(EVMDialect const& _copyFrom):
 BuiltinFunctionForEVM const& NoOutputEVMDialect::builtin(BuiltinHandle const& _handle) const
 {
 	if (isVerbatimHandle(_handle))
+	{
+		std::lock_guard lock(m_verbatimFunctionsMutex);
 		// for verbatims the modification is performed lazily as they are stored in a lookup table fashion
 		if (
 			auto& builtin = m_verbatimFunctions[_handle.id];
@@ -218,5 +220,6 @@ BuiltinFunctionForEVM const& NoOutputEVMDialect::builtin(BuiltinHandle const& _h
 			builtin = std::make_unique<BuiltinFunctionForEVM>(createVerbatimFunctionFromHandle(_handle));
 			modifyBuiltinToNoOutput(*builtin);
 		}
+	}
 	return EVMDialect::builtin(_handle);
 }
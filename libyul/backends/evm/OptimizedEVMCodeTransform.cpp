@@ -25,6 +25,7 @@
 
 #include <libevmasm/Instruction.h>
 
+#include <libsolutil/Profiler.h>
 #include <libsolutil/Visitor.h>
 #include <libsolutil/cxx20.h>
 
@@ -49,7 +50,10 @@ std::vector<StackTooDeepError> OptimizedEVMCodeTransform::run(
 )
 {
 	std::unique_ptr<CFG> dfg = ControlFlowGraphBuilder::build(_analysisInfo, _dialect, _block);
-	StackLayout stackLayout = StackLayoutGenerator::run(*dfg, !_dialect.eofVersion().has_value());
+	StackLayout stackLayout = [&]() {
+		PROFILER_PROBE("StackLayoutGenerator", probe);
+		return StackLayoutGenerator::run(*dfg, !_dialect.eofVersion().has_value());
+	}();
 
 	if (_dialect.eofVersion().has_value())
 	{
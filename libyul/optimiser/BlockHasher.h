@@ -140,6 +140,36 @@ public:
 	void operator()(FunctionCall const& _funCall) override;
 };
 
+/**
+ * Computes hashes of statements that are likely different for syntactically different statements.
+ * In contrast to the BlockHasher, the names of variables and functions as well as the order
+ * of switch cases are taken into account, so statements with equal hashes are likely identical
+ * and not only equivalent up to renaming.
+ * This means this hasher should only be used on disambiguated sources.
+ */
+class StatementHasher: public ASTWalker, public ASTHasherBase
+{
+public:
+	static uint64_t run(Statement const& _statement);
+
+	using ASTWalker::operator();
+
+	void operator()(Literal const&) override;
+	void operator()(Identifier const&) override;
+	void operator()(FunctionCall const& _funCall) override;
+	void operator()(ExpressionStatement const& _statement) override;
+	void operator()(Assignment const& _assignment) override;
+	void operator()(VariableDeclaration const& _varDecl) override;
+	void operator()(If const& _if) override;
+	void operator()(Switch const& _switch) override;
+	void operator()(FunctionDefinition const&) override;
+	void operator()(ForLoop const&) override;
+	void operator()(Break const&) override;
+	void operator()(Continue const&) override;
+	void operator()(Leave const&) override;
+	void operator()(Block const& _block) override;
+};
+
 struct ExpressionHash
 {
 	uint64_t operator()(Expression const& _expression) const
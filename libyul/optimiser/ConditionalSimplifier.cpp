@@ -30,7 +30,9 @@ void ConditionalSimplifier::run(OptimiserStepContext& _context, Block& _ast)
 {
 	ConditionalSimplifier{
 		_context.dialect,
-		ControlFlowSideEffectsCollector{_context.dialect, _ast}.functionSideEffectsNamed()
+		_context.controlFlowSideEffects ?
+			*_context.controlFlowSideEffects :
+			ControlFlowSideEffectsCollector{_context.dialect, _ast}.functionSideEffectsNamed()
 	}(_ast);
 }
 
@@ -31,7 +31,9 @@ void ConditionalUnsimplifier::run(OptimiserStepContext& _context, Block& _ast)
 {
 	ConditionalUnsimplifier{
 		_context.dialect,
-		ControlFlowSideEffectsCollector{_context.dialect, _ast}.functionSideEffectsNamed()
+		_context.controlFlowSideEffects ?
+			*_context.controlFlowSideEffects :
+			ControlFlowSideEffectsCollector{_context.dialect, _ast}.functionSideEffectsNamed()
 	}(_ast);
 }
 
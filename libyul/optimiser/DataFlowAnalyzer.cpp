@@ -32,7 +32,6 @@
 #include <libyul/Utilities.h>
 
 #include <libsolutil/CommonData.h>
-#include <libsolutil/cxx20.h>
 
 #include <variant>
 
@@ -68,23 +67,23 @@ void DataFlowAnalyzer::operator()(ExpressionStatement& _statement)
 		if (auto vars = isSimpleStore(StoreLoadLocation::Storage, _statement))
 		{
 			ASTModifier::operator()(_statement);
-			cxx20::erase_if(m_state.environment.storage, mapTuple([&](auto&& key, auto&& value) {
+			m_state.environment.storage.eraseIf([&](YulName _key, YulName _value) {
 				return
-					!m_knowledgeBase.knownToBeDifferent(vars->first, key) &&
-					vars->second != value;
-			}));
-			m_state.environment.storage[vars->first] = vars->second;
+					!m_knowledgeBase.knownToBeDifferent(vars->first, _key) &&
+					vars->second != _value;
+			});
+			m_state.environment.storage.set(vars->first, vars->second);
 			return;
 		}
 		else if (auto vars = isSimpleStore(StoreLoadLocation::Memory, _statement))
 		{
 			ASTModifier::operator()(_statement);
-			cxx20::erase_if(m_state.environment.memory, mapTuple([&](auto&& key, auto&& /* value */) {
-				return !m_knowledgeBase.knownToBeDifferentByAtLeast32(vars->first, key);
-			}));
+			m_state.environment.memory.eraseIf([&](YulName _key, YulName /* _value */) {
+				return !m_knowledgeBase.knownToBeDifferentByAtLeast32(vars->first, _key);
+			});
 			// TODO erase keccak knowledge, but in a more clever way
-			m_state.environment.keccak = {};
-			m_state.environment.memory[vars->first] = vars->second;
+			m_state.environment.keccak.clear();
+			m_state.environment.memory.set(vars->first, vars->second);
 			return;
 		}
 	}
@@ -122,10 +121,10 @@ void DataFlowAnalyzer::operator()(VariableDeclaration& _varDecl)
 void DataFlowAnalyzer::operator()(If& _if)
 {
 	clearKnowledgeIfInvalidated(*_if.condition);
-	Environment preEnvironment = m_state.environment;
+	startBranch();
 
 	ASTModifier::operator()(_if);
-	joinKnowledge(preEnvironment);
+	joinBranch();
 
 	clearValues(assignedVariableNames(_if.body));
 }
@@ -137,9 +136,9 @@ void DataFlowAnalyzer::operator()(Switch& _switch)
 	std::set<YulName> assignedVariables;
 	for (auto& _case: _switch.cases)
 	{
-		Environment preEnvironment = m_state.environment;
+		startBranch();
 		(*this)(_case.body);
-		joinKnowledge(preEnvironment);
+		joinBranch();
 
 		std::set<YulName> variables = assignedVariableNames(_case.body);
 		assignedVariables += variables;
@@ -220,7 +219,7 @@ void DataFlowAnalyzer::operator()(Block& _block)
 
 std::optional<YulName> DataFlowAnalyzer::storageValue(YulName _key) const
 {
-	if (YulName const* value = valueOrNullptr(m_state.environment.storage, _key))
+	if (YulName const* value = m_state.environment.storage.find(_key))
 		return *value;
 	else
 		return std::nullopt;
@@ -228,7 +227,7 @@ std::optional<YulName> DataFlowAnalyzer::storageValue(YulName _key) const
 
 std::optional<YulName> DataFlowAnalyzer::memoryValue(YulName _key) const
 {
-	if (YulName const* value = valueOrNullptr(m_state.environment.memory, _key))
+	if (YulName const* value = m_state.environment.memory.find(_key))
 		return *value;
 	else
 		return std::nullopt;
@@ -236,7 +235,7 @@ std::optional<YulName> DataFlowAnalyzer::memoryValue(YulName _key) const
 
 std::optional<YulName> DataFlowAnalyzer::keccakValue(YulName _start, YulName _length) const
 {
-	if (YulName const* value = valueOrNullptr(m_state.environment.keccak, std::make_pair(_start, _length)))
+	if (YulName const* value = m_state.environment.keccak.find(std::make_pair(_start, _length)))
 		return *value;
 	else
 		return std::nullopt;
@@ -266,20 +265,20 @@ void DataFlowAnalyzer::handleAssignment(std::set<YulName> const& _variables, Exp
 	auto const& referencedVariables = movableChecker.referencedVariables();
 	for (auto const& name: _variables)
 	{
-		m_state.references[name] = referencedVariables;
+		setReferences(name, referencedVariables);
 		if (!_isDeclaration)
 		{
 			// assignment to slot denoted by "name"
 			m_state.environment.storage.erase(name);
 			// assignment to slot contents denoted by "name"
-			cxx20::erase_if(m_state.environment.storage, mapTuple([&name](auto&& /* key */, auto&& value) { return value == name; }));
+			m_state.environment.storage.eraseIf([&name](YulName /* _key */, YulName _value) { return _value == name; });
 			// assignment to slot denoted by "name"
 			m_state.environment.memory.erase(name);
 			// assignment to slot contents denoted by "name"
-			cxx20::erase_if(m_state.environment.keccak, [&name](auto&& _item) {
-				return _item.first.first == name || _item.first.second == name || _item.second == name;
+			m_state.environment.keccak.eraseIf([&name](std::pair<YulName, YulName> const& _key, YulName _value) {
+				return _key.first == name || _key.second == name || _value == name;
 			});
-			cxx20::erase_if(m_state.environment.memory, mapTuple([&name](auto&& /* key */, auto&& value) { return value == name; }));
+			m_state.environment.memory.eraseIf([&name](YulName /* _key */, YulName _value) { return _value == name; });
 		}
 	}
 
@@ -292,11 +291,11 @@ void DataFlowAnalyzer::handleAssignment(std::set<YulName> const& _variables, Exp
 			// On the other hand, if we knew the value in the slot
 			// already, then the sload() / mload() would have been replaced by a variable anyway.
 			if (auto key = isSimpleLoad(StoreLoadLocation::Memory, *_value))
-				m_state.environment.memory[*key] = variable;
+				m_state.environment.memory.set(*key, variable);
 			else if (auto key = isSimpleLoad(StoreLoadLocation::Storage, *_value))
-				m_state.environment.storage[*key] = variable;
+				m_state.environment.storage.set(*key, variable);
 			else if (auto arguments = isKeccak(*_value))
-				m_state.environment.keccak[*arguments] = variable;
+				m_state.environment.keccak.set(*arguments, variable);
 		}
 	}
 }
@@ -309,10 +308,7 @@ void DataFlowAnalyzer::pushScope(bool _functionScope)
 void DataFlowAnalyzer::popScope()
 {
 	for (auto const& name: m_variableScopes.back().variables)
-	{
-		m_state.value.erase(name);
-		m_state.references.erase(name);
-	}
+		eraseValue(name);
 	m_variableScopes.pop_back();
 }
 
@@ -334,31 +330,56 @@ void DataFlowAnalyzer::clearValues(std::set<YulName> _variables)
 	// First clear storage knowledge, because we do not have to clear
 	// storage knowledge of variables whose expression has changed,
 	// since the value is still unchanged.
-	auto eraseCondition = mapTuple([&_variables](auto&& key, auto&& value) {
-		return _variables.count(key) || _variables.count(value);
-	});
-	cxx20::erase_if(m_state.environment.storage, eraseCondition);
-	cxx20::erase_if(m_state.environment.memory, eraseCondition);
-	cxx20::erase_if(m_state.environment.keccak, [&_variables](auto&& _item) {
+	auto eraseCondition = [&_variables](YulName _key, YulName _value) {
+		return _variables.count(_key) || _variables.count(_value);
+	};
+	m_state.environment.storage.eraseIf(eraseCondition);
+	m_state.environment.memory.eraseIf(eraseCondition);
+	m_state.environment.keccak.eraseIf([&_variables](std::pair<YulName, YulName> const& _key, YulName _value) {
 		return
-			_variables.count(_item.first.first) ||
-			_variables.count(_item.first.second) ||
-			_variables.count(_item.second);
+			_variables.count(_key.first) ||
+			_variables.count(_key.second) ||
+			_variables.count(_value);
 	});
 
 	// Also clear variables that reference variables to be cleared.
 	std::set<YulName> referencingVariables;
 	for (auto const& variableToClear: _variables)
-		for (auto const& [ref, names]: m_state.references)
-			if (names.count(variableToClear))
-				referencingVariables.emplace(ref);
+		if (std::set<YulName> const* referencing = valueOrNullptr(m_state.referencedBy, variableToClear))
+			referencingVariables += *referencing;
 
 	// Clear the value and update the reference relation.
 	for (auto const& name: _variables + referencingVariables)
-	{
-		m_state.value.erase(name);
-		m_state.references.erase(name);
-	}
+		eraseValue(name);
+}
+
+void DataFlowAnalyzer::setReferences(YulName _variable, std::set<YulName> const& _referencedVariables)
+{
+	eraseReferences(_variable);
+	for (YulName referenced: _referencedVariables)
+		m_state.referencedBy[referenced].insert(_variable);
+	m_state.references[_variable] = _referencedVariables;
+}
+
+void DataFlowAnalyzer::eraseValue(YulName _variable)
+{
+	m_state.value.erase(_variable);
+	eraseReferences(_variable);
+}
+
+void DataFlowAnalyzer::eraseReferences(YulName _variable)
+{
+	auto references = m_state.references.find(_variable);
+	if (references == m_state.references.end())
+		return;
+	for (YulName referenced: references->second)
+		if (auto referencing = m_state.referencedBy.find(referenced); referencing != m_state.referencedBy.end())
+		{
+			referencing->second.erase(_variable);
+			if (referencing->second.empty())
+				m_state.referencedBy.erase(referencing);
+		}
+	m_state.references.erase(references);
 }
 
 void DataFlowAnalyzer::assignValue(YulName _variable, Expression const* _value)
@@ -458,29 +479,31 @@ std::optional<std::pair<YulName, YulName>> DataFlowAnalyzer::isKeccak(Expression
 	return std::nullopt;
 }
 
-void DataFlowAnalyzer::joinKnowledge(Environment const& _olderEnvironment)
+void DataFlowAnalyzer::Environment::startBranch()
 {
-	if (!m_analyzeStores)
-		return;
-	joinKnowledgeHelper(m_state.environment.storage, _olderEnvironment.storage);
-	joinKnowledgeHelper(m_state.environment.memory, _olderEnvironment.memory);
-	cxx20::erase_if(m_state.environment.keccak, mapTuple([&_olderEnvironment](auto&& key, auto&& currentValue) {
-		YulName const* oldValue = valueOrNullptr(_olderEnvironment.keccak, key);
-		return !oldValue || *oldValue != currentValue;
-	}));
+	storage.startBranch();
+	memory.startBranch();
+	keccak.startBranch();
+}
+
+void DataFlowAnalyzer::Environment::joinBranch()
+{
+	// This also works for memory because the start of the branch is an older version
+	// of the current state and thus any overlapping write would have cleared the keys
+	// that are not known to be different already.
+	storage.joinBranch();
+	memory.joinBranch();
+	keccak.joinBranch();
 }
 
-void DataFlowAnalyzer::joinKnowledgeHelper(
-	std::unordered_map<YulName, YulName>& _this,
-	std::unordered_map<YulName, YulName> const& _older
-)
+void DataFlowAnalyzer::startBranch()
 {
-	// We clear if the key does not exist in the older map or if the value is different.
-	// This also works for memory because _older is an "older version"
-	// of m_state.environment.memory and thus any overlapping write would have cleared the keys
-	// that are not known to be different inside m_state.environment.memory already.
-	cxx20::erase_if(_this, mapTuple([&_older](auto&& key, auto&& currentValue){
-		YulName const* oldValue = valueOrNullptr(_older, key);
-		return !oldValue || *oldValue != currentValue;
-	}));
+	if (m_analyzeStores)
+		m_state.environment.startBranch();
+}
+
+void DataFlowAnalyzer::joinBranch()
+{
+	if (m_analyzeStores)
+		m_state.environment.joinBranch();
 }
@@ -31,9 +31,13 @@
 
 #include <libsolutil/Numeric.h>
 #include <libsolutil/Common.h>
+#include <libsolutil/CommonData.h>
 
 #include <map>
+#include <optional>
 #include <set>
+#include <unordered_map>
+#include <vector>
 
 namespace solidity::yul
 {
@@ -105,7 +109,7 @@ public:
 	/// @returns the current value of the given variable, if known - always movable.
 	AssignedValue const* variableValue(YulName _variable) const { return util::valueOrNullptr(m_state.value, _variable); }
 	std::set<YulName> const* references(YulName _variable) const { return util::valueOrNullptr(m_state.references, _variable); }
-	std::map<YulName, AssignedValue> const& allValues() const { return m_state.value; }
+	std::unordered_map<YulName, AssignedValue> const& allValues() const { return m_state.value; }
 	std::optional<YulName> storageValue(YulName _key) const;
 	std::optional<YulName> memoryValue(YulName _key) const;
 	std::optional<YulName> keccakValue(YulName _start, YulName _length) const;
@@ -168,33 +172,115 @@ protected:
 	std::map<FunctionHandle, SideEffects> m_functionSideEffects;
 
 private:
+	/// Map from keys to variables that can remember the point in the control-flow where a branch
+	/// starts and later join the knowledge at the end of the branch with the knowledge at its
+	/// start. Instead of copying the whole map at the start of a branch, it records the previous
+	/// values of the entries that are changed or removed inside the branch.
+	template <typename Container>
+	class BranchingMap
+	{
+	public:
+		using Key = typename Container::key_type;
+
+		YulName const* find(Key const& _key) const { return util::valueOrNullptr(m_data, _key); }
+		void set(Key const& _key, YulName _value)
+		{
+			record(_key);
+			m_data[_key] = _value;
+		}
+		void erase(Key const& _key)
+		{
+			record(_key);
+			m_data.erase(_key);
+		}
+		template <typename Predicate>
+		void eraseIf(Predicate _predicate)
+		{
+			for (auto it = m_data.begin(); it != m_data.end();)
+				if (_predicate(it->first, it->second))
+				{
+					record(it->first);
+					it = m_data.erase(it);
+				}
+				else
+					++it;
+		}
+		void clear()
+		{
+			if (!m_branches.empty())
+				for (auto const& [key, value]: m_data)
+					m_branches.back().try_emplace(key, value);
+			m_data.clear();
+		}
+
+		void startBranch() { m_branches.emplace_back(); }
+		/// Removes the entries that were added or changed since the start of the innermost branch,
+		/// i.e. keeps only the knowledge that was valid at the start and is still valid now.
+		/// This only works because the current state is a direct successor of the start of the branch.
+		void joinBranch()
+		{
+			yulAssert(!m_branches.empty());
+			std::map<Key, std::optional<YulName>> changes = std::move(m_branches.back());
+			m_branches.pop_back();
+			for (auto const& [key, previousValue]: changes)
+				if (YulName const* value = find(key); value && (!previousValue || *previousValue != *value))
+					m_data.erase(key);
+			// Changes inside the branch are changes of the enclosing branch as well.
+			if (!m_branches.empty())
+				for (auto&& [key, previousValue]: changes)
+					m_branches.back().try_emplace(key, std::move(previousValue));
+		}
+
+	private:
+		void record(Key const& _key)
+		{
+			if (m_branches.empty() || m_branches.back().count(_key))
+				return;
+			std::optional<YulName> previousValue;
+			if (YulName const* value = find(_key))
+				previousValue = *value;
+			m_branches.back().emplace(_key, previousValue);
+		}
+
+		Container m_data;
+		/// For each enclosing branch, the values of the entries before they were first changed in it.
+		std::vector<std::map<Key, std::optional<YulName>>> m_branches;
+	};
+
 	struct Environment
 	{
-		std::unordered_map<YulName, YulName> storage;
-		std::unordered_map<YulName, YulName> memory;
+		BranchingMap<std::unordered_map<YulName, YulName>> storage;
+		BranchingMap<std::unordered_map<YulName, YulName>> memory;
 		/// If keccak[s, l] = y then y := keccak256(s, l) occurs in the code.
-		std::map<std::pair<YulName, YulName>, YulName> keccak;
+		BranchingMap<std::map<std::pair<YulName, YulName>, YulName>> keccak;
+
+		void startBranch();
+		void joinBranch();
 	};
 	struct State
 	{
 		/// Current values of variables, always movable.
-		std::map<YulName, AssignedValue> value;
+		std::unordered_map<YulName, AssignedValue> value;
 		/// m_references[a].contains(b) <=> the current expression assigned to a references b
 		std::unordered_map<YulName, std::set<YulName>> references;
+		/// referencedBy[b].contains(a) <=> references[a].contains(b)
+		std::unordered_map<YulName, std::set<YulName>> referencedBy;
 
 		Environment environment;
 	};
 
-	/// Joins knowledge about storage and memory with an older point in the control-flow.
-	/// This only works if the current state is a direct successor of the older point,
-	/// i.e. `_olderState.storage` and `_olderState.memory` cannot have additional changes.
-	/// Does nothing if memory and storage analysis is disabled / ignored.
-	void joinKnowledge(Environment const& _olderEnvironment);
-
-	static void joinKnowledgeHelper(
-		std::unordered_map<YulName, YulName>& _thisData,
-		std::unordered_map<YulName, YulName> const& _olderData
-	);
+	/// Starts a branch of the control-flow for the knowledge about storage and memory.
+	void startBranch();
+	/// Joins the knowledge about storage and memory at the end of a branch with the knowledge
+	/// at its start. Does nothing if memory and storage analysis is disabled / ignored.
+	void joinBranch();
+
+	/// Sets the variables referenced by the value of @a _variable, keeping ``referencedBy`` in sync.
+	void setReferences(YulName _variable, std::set<YulName> const& _referencedVariables);
+	/// Forgets the value of @a _variable and what it references.
+	void eraseValue(YulName _variable);
+	/// Forgets what the value of @a _variable references, keeping ``referencedBy`` in sync.
+	void eraseReferences(YulName _variable);
 
 	State m_state;
 
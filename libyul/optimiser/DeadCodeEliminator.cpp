@@ -36,10 +36,11 @@ using namespace solidity::yul;
 
 void DeadCodeEliminator::run(OptimiserStepContext& _context, Block& _ast)
 {
-	ControlFlowSideEffectsCollector sideEffects(_context.dialect, _ast);
 	DeadCodeEliminator{
 		_context.dialect,
-		sideEffects.functionSideEffectsNamed()
+		_context.controlFlowSideEffects ?
+			*_context.controlFlowSideEffects :
+			ControlFlowSideEffectsCollector{_context.dialect, _ast}.functionSideEffectsNamed()
 	}(_ast);
 }
 
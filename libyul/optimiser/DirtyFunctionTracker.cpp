@@ -0,0 +1,309 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Helper of the optimiser suite that avoids re-running steps on functions they already left unchanged.
+ */
+
+#include <libyul/optimiser/DirtyFunctionTracker.h>
+
+#include <libyul/optimiser/ASTWalker.h>
+#include <libyul/optimiser/BlockFlattener.h>
+#include <libyul/optimiser/BlockHasher.h>
+#include <libyul/optimiser/CallGraphGenerator.h>
+#include <libyul/optimiser/CommonSubexpressionEliminator.h>
+#include <libyul/optimiser/ConditionalSimplifier.h>
+#include <libyul/optimiser/ConditionalUnsimplifier.h>
+#include <libyul/optimiser/ControlFlowSimplifier.h>
+#include <libyul/optimiser/DeadCodeEliminator.h>
+#include <libyul/optimiser/EqualStoreEliminator.h>
+#include <libyul/optimiser/ExpressionSimplifier.h>
+#include <libyul/optimiser/ExpressionSplitter.h>
+#include <libyul/optimiser/ForLoopConditionIntoBody.h>
+#include <libyul/optimiser/ForLoopConditionOutOfBody.h>
+#include <libyul/optimiser/ForLoopInitRewriter.h>
+#include <libyul/optimiser/LoadResolver.h>
+#include <libyul/optimiser/LoopInvariantCodeMotion.h>
+#include <libyul/optimiser/OptimiserStep.h>
+#include <libyul/optimiser/Rematerialiser.h>
+#include <libyul/optimiser/SSAReverser.h>
+#include <libyul/optimiser/SSATransform.h>
+#include <libyul/optimiser/Semantics.h>
+#include <libyul/optimiser/StructuralSimplifier.h>
+#include <libyul/optimiser/UnusedAssignEliminator.h>
+#include <libyul/optimiser/UnusedStoreEliminator.h>
+#include <libyul/optimiser/VarDeclInitializer.h>
+#include <libyul/AST.h>
+#include <libyul/ControlFlowSideEffectsCollector.h>
+#include <libyul/Dialect.h>
+#include <libyul/Utilities.h>
+
+#include <libsolutil/CommonData.h>
+#include <libsolutil/Parallel.h>
+
+#include <algorithm>
+
+using namespace solidity;
+using namespace solidity::util;
+using namespace solidity::yul;
+
+namespace
+{
+
+/// Collects the user-defined functions called from a piece of code and whether it uses ``msize``
+/// and counts its statements and expressions.
+class CallCollector: public ASTWalker
+{
+public:
+	explicit CallCollector(Dialect const& _dialect): m_dialect(_dialect) {}
+
+	using ASTWalker::operator();
+	using ASTWalker::visit;
+	void visit(Statement const& _statement) override
+	{
+		++size;
+		ASTWalker::visit(_statement);
+	}
+	void visit(Expression const& _expression) override
+	{
+		++size;
+		ASTWalker::visit(_expression);
+	}
+	void operator()(FunctionCall const& _funCall) override
+	{
+		ASTWalker::operator()(_funCall);
+		if (BuiltinFunction const* builtin = resolveBuiltinFunction(_funCall.functionName, m_dialect))
+		{
+			if (builtin->isMSize)
+				containsMSize = true;
+		}
+		else
+			callees.insert(std::get<Identifier>(_funCall.functionName).name);
+	}
+
+	std::set<YulName> callees;
+	bool containsMSize = false;
+	size_t size = 0;
+
+private:
+	Dialect const& m_dialect;
+};
+
+bool functionGrouped(Block const& _ast)
+{
+	if (_ast.statements.empty() || !std::holds_alternative<Block>(_ast.statements.front()))
+		return false;
+	for (size_t i = 1; i < _ast.statements.size(); ++i)
+		if (!std::holds_alternative<FunctionDefinition>(_ast.statements[i]))
+			return false;
+	return true;
+}
+
+void combine(uint64_t& _hash, uint64_t _value)
+{
+	_hash = (_hash ^ _value) * HasherBase::fnvPrime;
+}
+
+}
+
+void DirtyFunctionTracker::run(OptimiserStep const& _step, OptimiserStepContext& _context, Block& _ast)
+{
+	StepTraits const* traits = stepTraits(_step.name);
+	if (!traits || !functionGrouped(_ast))
+	{
+		_step.run(_context, _ast);
+		resetCache();
+		return;
+	}
+
+	if (m_statements.empty())
+	{
+		for (Statement const& statement: _ast.statements)
+			m_statements[statementName(statement)] = scan(statement);
+		yulAssert(m_statements.size() == _ast.statements.size());
+	}
+
+	bool containsMSize = false;
+	for (auto const& statement: m_statements)
+		containsMSize = containsMSize || statement.second.containsMSize;
+
+	std::map<YulName, uint64_t>& stable = m_stableStatements[_step.name];
+	std::map<YulName, uint64_t> keys;
+	std::set<YulName> dirty;
+	for (auto const& statement: m_statements)
+	{
+		YulName name = statement.first;
+		keys[name] = key(name, *traits, containsMSize);
+		if (!stable.count(name) || stable.at(name) != keys.at(name))
+			dirty.insert(name);
+	}
+	if (dirty.empty())
+		return;
+
+	size_t dirtySize = 0;
+	for (YulName name: dirty)
+		dirtySize += m_statements.at(name).size;
+	size_t const threads =
+		traits->createsNames ?
+		1 :
+		std::min(_context.maxThreads, dirtySize / std::max<size_t>(m_minSizePerThread, 1));
+	bool concurrent = threads > 1 && dirty.size() > 1;
+	if (!concurrent && dirty.size() == _ast.statements.size())
+		_step.run(_context, _ast);
+	else
+	{
+		// The hidden functions are still needed to determine the side-effects of their callers.
+		OptimiserStepContext context = _context;
+		std::map<FunctionHandle, SideEffects> functionSideEffects;
+		std::map<YulName, ControlFlowSideEffects> controlFlowSideEffects;
+		if (traits->sideEffects)
+		{
+			functionSideEffects = SideEffectsPropagator::sideEffects(m_dialect, CallGraphGenerator::callGraph(_ast));
+			context.functionSideEffects = &functionSideEffects;
+		}
+		if (traits->controlFlowSideEffects)
+		{
+			controlFlowSideEffects = ControlFlowSideEffectsCollector{m_dialect, _ast}.functionSideEffectsNamed();
+			context.controlFlowSideEffects = &controlFlowSideEffects;
+		}
+		if (traits->msize)
+			context.containsMSize = containsMSize;
+
+		std::vector<size_t> positions;
+		std::vector<Block> parts;
+		for (size_t i = 0; i < _ast.statements.size(); ++i)
+			if (dirty.count(statementName(_ast.statements[i])))
+			{
+				positions.push_back(i);
+				if (concurrent || parts.empty())
+					parts.emplace_back(Block{_ast.debugData, {}});
+				parts.back().statements.emplace_back(std::move(_ast.statements[i]));
+			}
+
+		auto restore = [&]() {
+			size_t position = 0;
+			for (Block& part: parts)
+				for (Statement& statement: part.statements)
+					_ast.statements[positions.at(position++)] = std::move(statement);
+			yulAssert(position == positions.size(), "Step changed the number of top-level statements.");
+		};
+		try
+		{
+			parallelFor(parts.size(), concurrent ? threads : 1, [&](size_t _index) {
+				_step.run(context, parts[_index]);
+			});
+		}
+		catch (...)
+		{
+			restore();
+			throw;
+		}
+		restore();
+	}
+
+	for (Statement const& statement: _ast.statements)
+	{
+		YulName name = statementName(statement);
+		if (!dirty.count(name))
+			continue;
+		StatementInfo& info = m_statements.at(name);
+		StatementInfo newInfo = scan(statement);
+		if (newInfo.hash == info.hash)
+			stable[name] = keys.at(name);
+		else
+			stable.erase(name);
+		info = std::move(newInfo);
+	}
+}
+
+DirtyFunctionTracker::StepTraits const* DirtyFunctionTracker::stepTraits(std::string const& _stepName)
+{
+	StepTraits const local{};
+	StepTraits const sideEffects{true, false, false, false};
+	StepTraits const sideEffectsAndMSize{true, false, true, false};
+	StepTraits const controlFlowSideEffects{false, true, false, false};
+	StepTraits const createsNames{false, false, false, true};
+	static std::map<std::string, StepTraits> const traits{
+		{BlockFlattener::name, local},
+		{ControlFlowSimplifier::name, local},
+		{ExpressionSimplifier::name, local},
+		{ExpressionSplitter::name, createsNames},
+		{ForLoopConditionIntoBody::name, local},
+		{ForLoopConditionOutOfBody::name, local},
+		{ForLoopInitRewriter::name, local},
+		{LiteralRematerialiser::name, local},
+		{Rematerialiser::name, local},
+		{SSAReverser::name, local},
+		{SSATransform::name, createsNames},
+		{StructuralSimplifier::name, local},
+		{VarDeclInitializer::name, local},
+		{CommonSubexpressionEliminator::name, sideEffects},
+		{EqualStoreEliminator::name, sideEffects},
+		{LoadResolver::name, sideEffectsAndMSize},
+		{LoopInvariantCodeMotion::name, sideEffectsAndMSize},
+		{ConditionalSimplifier::name, controlFlowSideEffects},
+		{ConditionalUnsimplifier::name, controlFlowSideEffects},
+		{DeadCodeEliminator::name, controlFlowSideEffects},
+		{UnusedAssignEliminator::name, controlFlowSideEffects},
+		{UnusedStoreEliminator::name, {true, true, true, false}},
+	};
+	return util::valueOrNullptr(traits, _stepName);
+}
+
+YulName DirtyFunctionTracker::statementName(Statement const& _statement)
+{
+	if (auto const* function = std::get_if<FunctionDefinition>(&_statement))
+		return function->name;
+	return {};
+}
+
+DirtyFunctionTracker::StatementInfo DirtyFunctionTracker::scan(Statement const& _statement) const
+{
+	CallCollector collector{m_dialect};
+	collector.visit(_statement);
+	return {StatementHasher::run(_statement), std::move(collector.callees), collector.containsMSize, collector.size};
+}
+
+uint64_t DirtyFunctionTracker::key(YulName _name, StepTraits const& _traits, bool _containsMSize) const
+{
+	uint64_t result = m_statements.at(_name).hash;
+	if (_traits.sideEffects || _traits.controlFlowSideEffects)
+		for (YulName callee: transitiveCallees({_name}))
+			if (callee != _name)
+			{
+				combine(result, callee.hash());
+				combine(result, m_statements.at(callee).hash);
+			}
+	if (_traits.msize)
+		combine(result, _containsMSize);
+	return result;
+}
+
+std::set<YulName> DirtyFunctionTracker::transitiveCallees(std::set<YulName> const& _names) const
+{
+	std::set<YulName> result;
+	std::vector<YulName> toVisit(_names.begin(), _names.end());
+	while (!toVisit.empty())
+	{
+		YulName name = toVisit.back();
+		toVisit.pop_back();
+		for (YulName callee: m_statements.at(name).callees)
+			if (m_statements.count(callee) && result.insert(callee).second)
+				toVisit.push_back(callee);
+	}
+	return result;
+}
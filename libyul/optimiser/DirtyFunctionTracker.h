@@ -0,0 +1,125 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Helper of the optimiser suite that avoids re-running steps on functions they already left unchanged.
+ */
+
+#pragma once
+
+#include <libyul/ASTForward.h>
+#include <libyul/YulName.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <set>
+#include <string>
+
+namespace solidity::yul
+{
+
+class Dialect;
+struct OptimiserStep;
+struct OptimiserStepContext;
+
+/**
+ * Runs optimiser steps on a function-grouped AST while tracking which of its top-level
+ * statements (the code block and the function definitions) are "dirty".
+ *
+ * For steps whose effect on a function only depends on the function itself and on
+ * the side-effects of the functions it calls, a function (or the code block) is hidden from
+ * the step if an earlier run of the same step did not change it and neither the function
+ * nor any of its (transitive) callees changed since then. Because the steps are deterministic,
+ * running them on the hidden functions would not cause any changes either.
+ * The side-effects of all functions are computed once on the whole AST and passed to the step
+ * through the OptimiserStepContext.
+ *
+ * If the context allows more than one thread, the remaining functions are processed
+ * concurrently, each in a block of its own, unless the step creates new names.
+ * Since starting threads for every step is not free, each thread has to get at least
+ * ``_minSizePerThread`` AST nodes worth of functions, and smaller ASTs are processed serially.
+ *
+ * Statements are compared using the StatementHasher, which takes names into account.
+ * All other steps are run on the whole AST.
+ *
+ * Prerequisite: Disambiguator, FunctionHoister
+ */
+class DirtyFunctionTracker
+{
+public:
+	static size_t constexpr defaultMinSizePerThread = 2000;
+
+	explicit DirtyFunctionTracker(Dialect const& _dialect, size_t _minSizePerThread = defaultMinSizePerThread):
+		m_dialect(_dialect),
+		m_minSizePerThread(_minSizePerThread)
+	{}
+
+	/// Runs @a _step on @a _ast, skipping the functions that are known to be stable for it
+	/// and using up to ``_context.maxThreads`` threads.
+	void run(OptimiserStep const& _step, OptimiserStepContext& _context, Block& _ast);
+
+	/// Drops the cached hashes of the top-level statements. Has to be called whenever the AST
+	/// was modified by something other than ``run``. The information about the stability
+	/// of functions is kept since it is keyed by the contents of the functions.
+	void resetCache() { m_statements.clear(); }
+
+private:
+	/// What a step looks at apart from the function it processes, and whether it creates new names.
+	struct StepTraits
+	{
+		bool sideEffects = false;
+		bool controlFlowSideEffects = false;
+		bool msize = false;
+		/// Steps that create names cannot process functions concurrently because the
+		/// names have to be assigned in a deterministic order.
+		bool createsNames = false;
+	};
+
+	/// Cached facts about a top-level statement.
+	struct StatementInfo
+	{
+		uint64_t hash = 0;
+		/// User-defined functions called from the statement.
+		std::set<YulName> callees;
+		bool containsMSize = false;
+		/// Number of statements and expressions in the statement.
+		size_t size = 0;
+	};
+
+	/// @returns the traits of the step with the given name or nullptr if the step
+	/// has to see the whole AST.
+	static StepTraits const* stepTraits(std::string const& _stepName);
+
+	/// @returns the function name of a top-level statement, or the empty name for the code block.
+	static YulName statementName(Statement const& _statement);
+
+	StatementInfo scan(Statement const& _statement) const;
+	/// @returns a hash of the statement with the given name and everything a step with the
+	/// given traits may look at when processing it.
+	uint64_t key(YulName _name, StepTraits const& _traits, bool _containsMSize) const;
+	std::set<YulName> transitiveCallees(std::set<YulName> const& _names) const;
+
+	Dialect const& m_dialect;
+	size_t m_minSizePerThread;
+	/// Facts about the current top-level statements, keyed by their name.
+	std::map<YulName, StatementInfo> m_statements;
+	/// For each step, the keys of the top-level statements its last run did not change.
+	std::map<std::string, std::map<YulName, uint64_t>> m_stableStatements;
+};
+
+}
@@ -37,7 +37,9 @@ void EqualStoreEliminator::run(OptimiserStepContext const& _context, Block& _ast
 {
 	EqualStoreEliminator eliminator{
 		_context.dialect,
-		SideEffectsPropagator::sideEffects(_context.dialect, CallGraphGenerator::callGraph(_ast))
+		_context.functionSideEffects ?
+			*_context.functionSideEffects :
+			SideEffectsPropagator::sideEffects(_context.dialect, CallGraphGenerator::callGraph(_ast))
 	};
 	eliminator(_ast);
 
@@ -30,6 +30,7 @@
 
 #include <map>
 #include <functional>
+#include <unordered_map>
 
 namespace solidity::yul
 {
@@ -123,11 +124,12 @@ private:
 
 	/// Offsets for each variable to one representative per group.
 	/// The empty string is the representative of the constant value zero.
-	std::map<YulName, VariableOffset> m_offsets;
+	std::unordered_map<YulName, VariableOffset> m_offsets;
 	/// Last known value of each variable we queried.
-	std::map<YulName, Expression const*> m_lastKnownValue;
+	std::unordered_map<YulName, Expression const*> m_lastKnownValue;
 	/// For each representative, variables that use it to offset from.
-	std::map<YulName, std::set<YulName>> m_groupMembers;
+	/// The members are kept ordered, since the first one becomes the new representative.
+	std::unordered_map<YulName, std::set<YulName>> m_groupMembers;
 };
 
 }
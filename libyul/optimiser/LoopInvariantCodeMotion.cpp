@@ -33,8 +33,10 @@ using namespace solidity::yul;
 void LoopInvariantCodeMotion::run(OptimiserStepContext& _context, Block& _ast)
 {
 	std::map<FunctionHandle, SideEffects> functionSideEffects =
+		_context.functionSideEffects ?
+		*_context.functionSideEffects :
 		SideEffectsPropagator::sideEffects(_context.dialect, CallGraphGenerator::callGraph(_ast));
-	bool containsMSize = MSizeFinder::containsMSize(_context.dialect, _ast);
+	bool containsMSize = _context.containsMSize ? *_context.containsMSize : MSizeFinder::containsMSize(_context.dialect, _ast);
 	std::set<YulName> ssaVars = SSAValueTracker::ssaVariables(_ast);
 	LoopInvariantCodeMotion{_context.dialect, ssaVars, functionSideEffects, containsMSize}(_ast);
 }
@@ -18,8 +18,10 @@
 
 #pragma once
 
+#include <libyul/ASTForward.h>
 #include <libyul/Exceptions.h>
 
+#include <map>
 #include <optional>
 #include <string>
 #include <set>
@@ -30,6 +32,8 @@ namespace solidity::yul
 class Dialect;
 struct Block;
 class NameDispenser;
+struct SideEffects;
+struct ControlFlowSideEffects;
 
 struct OptimiserStepContext
 {
@@ -38,6 +42,14 @@ struct OptimiserStepContext
 	std::set<YulName> const& reservedIdentifiers;
 	/// The value nullopt represents creation code
 	std::optional<size_t> expectedExecutionsPerDeployment;
+	/// Maximum number of threads to use for optimising independent functions concurrently.
+	size_t maxThreads = 1;
+
+	/// Facts about the whole AST, provided if a step is only run on some of its functions
+	/// (see DirtyFunctionTracker). Steps compute them from the AST they are given otherwise.
+	std::map<FunctionHandle, SideEffects> const* functionSideEffects = nullptr;
+	std::map<YulName, ControlFlowSideEffects> const* controlFlowSideEffects = nullptr;
+	std::optional<bool> containsMSize = std::nullopt;
 };
 
 
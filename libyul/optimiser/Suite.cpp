@@ -95,7 +95,8 @@ void OptimiserSuite::run(
 	std::string_view _optimisationSequence,
 	std::string_view _optimisationCleanupSequence,
 	std::optional<size_t> _expectedExecutionsPerDeployment,
-	std::set<YulName> const& _externallyUsedIdentifiers
+	std::set<YulName> const& _externallyUsedIdentifiers,
+	size_t _maxThreads
 )
 {
 	yulAssert(_object.dialect());
@@ -119,7 +120,7 @@ void OptimiserSuite::run(
 	}
 
 	NameDispenser dispenser{dialect, astRoot, reservedIdentifiers};
-	OptimiserStepContext context{dialect, dispenser, reservedIdentifiers, _expectedExecutionsPerDeployment};
+	OptimiserStepContext context{dialect, dispenser, reservedIdentifiers, _expectedExecutionsPerDeployment, _maxThreads};
 
 	OptimiserSuite suite(context, Debug::None);
 
@@ -159,7 +160,7 @@ void OptimiserSuite::run(
 		yulAssert(_meter, "");
 		{
 			PROFILER_PROBE("ConstantOptimiser", probe);
-			ConstantOptimiser{*evmDialect, *_meter}(astRoot);
+			ConstantOptimiser{*evmDialect, *_meter, _maxThreads}(astRoot);
 		}
 		if (usesOptimizedCodeGenerator)
 		{
@@ -222,42 +223,40 @@ std::map<std::string, std::unique_ptr<OptimiserStep>> optimiserStepCollection()
 
 std::map<std::string, std::unique_ptr<OptimiserStep>> const& OptimiserSuite::allSteps()
 {
-	static std::map<std::string, std::unique_ptr<OptimiserStep>> instance;
-	if (instance.empty())
-		instance = optimiserStepCollection<
-			BlockFlattener,
-			CircularReferencesPruner,
-			CommonSubexpressionEliminator,
-			ConditionalSimplifier,
-			ConditionalUnsimplifier,
-			ControlFlowSimplifier,
-			DeadCodeEliminator,
-			EqualStoreEliminator,
-			EquivalentFunctionCombiner,
-			ExpressionInliner,
-			ExpressionJoiner,
-			ExpressionSimplifier,
-			ExpressionSplitter,
-			ForLoopConditionIntoBody,
-			ForLoopConditionOutOfBody,
-			ForLoopInitRewriter,
-			FullInliner,
-			FunctionGrouper,
-			FunctionHoister,
-			FunctionSpecializer,
-			LiteralRematerialiser,
-			LoadResolver,
-			LoopInvariantCodeMotion,
-			UnusedAssignEliminator,
-			UnusedStoreEliminator,
-			Rematerialiser,
-			SSAReverser,
-			SSATransform,
-			StructuralSimplifier,
-			UnusedFunctionParameterPruner,
-			UnusedPruner,
-			VarDeclInitializer
-		>();
+	static std::map<std::string, std::unique_ptr<OptimiserStep>> const instance = optimiserStepCollection<
+		BlockFlattener,
+		CircularReferencesPruner,
+		CommonSubexpressionEliminator,
+		ConditionalSimplifier,
+		ConditionalUnsimplifier,
+		ControlFlowSimplifier,
+		DeadCodeEliminator,
+		EqualStoreEliminator,
+		EquivalentFunctionCombiner,
+		ExpressionInliner,
+		ExpressionJoiner,
+		ExpressionSimplifier,
+		ExpressionSplitter,
+		ForLoopConditionIntoBody,
+		ForLoopConditionOutOfBody,
+		ForLoopInitRewriter,
+		FullInliner,
+		FunctionGrouper,
+		FunctionHoister,
+		FunctionSpecializer,
+		LiteralRematerialiser,
+		LoadResolver,
+		LoopInvariantCodeMotion,
+		UnusedAssignEliminator,
+		UnusedStoreEliminator,
+		Rematerialiser,
+		SSAReverser,
+		SSATransform,
+		StructuralSimplifier,
+		UnusedFunctionParameterPruner,
+		UnusedPruner,
+		VarDeclInitializer
+	>();
 	// Does not include VarNameCleaner because it destroys the property of unique names.
 	// Does not include NameSimplifier.
 	return instance;
@@ -467,6 +466,8 @@ void OptimiserSuite::runSequence(std::vector<std::string> const& _steps, Block&
 	std::unique_ptr<Block> copy;
 	if (m_debug == Debug::PrintChanges)
 		copy = std::make_unique<Block>(std::get<Block>(ASTCopier{}(_ast)));
+	// The AST might have been modified since the last call.
+	m_dirtyFunctionTracker.resetCache();
 	for (std::string const& step: _steps)
 	{
 		if (m_debug == Debug::PrintStep)
@@ -474,7 +475,7 @@ void OptimiserSuite::runSequence(std::vector<std::string> const& _steps, Block&
 
 		{
 			PROFILER_PROBE(step, probe);
-			allSteps().at(step)->run(m_context, _ast);
+			m_dirtyFunctionTracker.run(*allSteps().at(step), m_context, _ast);
 		}
 
 		if (m_debug == Debug::PrintChanges)
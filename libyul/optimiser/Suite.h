@@ -23,6 +23,7 @@
 
 #include <libyul/ASTForward.h>
 #include <libyul/YulName.h>
+#include <libyul/optimiser/DirtyFunctionTracker.h>
 #include <libyul/optimiser/OptimiserStep.h>
 #include <libyul/optimiser/NameDispenser.h>
 #include <liblangutil/EVMVersion.h>
@@ -59,9 +60,14 @@ public:
 		PrintStep,
 		PrintChanges
 	};
-	OptimiserSuite(OptimiserStepContext& _context, Debug _debug = Debug::None): m_context(_context), m_debug(_debug) {}
+	OptimiserSuite(OptimiserStepContext& _context, Debug _debug = Debug::None):
+		m_context(_context),
+		m_debug(_debug),
+		m_dirtyFunctionTracker(_context.dialect)
+	{}
 
 	/// The value nullopt for `_expectedExecutionsPerDeployment` represents creation code.
+	/// Independent functions are optimised on up to @a _maxThreads threads.
 	static void run(
 		GasMeter const* _meter,
 		Object& _object,
@@ -69,7 +75,8 @@ public:
 		std::string_view _optimisationSequence,
 		std::string_view _optimisationCleanupSequence,
 		std::optional<size_t> _expectedExecutionsPerDeployment,
-		std::set<YulName> const& _externallyUsedIdentifiers = {}
+		std::set<YulName> const& _externallyUsedIdentifiers = {},
+		size_t _maxThreads = 1
 	);
 
 	/// Ensures that specified sequence of step abbreviations is well-formed and can be executed.
@@ -90,6 +97,9 @@ public:
 private:
 	OptimiserStepContext& m_context;
 	Debug m_debug;
+	/// Remembers which functions the steps left unchanged, so that repeated
+	/// runs of a step can skip them.
+	DirtyFunctionTracker m_dirtyFunctionTracker;
 };
 
 }
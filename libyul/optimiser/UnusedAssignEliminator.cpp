@@ -42,7 +42,9 @@ void UnusedAssignEliminator::run(OptimiserStepContext& _context, Block& _ast)
 {
 	UnusedAssignEliminator uae{
 		_context.dialect,
-		ControlFlowSideEffectsCollector{_context.dialect, _ast}.functionSideEffectsNamed()
+		_context.controlFlowSideEffects ?
+			*_context.controlFlowSideEffects :
+			ControlFlowSideEffectsCollector{_context.dialect, _ast}.functionSideEffectsNamed()
 	};
 	uae(_ast);
 
@@ -46,10 +46,10 @@ using namespace solidity::yul;
 
 void UnusedStoreEliminator::run(OptimiserStepContext& _context, Block& _ast)
 {
-	std::map<FunctionHandle, SideEffects> functionSideEffects = SideEffectsPropagator::sideEffects(
-		_context.dialect,
-		CallGraphGenerator::callGraph(_ast)
-	);
+	std::map<FunctionHandle, SideEffects> functionSideEffects =
+		_context.functionSideEffects ?
+		*_context.functionSideEffects :
+		SideEffectsPropagator::sideEffects(_context.dialect, CallGraphGenerator::callGraph(_ast));
 
 	SSAValueTracker ssaValues;
 	ssaValues(_ast);
@@ -57,11 +57,13 @@ void UnusedStoreEliminator::run(OptimiserStepContext& _context, Block& _ast)
 	for (auto const& [name, expression]: ssaValues.values())
 		values[name] = AssignedValue{expression, {}};
 
-	bool const ignoreMemory = MSizeFinder::containsMSize(_context.dialect, _ast);
+	bool const ignoreMemory = _context.containsMSize ? *_context.containsMSize : MSizeFinder::containsMSize(_context.dialect, _ast);
 	UnusedStoreEliminator rse{
 		_context.dialect,
 		functionSideEffects,
-		ControlFlowSideEffectsCollector{_context.dialect, _ast}.functionSideEffectsNamed(),
+		_context.controlFlowSideEffects ?
+			*_context.controlFlowSideEffects :
+			ControlFlowSideEffectsCollector{_context.dialect, _ast}.functionSideEffectsNamed(),
 		values,
 		ignoreMemory
 	};
@@ -42,6 +42,7 @@
 #include <libsolidity/lsp/Transport.h>
 
 #include <libyul/YulStack.h>
+#include <libyul/YulString.h>
 
 #include <libevmasm/Disassemble.h>
 
@@ -54,6 +55,7 @@
 #include <libsolutil/CommonData.h>
 #include <libsolutil/CommonIO.h>
 #include <libsolutil/JSON.h>
+#include <libsolutil/Tracer.h>
 
 #include <algorithm>
 #include <fstream>
@@ -653,6 +655,7 @@ void CommandLineInterface::readInputFiles()
 
 	if (
 		m_options.input.mode != InputMode::LanguageServer &&
+		m_options.input.mode != InputMode::Server &&
 		m_fileReader.sourceUnits().empty() &&
 		!m_standardJsonInput.has_value()
 	)
@@ -700,8 +703,13 @@ void CommandLineInterface::createFile(std::string const& _fileName, std::string
 	// The simplest workaround is to use an absolute path.
 	fs::create_directories(fs::absolute(m_options.output.dir));
 
-	std::string pathName = (m_options.output.dir / _fileName).string();
-	if (fs::exists(pathName) && !m_options.output.overwriteFiles)
+	writeFile(m_options.output.dir / _fileName, _data);
+}
+
+void CommandLineInterface::writeFile(boost::filesystem::path const& _path, std::string const& _data)
+{
+	std::string pathName = _path.string();
+	if (boost::filesystem::exists(pathName) && !m_options.output.overwriteFiles)
 		solThrow(CommandLineOutputError, "Refusing to overwrite existing file \"" + pathName + "\" (use --overwrite to force).");
 
 	std::ofstream outFile(pathName);
@@ -800,10 +808,14 @@ void CommandLineInterface::processInput()
 		solAssert(m_standardJsonInput.has_value());
 
 		StandardCompiler compiler(m_universalCallback.callback(), m_options.formatting.json);
-		sout() << compiler.compile(std::move(m_standardJsonInput.value())) << std::endl;
+		compiler.compile(m_standardJsonInput.value(), sout());
+		sout() << std::endl;
 		m_standardJsonInput.reset();
 		break;
 	}
+	case InputMode::Server:
+		serveStandardJson();
+		break;
 	case InputMode::LanguageServer:
 		serveLSP();
 		break;
@@ -879,6 +891,25 @@ void CommandLineInterface::compile()
 
 	SourceReferenceFormatter formatter(serr(false), *m_compiler, coloredOutput(m_options), m_options.formatting.withErrorIds);
 
+	std::unique_ptr<util::Tracer> tracer;
+	if (m_options.output.traceFile.has_value())
+		tracer = std::make_unique<util::Tracer>();
+	util::Tracer::Scope tracerScope(tracer.get());
+	// The trace is written also when the compilation fails, since it shows how far it got.
+	// A failure to write it must not hide the error that stopped the compilation though.
+	auto writeTraceAfterFailure = [&]() {
+		if (!tracer)
+			return;
+		try
+		{
+			writeFile(*m_options.output.traceFile, util::jsonCompactPrint(tracer->toJson()) + "\n");
+		}
+		catch (CommandLineOutputError const& _error)
+		{
+			report(Error::Severity::Error, _error.what());
+		}
+	};
+
 	try
 	{
 		if (m_options.metadata.literalSources)
@@ -890,6 +921,20 @@ void CommandLineInterface::compile()
 		m_compiler->setRemappings(m_options.input.remappings);
 		m_compiler->setLibraries(m_options.linker.libraries);
 		m_compiler->setViaIR(m_options.output.viaIR);
+		m_compiler->setParallelism(m_options.output.threads);
+		m_compiler->setProfiling(m_options.output.profile);
+		if (m_options.optimizer.yulCacheDir.has_value())
+			try
+			{
+				m_compiler->setYulCacheDirectory(
+					*m_options.optimizer.yulCacheDir,
+					uint64_t(m_options.optimizer.yulCacheSizeLimit) * 1024 * 1024
+				);
+			}
+			catch (boost::filesystem::filesystem_error const& _exception)
+			{
+				solThrow(CommandLineExecutionError, "Could not use the Yul cache directory: "s + _exception.what());
+			}
 		m_compiler->setEVMVersion(m_options.output.evmVersion);
 		m_compiler->setEOFVersion(m_options.output.eofVersion);
 		m_compiler->setRevertStringBehaviour(m_options.output.revertStrings);
@@ -959,6 +1004,9 @@ void CommandLineInterface::compile()
 			formatter.printErrorInformation(*error);
 		}
 
+		if (m_options.output.profile)
+			printProfile();
+
 		if (!successful)
 			solThrow(CommandLineExecutionError, "");
 	}
@@ -969,8 +1017,36 @@ void CommandLineInterface::compile()
 			_exception,
 			Error::errorSeverity(Error::Type::CompilerError)
 		);
+		writeTraceAfterFailure();
 		solThrow(CommandLineExecutionError, "");
 	}
+	catch (...)
+	{
+		writeTraceAfterFailure();
+		throw;
+	}
+
+	if (tracer)
+		writeFile(*m_options.output.traceFile, util::jsonCompactPrint(tracer->toJson()) + "\n");
+}
+
+void CommandLineInterface::printProfile()
+{
+	solAssert(m_compiler && m_compiler->profiler());
+
+	serr() << std::endl << "======= Profile =======" << std::endl;
+	m_compiler->profiler()->outputPerformanceMetrics(serr());
+
+	if (m_compiler->state() < CompilerStack::State::AnalysisSuccessful)
+		return;
+	for (std::string const& contract: m_compiler->contractNames())
+	{
+		util::Profiler const* profiler = m_compiler->contractProfiler(contract);
+		if (!profiler || profiler->metrics().empty())
+			continue;
+		serr() << std::endl << "======= Profile of " << contract << " =======" << std::endl;
+		profiler->outputPerformanceMetrics(serr());
+	}
 }
 
 void CommandLineInterface::handleCombinedJSON()
@@ -1119,6 +1195,45 @@ void CommandLineInterface::handleAst()
 	}
 }
 
+void CommandLineInterface::serveStandardJson()
+{
+	solAssert(m_options.input.mode == InputMode::Server);
+
+	auto const makeObjectOptimizer = [&]() {
+		auto objectOptimizer = std::make_shared<yul::ObjectOptimizer>();
+		objectOptimizer->setMaxCachedObjects(m_options.optimizer.yulObjectCacheLimit);
+		return objectOptimizer;
+	};
+	auto parsedSourceCache = std::make_shared<CompilerStack::ParsedSourceCache>();
+
+	// Each output has to fit on a single line, so the formatting options are ignored.
+	StandardCompiler compiler(m_universalCallback.callback());
+	compiler.setObjectOptimizer(makeObjectOptimizer());
+	compiler.setParsedSourceCache(parsedSourceCache);
+
+	std::string input;
+	while (std::getline(m_sin, input))
+	{
+		if (input.find_first_not_of(" \t\r") == std::string::npos)
+			continue;
+
+		compiler.compile(input, sout());
+		sout() << std::endl;
+		// Do not keep the imported files around, they are read again by the next compilation anyway.
+		m_fileReader.setSourceUnits({});
+
+		// Identifiers and literals are never removed from the Yul string repository on their own.
+		// Once there are too many, drop the cached Yul objects and ASTs, which are the only ones
+		// still referring to them, and start over.
+		if (yul::YulStringRepository::instance().size() > m_options.optimizer.yulStringLimit)
+		{
+			compiler.setObjectOptimizer(makeObjectOptimizer());
+			parsedSourceCache->entries.clear();
+			yul::YulStringRepository::reset();
+		}
+	}
+}
+
 void CommandLineInterface::serveLSP()
 {
 	lsp::StdioTransport transport;
@@ -86,7 +86,12 @@ private:
 	void printVersion();
 	void printLicense();
 	void compile();
+	/// Prints the metrics of the compilation phases gathered with --profile to standard error.
+	void printProfile();
 	void assembleFromEVMAssemblyJSON();
+	/// Compiles newline-delimited Standard JSON inputs from standard input until it is closed,
+	/// reusing caches across inputs.
+	void serveStandardJson();
 	void serveLSP();
 	void link();
 	void writeLinkedFiles();
@@ -129,6 +134,10 @@ private:
 	/// @arg _data to be written
 	void createFile(std::string const& _fileName, std::string const& _data);
 
+	/// Write @a _data to the file at @a _path, refusing to replace an existing file
+	/// unless --overwrite was given.
+	void writeFile(boost::filesystem::path const& _path, std::string const& _data);
+
 	/// Create a json file in the given directory
 	/// @arg _fileName the name of the file (the extension will be replaced with .json)
 	/// @arg _json json string to be written
@@ -87,10 +87,17 @@ static std::string const g_strOptimize = "optimize";
 static std::string const g_strOptimizeRuns = "optimize-runs";
 static std::string const g_strOptimizeYul = "optimize-yul";
 static std::string const g_strYulOptimizations = "yul-optimizations";
+static std::string const g_strYulCacheDir = "yul-cache-dir";
+static std::string const g_strYulCacheSizeLimit = "yul-cache-size-limit";
+static std::string const g_strYulObjectCacheLimit = "yul-object-cache-limit";
+static std::string const g_strYulStringLimit = "yul-string-limit";
 static std::string const g_strOutputDir = "output-dir";
 static std::string const g_strOverwrite = "overwrite";
 static std::string const g_strRevertStrings = "revert-strings";
 static std::string const g_strStopAfter = "stop-after";
+static std::string const g_strThreads = "threads";
+static std::string const g_strProfile = "profile";
+static std::string const g_strTraceOut = "trace-out";
 static std::string const g_strParsing = "parsing";
 
 /// Possible arguments to for --revert-strings
@@ -104,6 +111,7 @@ static std::set<std::string> const g_revertStringsArgs
 
 static std::string const g_strSources = "sources";
 static std::string const g_strSourceList = "sourceList";
+static std::string const g_strServer = "server";
 static std::string const g_strStandardJSON = "standard-json";
 static std::string const g_strStrictAssembly = "strict-assembly";
 static std::string const g_strSwarm = "swarm";
@@ -143,6 +151,7 @@ static std::map<InputMode, std::string> const g_inputModeName = {
 	{InputMode::CompilerWithASTImport, "compiler (AST import)"},
 	{InputMode::Assembler, "assembler"},
 	{InputMode::StandardJson, "standard JSON"},
+	{InputMode::Server, "compile server"},
 	{InputMode::Linker, "linker"},
 	{InputMode::LanguageServer, "language server (LSP)"},
 	{InputMode::EVMAssemblerJSON, "EVM assembler (JSON format)"},
@@ -235,6 +244,9 @@ bool CommandLineOptions::operator==(CommandLineOptions const& _other) const noex
 		output.overwriteFiles == _other.output.overwriteFiles &&
 		output.evmVersion == _other.output.evmVersion &&
 		output.viaIR == _other.output.viaIR &&
+		output.threads == _other.output.threads &&
+		output.profile == _other.output.profile &&
+		output.traceFile == _other.output.traceFile &&
 		output.revertStrings == _other.output.revertStrings &&
 		output.debugInfoSelection == _other.output.debugInfoSelection &&
 		output.stopAfter == _other.output.stopAfter &&
@@ -256,6 +268,10 @@ bool CommandLineOptions::operator==(CommandLineOptions const& _other) const noex
 		optimizer.optimizeYul == _other.optimizer.optimizeYul &&
 		optimizer.expectedExecutionsPerDeployment == _other.optimizer.expectedExecutionsPerDeployment &&
 		optimizer.yulSteps == _other.optimizer.yulSteps &&
+		optimizer.yulCacheDir == _other.optimizer.yulCacheDir &&
+		optimizer.yulCacheSizeLimit == _other.optimizer.yulCacheSizeLimit &&
+		optimizer.yulObjectCacheLimit == _other.optimizer.yulObjectCacheLimit &&
+		optimizer.yulStringLimit == _other.optimizer.yulStringLimit &&
 		modelChecker.initialize == _other.modelChecker.initialize &&
 		modelChecker.settings == _other.modelChecker.settings;
 }
@@ -312,7 +328,7 @@ void CommandLineParser::parseInputPathsAndRemappings()
 				if (!remapping.has_value())
 					solThrow(CommandLineValidationError, "Invalid remapping: \"" + positionalArg + "\".");
 
-				if (m_options.input.mode == InputMode::StandardJson)
+				if (m_options.input.mode == InputMode::StandardJson || m_options.input.mode == InputMode::Server)
 					solThrow(
 						CommandLineValidationError,
 						"Import remappings are not accepted on the command line in Standard JSON mode.\n"
@@ -352,6 +368,15 @@ void CommandLineParser::parseInputPathsAndRemappings()
 			// Keep it working that way for backwards-compatibility.
 			m_options.input.addStdin = true;
 	}
+	else if (m_options.input.mode == InputMode::Server)
+	{
+		if (!m_options.input.paths.empty() || m_options.input.addStdin)
+			solThrow(
+				CommandLineValidationError,
+				"Input files are not accepted in --" + g_strServer + " mode.\n"
+				"Please send the Standard JSON inputs to standard input, one per line."
+			);
+	}
 	else if (m_options.input.paths.size() == 0 && !m_options.input.addStdin)
 		solThrow(
 			CommandLineValidationError,
@@ -497,6 +522,7 @@ void CommandLineParser::parseOutputSelection()
 		case InputMode::Assembler:
 			return util::contains(assemblerModeOutputs, _outputName);
 		case InputMode::StandardJson:
+		case InputMode::Server:
 		case InputMode::Linker:
 			return false;
 		}
@@ -611,7 +637,7 @@ General Information)").c_str(),
 		)
 		(
 			g_strOverwrite.c_str(),
-			"Overwrite existing files (used together with -o)."
+			"Overwrite existing files (used together with -o or --trace-out)."
 		)
 		(
 			g_strEVMVersion.c_str(),
@@ -641,6 +667,25 @@ General Information)").c_str(),
 			g_strViaIR.c_str(),
 			"Turn on compilation mode via the IR."
 		)
+		(
+			g_strThreads.c_str(),
+			po::value<unsigned>()->value_name("n")->default_value(1),
+			"Maximum number of threads used to optimize the IR and generate bytecode of independent "
+			"contracts, Yul objects and functions concurrently. Only affects compilation via the IR. "
+			"The output does not depend on it."
+		)
+		(
+			g_strProfile.c_str(),
+			"Print the time, the number of calls and the growth of the peak memory usage of each "
+			"compilation phase, like parsing, the analysis passes, IR generation, the optimizer steps "
+			"and assembly, to standard error. The phases of each contract are reported separately."
+		)
+		(
+			g_strTraceOut.c_str(),
+			po::value<std::string>()->value_name("path"),
+			"Write a timeline of the compilation phases, contracts, Yul objects and optimizer steps "
+			"to the given file in the Trace Event Format, which can be viewed in Perfetto or chrome://tracing."
+		)
 		(
 			g_strRevertStrings.c_str(),
 			po::value<std::string>()->value_name(util::joinHumanReadable(g_revertStringsArgs, ",")),
@@ -668,6 +713,12 @@ General Information)").c_str(),
 			"Switch to Standard JSON input / output mode, ignoring all options. "
 			"It reads from standard input, if no input file was given, otherwise it reads from the provided input file. The result will be written to standard output."
 		)
+		(
+			g_strServer.c_str(),
+			"Switch to compile server mode. Reads Standard JSON inputs from standard input, one per line, "
+			"and writes the output for each of them to standard output as a single line. "
+			"Optimized Yul code is kept in memory and reused across inputs."
+		)
 		(
 			g_strLink.c_str(),
 			("Switch to linker mode, ignoring all options apart from --" + g_strLibraries + " "
@@ -839,6 +890,30 @@ General Information)").c_str(),
 			po::value<std::string>()->value_name("steps"),
 			"Forces Yul optimizer to use the specified sequence of optimization steps instead of the built-in one."
 		)
+		(
+			g_strYulCacheDir.c_str(),
+			po::value<std::string>()->value_name("path"),
+			"Store the results of the Yul optimizer in the given directory and reuse them in later compilations "
+			"with the same compiler version."
+		)
+		(
+			g_strYulCacheSizeLimit.c_str(),
+			po::value<unsigned>()->value_name("MiB")->default_value(1024),
+			("Maximum total size of the entries in the --" + g_strYulCacheDir + " directory in mebibytes. "
+			"The least recently used entries are removed first.").c_str()
+		)
+		(
+			g_strYulObjectCacheLimit.c_str(),
+			po::value<unsigned>()->value_name("count")->default_value(1000),
+			("Maximum number of optimized Yul objects kept in memory in --" + g_strServer + " mode. "
+			"The least recently used objects are dropped first.").c_str()
+		)
+		(
+			g_strYulStringLimit.c_str(),
+			po::value<unsigned>()->value_name("count")->default_value(1000000),
+			("Maximum number of distinct Yul identifiers and literals kept in memory in --" + g_strServer + " mode. "
+			"If an input leaves more behind, everything kept across inputs is dropped.").c_str()
+		)
 	;
 	desc.add(optimizerOptions);
 
@@ -966,6 +1041,7 @@ void CommandLineParser::processArgs()
 		g_strLicense,
 		g_strVersion,
 		g_strStandardJSON,
+		g_strServer,
 		g_strLink,
 		g_strAssemble,
 		g_strStrictAssembly,
@@ -982,6 +1058,8 @@ void CommandLineParser::processArgs()
 		m_options.input.mode = InputMode::Version;
 	else if (m_args.count(g_strStandardJSON) > 0)
 		m_options.input.mode = InputMode::StandardJson;
+	else if (m_args.count(g_strServer) > 0)
+		m_options.input.mode = InputMode::Server;
 	else if (m_args.count(g_strLSP))
 		m_options.input.mode = InputMode::LanguageServer;
 	else if (m_args.count(g_strAssemble) > 0 || m_args.count(g_strStrictAssembly) > 0)
@@ -1013,6 +1091,13 @@ void CommandLineParser::processArgs()
 		// TODO: This should eventually contain all options.
 		{g_strExperimentalViaIR, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strViaIR, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
+		{g_strThreads, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
+		{g_strProfile, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
+		{g_strTraceOut, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
+		{g_strYulCacheDir, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
+		{g_strYulCacheSizeLimit, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
+		{g_strYulObjectCacheLimit, {InputMode::Server}},
+		{g_strYulStringLimit, {InputMode::Server}},
 		{g_strMetadataLiteral, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strNoCBORMetadata, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strMetadataHash, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
@@ -1208,6 +1293,13 @@ void CommandLineParser::processArgs()
 	if (m_options.input.mode == InputMode::StandardJson)
 		return;
 
+	if (m_options.input.mode == InputMode::Server)
+	{
+		m_options.optimizer.yulObjectCacheLimit = m_args[g_strYulObjectCacheLimit].as<unsigned>();
+		m_options.optimizer.yulStringLimit = m_args[g_strYulStringLimit].as<unsigned>();
+		return;
+	}
+
 	if (m_args.count(g_strLibraries))
 		for (std::string const& library: m_args[g_strLibraries].as<std::vector<std::string>>())
 			parseLibraryOption(library);
@@ -1455,6 +1547,37 @@ void CommandLineParser::processArgs()
 		m_args.count(g_strModelCheckerTimeout);
 	m_options.output.viaIR = (m_args.count(g_strExperimentalViaIR) > 0 || m_args.count(g_strViaIR) > 0);
 
+	m_options.output.profile = (m_args.count(g_strProfile) > 0);
+	if (m_args.count(g_strTraceOut) > 0)
+	{
+		m_options.output.traceFile = m_args[g_strTraceOut].as<std::string>();
+		if (m_options.output.traceFile->empty())
+			solThrow(CommandLineValidationError, "The trace file path must not be empty.");
+	}
+
+	if (m_args.count(g_strThreads) > 0)
+	{
+		m_options.output.threads = m_args[g_strThreads].as<unsigned>();
+		if (m_options.output.threads == 0)
+			solThrow(CommandLineValidationError, "The number of threads must be at least 1.");
+	}
+
+	if (m_args.count(g_strYulCacheDir) > 0)
+	{
+		m_options.optimizer.yulCacheDir = m_args[g_strYulCacheDir].as<std::string>();
+		if (m_options.optimizer.yulCacheDir->empty())
+			solThrow(CommandLineValidationError, "The Yul cache directory must not be empty.");
+	}
+	if (!m_args[g_strYulCacheSizeLimit].defaulted())
+	{
+		if (!m_options.optimizer.yulCacheDir.has_value())
+			solThrow(
+				CommandLineValidationError,
+				"Option --" + g_strYulCacheSizeLimit + " can only be used together with --" + g_strYulCacheDir + "."
+			);
+		m_options.optimizer.yulCacheSizeLimit = m_args[g_strYulCacheSizeLimit].as<unsigned>();
+	}
+
 	solAssert(
 		m_options.input.mode == InputMode::Compiler ||
 		m_options.input.mode == InputMode::CompilerWithASTImport ||
@@ -54,6 +54,7 @@ enum class InputMode
 	Compiler,
 	CompilerWithASTImport,
 	StandardJson,
+	Server,
 	Linker,
 	Assembler,
 	LanguageServer,
@@ -190,6 +191,9 @@ struct CommandLineOptions
 		bool overwriteFiles = false;
 		langutil::EVMVersion evmVersion;
 		bool viaIR = false;
+		unsigned threads = 1;
+		bool profile = false;
+		std::optional<boost::filesystem::path> traceFile;
 		RevertStrings revertStrings = RevertStrings::Default;
 		std::optional<langutil::DebugInfoSelection> debugInfoSelection;
 		CompilerStack::State stopAfter = CompilerStack::State::CompilationSuccessful;
@@ -234,6 +238,13 @@ struct CommandLineOptions
 		bool optimizeYul = false;
 		std::optional<unsigned> expectedExecutionsPerDeployment;
 		std::optional<std::string> yulSteps;
+		std::optional<boost::filesystem::path> yulCacheDir;
+		/// Size limit of the Yul cache directory in MiB.
+		unsigned yulCacheSizeLimit = 1024;
+		/// Maximum number of optimized Yul objects kept in memory in server mode.
+		unsigned yulObjectCacheLimit = 1000;
+		/// Number of Yul strings in memory in server mode above which all data kept across inputs is dropped.
+		unsigned yulStringLimit = 1000000;
 	} optimizer;
 
 	struct
@@ -31,6 +31,7 @@
 #include <boost/test/unit_test.hpp>
 
 #include <algorithm>
+#include <limits>
 #include <memory>
 #include <string>
 #include <tuple>
@@ -422,6 +423,143 @@ BOOST_AUTO_TEST_CASE(subobject_encode_decode)
 	BOOST_CHECK(assembly.decodeSubPath(assembly.encodeSubPath(subPath)) == subPath);
 }
 
+BOOST_AUTO_TEST_CASE(item_data_of_all_sizes)
+{
+	// Values up to 64 bits are stored inline, larger ones separately.
+	std::vector<u256> values{
+		0,
+		1,
+		std::numeric_limits<uint64_t>::max(),
+		u256(std::numeric_limits<uint64_t>::max()) + 1,
+		u256(1) << 200,
+		(u256(1) << 200) + 1
+	};
+	for (u256 const& a: values)
+	{
+		AssemblyItem item(a);
+		BOOST_CHECK_EQUAL(item.data(), a);
+		for (u256 const& b: values)
+		{
+			AssemblyItem other(b);
+			BOOST_CHECK_EQUAL(item == other, a == b);
+			BOOST_CHECK_EQUAL(item < other, a < b);
+		}
+		item.setData(values.back() - a);
+		BOOST_CHECK_EQUAL(item.data(), values.back() - a);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(optimise_subs_concurrently)
+{
+	EVMVersion evmVersion = solidity::test::CommonOptions::get().evmVersion();
+	// The optimiser steps run on the sub-assemblies are not implemented for EOF yet.
+	std::optional<uint8_t> eofVersion = std::nullopt;
+	auto createAssembly = [&]()
+	{
+		auto assembly = std::make_shared<Assembly>(evmVersion, true, eofVersion, "root");
+		// Referenced from several subs, which must not be optimised concurrently.
+		auto sharedSub = std::make_shared<Assembly>(evmVersion, false, eofVersion, "shared");
+		sharedSub->append(u256(1));
+		sharedSub->append(u256(2));
+		sharedSub->append(Instruction::ADD);
+		sharedSub->append(Instruction::POP);
+		for (unsigned i = 0; i < 6; ++i)
+		{
+			auto sub = std::make_shared<Assembly>(evmVersion, true, eofVersion, "sub" + std::to_string(i));
+			auto runtimeSub = std::make_shared<Assembly>(evmVersion, false, eofVersion, "runtime" + std::to_string(i));
+			// Two identical blocks for the deduplicator.
+			AssemblyItem firstTag = runtimeSub->newTag();
+			AssemblyItem secondTag = runtimeSub->newTag();
+			runtimeSub->append(u256(i));
+			runtimeSub->appendJumpI(firstTag);
+			runtimeSub->appendJump(secondTag);
+			for (AssemblyItem const& tag: {firstTag, secondTag})
+			{
+				runtimeSub->append(tag);
+				runtimeSub->append(u256(i));
+				runtimeSub->append(u256(i));
+				runtimeSub->append(Instruction::SSTORE);
+				runtimeSub->append(Instruction::STOP);
+			}
+			sub->appendSubroutine(runtimeSub);
+			if (i % 2 == 0)
+				sub->appendSubroutine(sharedSub);
+			assembly->appendSubroutine(sub);
+		}
+		return assembly;
+	};
+
+	auto settings = Assembly::OptimiserSettings::translateSettings(OptimiserSettings::full(), evmVersion);
+	std::shared_ptr<Assembly> sequential = createAssembly();
+	sequential->optimise(settings);
+
+	std::shared_ptr<Assembly> concurrent = createAssembly();
+	settings.maxThreads = 4;
+	concurrent->optimise(settings);
+
+	BOOST_CHECK_EQUAL(sequential->assemblyString(), concurrent->assemblyString());
+	BOOST_CHECK(sequential->assemble().bytecode == concurrent->assemble().bytecode);
+}
+
+BOOST_AUTO_TEST_CASE(cse_skipped_blocks_keep_debug_data_and_jump_types)
+{
+	EVMVersion evmVersion = solidity::test::CommonOptions::get().evmVersion();
+	// The common subexpression eliminator is not run for EOF.
+	std::optional<uint8_t> eofVersion = std::nullopt;
+	auto firstSource = std::make_shared<std::string>("first.sol");
+	auto secondSource = std::make_shared<std::string>("second.sol");
+	auto createAssembly = [&]()
+	{
+		auto assembly = std::make_shared<Assembly>(evmVersion, false, eofVersion, "root");
+		AssemblyItem target = assembly->newTag();
+		AssemblyItem unused = assembly->newTag();
+		// Two blocks with the same items, which the eliminator cannot improve. The second one
+		// is skipped after the first one was processed, but differs in debug data and jump type.
+		for (auto const& [source, jumpType]: {
+			std::make_pair(firstSource, AssemblyItem::JumpType::Ordinary),
+			std::make_pair(secondSource, AssemblyItem::JumpType::IntoFunction)
+		})
+		{
+			assembly->setSourceLocation({1, 3, source});
+			assembly->append(u256(1));
+			assembly->append(u256(2));
+			assembly->append(Instruction::SSTORE);
+			assembly->append(target.pushTag());
+			AssemblyItem jump(Instruction::JUMP);
+			jump.setJumpType(jumpType);
+			assembly->append(jump);
+			if (source == firstSource)
+				assembly->append(unused);
+		}
+		assembly->append(target);
+		assembly->append(Instruction::STOP);
+		return assembly;
+	};
+
+	Assembly::OptimiserSettings settings;
+	settings.runCSE = true;
+	settings.evmVersion = evmVersion;
+	std::shared_ptr<Assembly> original = createAssembly();
+	std::shared_ptr<Assembly> optimised = createAssembly();
+	optimised->optimise(settings);
+
+	AssemblyItems const& originalItems = original->codeSections().at(0).items;
+	AssemblyItems const& optimisedItems = optimised->codeSections().at(0).items;
+	BOOST_REQUIRE_EQUAL(optimisedItems.size(), originalItems.size());
+	for (size_t i = 0; i < originalItems.size(); ++i)
+	{
+		BOOST_CHECK(optimisedItems[i] == originalItems[i]);
+		BOOST_CHECK(optimisedItems[i].location() == originalItems[i].location());
+		BOOST_CHECK(optimisedItems[i].getJumpType() == originalItems[i].getJumpType());
+	}
+	BOOST_CHECK_EQUAL(optimised->assemblyString(), original->assemblyString());
+	std::map<std::string, unsigned> sourceIndices{{"first.sol", 0}, {"second.sol", 1}};
+	BOOST_CHECK_EQUAL(
+		AssemblyItem::computeSourceMapping(optimisedItems, sourceIndices),
+		AssemblyItem::computeSourceMapping(originalItems, sourceIndices)
+	);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
@@ -30,6 +30,7 @@
 #include <libevmasm/ControlFlowGraph.h>
 #include <libevmasm/BlockDeduplicator.h>
 #include <libevmasm/Assembly.h>
+#include <libevmasm/ConstantOptimiser.h>
 
 #include <boost/test/unit_test.hpp>
 
@@ -1302,6 +1303,41 @@ BOOST_AUTO_TEST_CASE(peephole_iszero_iszero_jumpi)
 	);
 }
 
+BOOST_AUTO_TEST_CASE(peephole_revisits_windows_changed_by_previous_pass)
+{
+	// The first pass removes `PUSH 7 POP`, which makes the two `PUSH 5` adjacent.
+	AssemblyItems items{
+		u256(5),
+		u256(7),
+		Instruction::POP,
+		u256(5),
+		Instruction::CALLVALUE,
+		Instruction::CALLVALUE,
+		Instruction::CALLVALUE,
+		Instruction::CALLVALUE,
+		Instruction::CALLVALUE,
+		Instruction::CALLVALUE
+	};
+	AssemblyItems expectation{
+		u256(5),
+		Instruction::DUP1,
+		Instruction::CALLVALUE,
+		Instruction::CALLVALUE,
+		Instruction::CALLVALUE,
+		Instruction::CALLVALUE,
+		Instruction::CALLVALUE,
+		Instruction::CALLVALUE
+	};
+	PeepholeOptimiser peepOpt(items, solidity::test::CommonOptions::get().evmVersion());
+	BOOST_REQUIRE(peepOpt.optimise());
+	BOOST_REQUIRE(peepOpt.optimise());
+	BOOST_REQUIRE(!peepOpt.optimise());
+	BOOST_CHECK_EQUAL_COLLECTIONS(
+		items.begin(), items.end(),
+		expectation.begin(), expectation.end()
+	);
+}
+
 BOOST_AUTO_TEST_CASE(jumpdest_removal)
 {
 	AssemblyItems items{
@@ -2047,6 +2083,62 @@ BOOST_AUTO_TEST_CASE(inliner_invalid)
 }
 
 
+BOOST_AUTO_TEST_CASE(constant_optimiser_cache_does_not_change_output)
+{
+	// The key parts of the cached representations: creation, runs, EVM version and multiplicity.
+	using Config = std::tuple<bool, size_t, EVMVersion, size_t>;
+	std::vector<Config> const configs{
+		{false, 200, EVMVersion::shanghai(), 1},
+		{true, 200, EVMVersion::shanghai(), 1},
+		{false, 1, EVMVersion::shanghai(), 1},
+		{false, 100000, EVMVersion::shanghai(), 1},
+		{false, 200, EVMVersion::homestead(), 1},
+		{false, 200, EVMVersion::shanghai(), 3},
+		{true, 1, EVMVersion::homestead(), 5},
+	};
+	std::vector<u256> const values{
+		u256(0x1234),
+		(u256(1) << 255),
+		(u256(1) << 160) - 1,
+		~u256(0xff),
+		u256("0x1234567800000000000000000000000000000000000000000000000000000000"),
+		u256("0x0102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f20"),
+		u256("0xffffffffffffffffffffffffffffffff00000000000000000000000000000001"),
+	};
+	auto optimise = [&](Config const& _config)
+	{
+		auto const& [isCreation, runs, evmVersion, multiplicity] = _config;
+		// The code copy method is not available for EOF.
+		Assembly assembly{evmVersion, isCreation, std::nullopt, {}};
+		for (size_t i = 0; i < multiplicity; ++i)
+			for (u256 const& value: values)
+			{
+				assembly.append(value);
+				assembly.append(Instruction::POP);
+			}
+		ConstantOptimisationMethod::optimiseConstants(isCreation, runs, evmVersion, assembly);
+		return assembly.assemblyString() + "\n" + util::toHex(assembly.assemble().bytecode);
+	};
+
+	std::vector<std::string> coldResults;
+	for (Config const& config: configs)
+	{
+		ComputeMethod::clearRepresentationCache();
+		coldResults.emplace_back(optimise(config));
+	}
+
+	// The cache is shared by all configurations and filled by the ones that run earlier.
+	ComputeMethod::clearRepresentationCache();
+	for (size_t round = 0; round < 2; ++round)
+		for (size_t i = 0; i < configs.size(); ++i)
+			BOOST_CHECK_EQUAL(optimise(configs[i]), coldResults[i]);
+	// Also in reverse order, so that every configuration runs after every other one.
+	for (size_t i = configs.size(); i > 0; --i)
+		BOOST_CHECK_EQUAL(optimise(configs[i - 1]), coldResults[i - 1]);
+	ComputeMethod::clearRepresentationCache();
+}
+
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
@@ -33,6 +33,7 @@
 
 #include <algorithm>
 #include <set>
+#include <sstream>
 
 using namespace solidity::evmasm;
 using namespace std::string_literals;
@@ -1655,6 +1656,267 @@ BOOST_AUTO_TEST_CASE(stopAfter_ast_output)
 	BOOST_CHECK(result["sources"]["a.sol"]["ast"].is_object());
 }
 
+BOOST_AUTO_TEST_CASE(parallelism_invalid_value)
+{
+	for (std::string parallelism: {"0", "-1", "\"4\"", "2.5"})
+	{
+		std::string input = R"(
+		{
+			"language": "Solidity",
+			"sources":
+			{ "": { "content": "pragma solidity >=0.0; contract C { function f() public pure {} }" } },
+			"settings":
+			{
+				"parallelism": )" + parallelism + R"(,
+				"outputSelection":
+				{
+					"*": { "C": ["evm.bytecode"] }
+				}
+			}
+		}
+		)";
+		Json result = compile(input);
+		BOOST_CHECK(containsError(result, "JSONError", "\"settings.parallelism\" must be a positive integer."));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(parallelism_does_not_affect_output)
+{
+	std::string const sourceA = R"(
+		pragma abicoder v1;
+		contract A { function f() public pure returns (uint) { return 1; } }
+		contract B { function g() public returns (address) { return address(new A()); } }
+	)";
+	std::string const sourceB = R"(
+		import "a.sol";
+		contract C is B { function h() public returns (address) { return address(new B()); } }
+		library L { function l(uint x) public pure returns (uint) { return x * 2; } }
+		contract D { function d(uint x) public pure returns (uint) { return L.l(x) + x; } }
+	)";
+	auto compileWithParallelism = [&](size_t _parallelism)
+	{
+		Json input;
+		input["language"] = "Solidity";
+		input["sources"]["a.sol"]["content"] = sourceA;
+		input["sources"]["b.sol"]["content"] = sourceB;
+		input["settings"]["viaIR"] = true;
+		input["settings"]["optimizer"]["enabled"] = true;
+		input["settings"]["parallelism"] = _parallelism;
+		input["settings"]["outputSelection"]["*"]["*"] = Json::array({"evm.bytecode", "evm.deployedBytecode", "irOptimized", "evm.assembly"});
+		return solidity::frontend::StandardCompiler{}.compile(input);
+	};
+
+	Json sequentialResult = compileWithParallelism(1);
+	BOOST_REQUIRE(containsAtMostWarnings(sequentialResult));
+	BOOST_REQUIRE(sequentialResult["contracts"]["b.sol"].size() == 3);
+	for (size_t parallelism: {2u, 8u})
+		BOOST_CHECK(compileWithParallelism(parallelism) == sequentialResult);
+}
+
+BOOST_AUTO_TEST_CASE(parsed_source_cache_does_not_affect_output)
+{
+	std::string const sourceA = R"(
+		contract A { function f() public pure returns (uint) { return 1; } }
+	)";
+	std::string const sourceB = R"(
+		import "a.sol";
+		contract B is A { function g() public pure returns (uint) { return f() + 2; } }
+	)";
+	std::string const changedSourceA = R"(
+		contract A { function f() public pure returns (uint) { return 1 + 1; } }
+	)";
+	std::string const changedSourceB = R"(
+		import "a.sol";
+		contract B is A { function g() public pure returns (uint) { return f() * 3; } }
+	)";
+	auto makeInput = [](std::string const& _sourceA, std::string const& _sourceB)
+	{
+		Json input;
+		input["language"] = "Solidity";
+		input["sources"]["a.sol"]["content"] = _sourceA;
+		input["sources"]["b.sol"]["content"] = _sourceB;
+		input["settings"]["outputSelection"]["*"][""] = Json::array({"ast"});
+		input["settings"]["outputSelection"]["*"]["*"] = Json::array({"abi", "evm.bytecode", "evm.methodIdentifiers"});
+		return input;
+	};
+
+	auto cache = std::make_shared<CompilerStack::ParsedSourceCache>();
+	solidity::frontend::StandardCompiler cachingCompiler;
+	cachingCompiler.setParsedSourceCache(cache);
+
+	Json result = cachingCompiler.compile(makeInput(sourceA, sourceB));
+	BOOST_REQUIRE(containsAtMostWarnings(result));
+	BOOST_REQUIRE(cache->entries.size() == 2);
+	std::shared_ptr<SourceUnit> astA = cache->entries.at("a.sol").ast;
+	std::shared_ptr<SourceUnit> astB = cache->entries.at("b.sol").ast;
+
+	// Only the changed source is parsed again.
+	Json input = makeInput(sourceA, changedSourceB);
+	BOOST_CHECK(cachingCompiler.compile(input) == solidity::frontend::StandardCompiler{}.compile(input));
+	BOOST_CHECK(cache->entries.at("a.sol").ast == astA);
+	BOOST_CHECK(cache->entries.at("b.sol").ast != astB);
+
+	// The node IDs of b.sol would change, so it is parsed again even though it is unchanged.
+	input = makeInput(changedSourceA, changedSourceB);
+	BOOST_CHECK(cachingCompiler.compile(input) == solidity::frontend::StandardCompiler{}.compile(input));
+	BOOST_CHECK(cache->entries.at("a.sol").ast != astA);
+
+	input = makeInput(sourceA, sourceB);
+	BOOST_CHECK(cachingCompiler.compile(input) == result);
+	BOOST_CHECK(cachingCompiler.compile(input) == result);
+}
+
+BOOST_AUTO_TEST_CASE(parsed_source_cache_is_owned_by_one_compiler_stack)
+{
+	auto cache = std::make_shared<CompilerStack::ParsedSourceCache>();
+	auto otherCache = std::make_shared<CompilerStack::ParsedSourceCache>();
+	{
+		CompilerStack compilerStack;
+		compilerStack.setParsedSourceCache(cache);
+		BOOST_CHECK(cache->owner == &compilerStack);
+		compilerStack.setParsedSourceCache(otherCache);
+		BOOST_CHECK(cache->owner == nullptr);
+		BOOST_CHECK(otherCache->owner == &compilerStack);
+	}
+	BOOST_CHECK(otherCache->owner == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(streamed_output_matches_json_output)
+{
+	// "a.sol2:A" sorts before "a.sol:B", but the output is ordered by source unit name first.
+	Json input;
+	input["language"] = "Solidity";
+	input["sources"]["a.sol"]["content"] = "contract B { function f() public {} } contract A {}";
+	input["sources"]["a.sol2"]["content"] = "contract A { function g() public pure returns (uint) { return 1; } }";
+	input["sources"]["b.sol"]["content"] = "import \"a.sol\"; contract C is B {}";
+	input["settings"]["outputSelection"]["*"][""] = Json::array({"ast"});
+	input["settings"]["outputSelection"]["*"]["*"] = Json::array({"abi", "evm.bytecode.object", "evm.assembly"});
+
+	std::string const inputString = util::jsonCompactPrint(input);
+	Json const expectedOutput = solidity::frontend::StandardCompiler{}.compile(input);
+	BOOST_REQUIRE(containsAtMostWarnings(expectedOutput));
+	BOOST_REQUIRE(expectedOutput["contracts"].size() == 3);
+
+	std::ostringstream streamedOutput;
+	solidity::frontend::StandardCompiler{}.compile(inputString, streamedOutput);
+	BOOST_CHECK_EQUAL(streamedOutput.str(), util::jsonCompactPrint(expectedOutput));
+
+	input["sources"]["b.sol"]["content"] = "contract C is B {}";
+	std::ostringstream failedOutput;
+	solidity::frontend::StandardCompiler{}.compile(util::jsonCompactPrint(input), failedOutput);
+	BOOST_CHECK_EQUAL(failedOutput.str(), util::jsonCompactPrint(solidity::frontend::StandardCompiler{}.compile(input)));
+}
+
+BOOST_AUTO_TEST_CASE(profile_artifact_timings)
+{
+	Json input;
+	input["language"] = "Solidity";
+	input["sources"]["a.sol"]["content"] = "contract A { function f() public {} } contract B {}";
+	input["settings"]["outputSelection"]["*"][""] = Json::array({"ast"});
+	input["settings"]["outputSelection"]["a.sol"]["A"] = Json::array({"abi", "evm.bytecode.object", "evm.deployedBytecode.sourceMap"});
+	input["settings"]["outputSelection"]["a.sol"]["B"] = Json::array({"metadata"});
+
+	Json result = solidity::frontend::StandardCompiler{}.compile(input);
+	BOOST_REQUIRE(containsAtMostWarnings(result));
+	BOOST_CHECK(!result["contracts"]["a.sol"]["A"].contains("profile"));
+	BOOST_CHECK(!result["sources"]["a.sol"].contains("profile"));
+
+	input["settings"]["debug"]["profile"] = true;
+	result = solidity::frontend::StandardCompiler{}.compile(input);
+	BOOST_REQUIRE(containsAtMostWarnings(result));
+	auto artifactNames = [](Json const& _timings) {
+		std::set<std::string> names;
+		for (auto const& [name, microseconds]: _timings.items())
+		{
+			BOOST_CHECK(microseconds.is_number_unsigned());
+			names.insert(name);
+		}
+		return names;
+	};
+	BOOST_CHECK((
+		artifactNames(result["contracts"]["a.sol"]["A"]["profile"]["artifacts"]) ==
+		std::set<std::string>{"abi", "evm.bytecode.object", "evm.deployedBytecode.sourceMap"}
+	));
+	BOOST_CHECK((artifactNames(result["contracts"]["a.sol"]["B"]["profile"]["artifacts"]) == std::set<std::string>{"metadata"}));
+	BOOST_CHECK((artifactNames(result["sources"]["a.sol"]["profile"]["artifacts"]) == std::set<std::string>{"ast"}));
+
+	input["settings"]["debug"]["profile"] = "yes";
+	result = solidity::frontend::StandardCompiler{}.compile(input);
+	BOOST_CHECK(containsError(result, "JSONError", "settings.debug.profile must be a Boolean."));
+}
+
+BOOST_AUTO_TEST_CASE(profile_compilation_phases)
+{
+	Json input;
+	input["language"] = "Solidity";
+	input["sources"]["a.sol"]["content"] = "contract A { function f(uint x) public pure returns (uint) { return x + 1; } }";
+	input["settings"]["viaIR"] = true;
+	input["settings"]["optimizer"]["enabled"] = true;
+	input["settings"]["outputSelection"]["*"]["*"] = Json::array({"evm.bytecode.object"});
+
+	Json result = solidity::frontend::StandardCompiler{}.compile(input);
+	BOOST_REQUIRE(containsAtMostWarnings(result));
+	BOOST_CHECK(!result.contains("profile"));
+	Json const bytecode = result["contracts"]["a.sol"]["A"]["evm"]["bytecode"]["object"];
+
+	input["settings"]["debug"]["profile"] = true;
+	result = solidity::frontend::StandardCompiler{}.compile(input);
+	BOOST_REQUIRE(containsAtMostWarnings(result));
+	BOOST_CHECK(result["contracts"]["a.sol"]["A"]["evm"]["bytecode"]["object"] == bytecode);
+
+	auto checkPhases = [](Json const& _phases, std::set<std::string> const& _expectedPhases) {
+		for (auto const& [name, metrics]: _phases.items())
+		{
+			BOOST_CHECK(metrics["calls"].is_number_unsigned());
+			BOOST_CHECK(metrics["calls"].get<size_t>() > 0);
+			BOOST_CHECK(metrics["time"].is_number_unsigned());
+			BOOST_CHECK(metrics["peakMemoryIncrease"].is_number_unsigned());
+		}
+		for (std::string const& phase: _expectedPhases)
+			BOOST_CHECK_MESSAGE(_phases.contains(phase), "Missing phase " + phase);
+	};
+	checkPhases(result["profile"]["phases"], {"Parser", "NameAndTypeResolver", "TypeChecker", "ViewPureChecker"});
+	checkPhases(
+		result["contracts"]["a.sol"]["A"]["profile"]["phases"],
+		{"IRGenerator", "ObjectOptimizer", "FunctionHoister", "StackLayoutGenerator", "EVMAssemblyOptimiser", "Assembler"}
+	);
+	BOOST_CHECK(!result["profile"]["phases"].contains("IRGenerator"));
+	BOOST_CHECK(result["profile"]["phases"]["Parser"]["calls"] == 1);
+}
+
+BOOST_AUTO_TEST_CASE(exception_after_partial_output)
+{
+	// Gas estimates are not implemented for EOF, so the generation of the output fails at b.sol:B,
+	// after the output of a.sol:A.
+	Json input;
+	input["language"] = "Solidity";
+	input["sources"]["a.sol"]["content"] = "contract A {}";
+	input["sources"]["b.sol"]["content"] = "contract B {}";
+	input["settings"]["viaIR"] = true;
+	input["settings"]["evmVersion"] = "prague";
+	input["settings"]["eofVersion"] = 1;
+	input["settings"]["outputSelection"]["*"][""] = Json::array({"ast"});
+	input["settings"]["outputSelection"]["a.sol"]["*"] = Json::array({"evm.bytecode.object"});
+	input["settings"]["outputSelection"]["b.sol"]["*"] = Json::array({"evm.bytecode.object", "evm.gasEstimates"});
+
+	// The assembled output only contains the error.
+	Json output = solidity::frontend::StandardCompiler{}.compile(input);
+	BOOST_REQUIRE(output.contains("errors") && output["errors"].size() == 1);
+	BOOST_TEST(output["errors"][0]["type"] == "UnimplementedFeatureError");
+	BOOST_TEST(output.size() == 1);
+
+	// The streamed output keeps what was written before the exception, the exception is the only error.
+	std::ostringstream streamedOutput;
+	solidity::frontend::StandardCompiler{}.compile(util::jsonCompactPrint(input), streamedOutput);
+	Json streamed;
+	BOOST_REQUIRE(util::jsonParseStrict(streamedOutput.str(), streamed));
+	BOOST_REQUIRE(streamed.contains("contracts") && streamed["contracts"].contains("a.sol"));
+	BOOST_TEST(streamed["contracts"]["a.sol"]["A"]["evm"]["bytecode"]["object"].is_string());
+	BOOST_TEST(!streamed["contracts"].contains("b.sol"));
+	BOOST_TEST(streamed["errors"] == output["errors"]);
+	BOOST_TEST(!streamed.contains("sources"));
+}
+
 BOOST_AUTO_TEST_CASE(dependency_tracking_of_abstract_contract)
 {
 	char const* input = R"(
@@ -26,6 +26,8 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include <sstream>
+
 
 namespace solidity::util::test
 {
@@ -331,6 +333,42 @@ BOOST_AUTO_TEST_CASE(json_range_checks)
 	BOOST_CHECK_THROW(get<float>(underflow["v"]), InvalidType);
 }
 
+BOOST_AUTO_TEST_CASE(json_object_stream_writer)
+{
+	Json expected;
+	expected["a"] = 1;
+	expected["b"]["c"]["d"] = "\u00e4\n";
+	expected["b"]["c"]["e"] = Json::array({1, 2});
+	expected["b"]["f"] = Json();
+	expected["b:"]["g"] = Json::object();
+	expected["c"] = true;
+
+	std::ostringstream output;
+	JsonObjectStreamWriter writer(output);
+	BOOST_CHECK(!writer.started());
+	writer.write({"a"}, 1);
+	BOOST_CHECK(writer.started());
+	writer.write({"b", "c", "d"}, "\u00e4\n");
+	writer.write({"b", "c", "e"}, Json::array({1, 2}));
+	BOOST_CHECK(!writer.accepts({"b", "c", "e"}));
+	BOOST_CHECK(!writer.accepts({"b", "c", "e", "x"}));
+	BOOST_CHECK(!writer.accepts({"b", "c"}));
+	BOOST_CHECK(!writer.accepts({"a", "z"}));
+	BOOST_CHECK(!writer.accepts({}));
+	BOOST_CHECK_THROW(writer.write({"b", "a"}, 1), BadJsonStreamOrder);
+	writer.write({"b", "f"}, Json());
+	writer.write({"b:", "g"}, Json::object());
+	writer.write({"c"}, true);
+	writer.finish();
+	BOOST_CHECK(!writer.accepts({"d"}));
+	BOOST_CHECK_EQUAL(output.str(), jsonCompactPrint(expected));
+
+	std::ostringstream emptyOutput;
+	JsonObjectStreamWriter emptyWriter(emptyOutput);
+	emptyWriter.finish();
+	BOOST_CHECK_EQUAL(emptyOutput.str(), jsonCompactPrint(Json::object()));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
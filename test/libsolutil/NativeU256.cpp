@@ -0,0 +1,187 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the allocation-free 256-bit integer, compared against boost::multiprecision.
+ */
+
+#include <libsolutil/NativeU256.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <random>
+#include <vector>
+
+namespace solidity::util::test
+{
+
+namespace
+{
+
+u256 signedToUnsigned(bigint const& _value)
+{
+	return u256(_value & ((bigint(1) << 256) - 1));
+}
+
+bigint unsignedToSigned(u256 const& _value)
+{
+	return boost::multiprecision::bit_test(_value, 255) ? bigint(_value) - (bigint(1) << 256) : bigint(_value);
+}
+
+/// Values that exercise limb and digit boundaries, mixed with random values of random length.
+std::vector<u256> testValues()
+{
+	std::vector<u256> values{0, 1, 2, 3, 7, 255, 256, 0xffffffff, u256(1) << 32, u256(1) << 64};
+	u256 const maxValue = ~u256(0);
+	for (unsigned shift: {31u, 32u, 63u, 64u, 95u, 127u, 128u, 191u, 192u, 254u, 255u})
+	{
+		values.emplace_back(u256(1) << shift);
+		values.emplace_back((u256(1) << shift) - 1);
+		values.emplace_back(maxValue - (u256(1) << shift) + 1);
+	}
+	values.emplace_back(maxValue);
+	values.emplace_back(maxValue - 1);
+
+	std::mt19937_64 generator(42);
+	for (size_t i = 0; i < 40; ++i)
+	{
+		u256 value;
+		for (size_t j = 0; j < 4; ++j)
+			value = (value << 64) | generator();
+		values.emplace_back(value >> (generator() % 256));
+	}
+	return values;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(NativeU256Test)
+
+BOOST_AUTO_TEST_CASE(conversion)
+{
+	for (u256 const& value: testValues())
+		BOOST_CHECK_EQUAL(NativeU256(value).toU256(), value);
+	BOOST_CHECK_EQUAL(NativeU256(0x1234).toU256(), u256(0x1234));
+}
+
+BOOST_AUTO_TEST_CASE(unsigned_arithmetic)
+{
+	std::vector<u256> const values = testValues();
+	for (u256 const& a: values)
+		for (u256 const& b: values)
+		{
+			NativeU256 x(a);
+			NativeU256 y(b);
+			BOOST_CHECK_EQUAL((x + y).toU256(), u256(a + b));
+			BOOST_CHECK_EQUAL((x - y).toU256(), u256(a - b));
+			BOOST_CHECK_EQUAL((x * y).toU256(), u256(a * b));
+			BOOST_CHECK_EQUAL((x / y).toU256(), b == 0 ? u256(0) : u256(a / b));
+			BOOST_CHECK_EQUAL((x % y).toU256(), b == 0 ? u256(0) : u256(a % b));
+			BOOST_CHECK_EQUAL((x & y).toU256(), u256(a & b));
+			BOOST_CHECK_EQUAL((x | y).toU256(), u256(a | b));
+			BOOST_CHECK_EQUAL((x ^ y).toU256(), u256(a ^ b));
+			BOOST_CHECK_EQUAL(x < y, a < b);
+			BOOST_CHECK_EQUAL(x == y, a == b);
+		}
+}
+
+BOOST_AUTO_TEST_CASE(shifts)
+{
+	for (u256 const& value: testValues())
+		for (unsigned amount: {0u, 1u, 31u, 32u, 63u, 64u, 65u, 128u, 200u, 255u, 256u, 1000u})
+		{
+			NativeU256 x(value);
+			u256 expectedLeft = amount >= 256 ? u256(0) : u256(value << amount);
+			u256 expectedRight = amount >= 256 ? u256(0) : u256(value >> amount);
+			BOOST_CHECK_EQUAL((x << amount).toU256(), expectedLeft);
+			BOOST_CHECK_EQUAL((x >> amount).toU256(), expectedRight);
+			bigint expectedArithmetic = unsignedToSigned(value) >> std::min(amount, 256u);
+			BOOST_CHECK_EQUAL(sar(x, amount).toU256(), signedToUnsigned(expectedArithmetic));
+		}
+}
+
+BOOST_AUTO_TEST_CASE(signed_arithmetic)
+{
+	std::vector<u256> const values = testValues();
+	for (u256 const& a: values)
+		for (u256 const& b: values)
+		{
+			NativeU256 x(a);
+			NativeU256 y(b);
+			bigint signedA = unsignedToSigned(a);
+			bigint signedB = unsignedToSigned(b);
+			// boost rounds towards zero and the remainder takes the sign of the dividend, like the EVM.
+			BOOST_CHECK_EQUAL(sdiv(x, y).toU256(), b == 0 ? u256(0) : signedToUnsigned(signedA / signedB));
+			BOOST_CHECK_EQUAL(smod(x, y).toU256(), b == 0 ? u256(0) : signedToUnsigned(signedA % signedB));
+			BOOST_CHECK_EQUAL(slt(x, y), signedA < signedB);
+			BOOST_CHECK_EQUAL(sgt(x, y), signedA > signedB);
+		}
+}
+
+BOOST_AUTO_TEST_CASE(modular_arithmetic)
+{
+	std::vector<u256> const values = testValues();
+	for (u256 const& a: values)
+		for (u256 const& b: values)
+			for (u256 const& modulus: {u256(0), u256(1), u256(7), a ^ b, a | 1, ~u256(0), ~u256(0) >> 100})
+			{
+				NativeU256 x(a);
+				NativeU256 y(b);
+				NativeU256 m(modulus);
+				u256 expectedSum = modulus == 0 ? u256(0) : u256((bigint(a) + bigint(b)) % bigint(modulus));
+				u256 expectedProduct = modulus == 0 ? u256(0) : u256((bigint(a) * bigint(b)) % bigint(modulus));
+				BOOST_CHECK_EQUAL(addmod(x, y, m).toU256(), expectedSum);
+				BOOST_CHECK_EQUAL(mulmod(x, y, m).toU256(), expectedProduct);
+			}
+}
+
+BOOST_AUTO_TEST_CASE(exponentiation)
+{
+	std::vector<u256> const values = testValues();
+	for (u256 const& base: values)
+		for (u256 const& exponent: values)
+			BOOST_CHECK_EQUAL(exp(NativeU256(base), NativeU256(exponent)).toU256(), exp256(base, exponent));
+}
+
+BOOST_AUTO_TEST_CASE(sign_extension)
+{
+	for (u256 const& value: testValues())
+		for (unsigned byteIndex = 0; byteIndex < 34; ++byteIndex)
+		{
+			u256 expected = value;
+			if (byteIndex < 31)
+			{
+				unsigned signBit = byteIndex * 8 + 7;
+				u256 mask = (u256(1) << signBit) - 1;
+				expected = boost::multiprecision::bit_test(value, signBit) ? u256(value | ~mask) : u256(value & mask);
+			}
+			BOOST_CHECK_EQUAL(signextend(byteIndex, NativeU256(value)).toU256(), expected);
+		}
+}
+
+BOOST_AUTO_TEST_CASE(bit_length)
+{
+	BOOST_CHECK_EQUAL(NativeU256(0).bitLength(), 0);
+	BOOST_CHECK_EQUAL(NativeU256(1).bitLength(), 1);
+	for (u256 const& value: testValues())
+		if (value != 0)
+			BOOST_CHECK_EQUAL(NativeU256(value).bitLength(), boost::multiprecision::msb(value) + 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -0,0 +1,151 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolutil/Parallel.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace solidity::util::test
+{
+
+BOOST_AUTO_TEST_SUITE(ParallelTests, *boost::unit_test::label("nooptions"))
+
+BOOST_AUTO_TEST_CASE(every_index_visited_exactly_once)
+{
+	for (size_t threads: {0u, 1u, 2u, 8u, 100u})
+	{
+		std::vector<std::atomic<size_t>> visits(57);
+		parallelFor(visits.size(), threads, [&](size_t _index) { ++visits[_index]; });
+		for (std::atomic<size_t> const& count: visits)
+			BOOST_CHECK_EQUAL(count.load(), 1);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(empty_range)
+{
+	bool called = false;
+	parallelFor(0, 4, [&](size_t) { called = true; });
+	BOOST_CHECK(!called);
+}
+
+BOOST_AUTO_TEST_CASE(sequential_when_single_thread)
+{
+	std::vector<size_t> order;
+	parallelFor(5, 1, [&](size_t _index) { order.push_back(_index); });
+	BOOST_CHECK(order == (std::vector<size_t>{0, 1, 2, 3, 4}));
+}
+
+BOOST_AUTO_TEST_CASE(rethrows_exception_of_lowest_index)
+{
+	for (size_t threads: {1u, 4u})
+	{
+		std::string message;
+		try
+		{
+			parallelFor(20, threads, [](size_t _index) {
+				if (_index == 7 || _index == 13)
+					throw std::runtime_error(std::to_string(_index));
+			});
+		}
+		catch (std::runtime_error const& _error)
+		{
+			message = _error.what();
+		}
+		BOOST_CHECK_EQUAL(message, "7");
+	}
+}
+
+BOOST_AUTO_TEST_CASE(thread_pool_every_index_visited_exactly_once)
+{
+	ThreadPool threadPool(3);
+	ThreadPool::Scope scope(&threadPool);
+	for (size_t threads: {1u, 2u, 4u, 100u})
+	{
+		std::vector<std::atomic<size_t>> visits(57);
+		parallelFor(visits.size(), threads, [&](size_t _index) { ++visits[_index]; });
+		for (std::atomic<size_t> const& count: visits)
+			BOOST_CHECK_EQUAL(count.load(), 1);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(thread_pool_reuses_threads)
+{
+	ThreadPool threadPool(3);
+	ThreadPool::Scope scope(&threadPool);
+	std::mutex mutex;
+	std::set<std::thread::id> threadIDs;
+	std::atomic<bool> poolActive = true;
+	for (size_t call = 0; call < 20; ++call)
+		parallelFor(40, 4, [&](size_t) {
+			if (ThreadPool::current() != &threadPool)
+				poolActive = false;
+			std::lock_guard lock(mutex);
+			threadIDs.insert(std::this_thread::get_id());
+		});
+	BOOST_CHECK(poolActive);
+	// The workers of the pool and the calling thread.
+	BOOST_CHECK(!threadIDs.empty() && threadIDs.size() <= 4);
+}
+
+BOOST_AUTO_TEST_CASE(thread_pool_nested_calls)
+{
+	ThreadPool threadPool(2);
+	ThreadPool::Scope scope(&threadPool);
+	std::vector<std::atomic<size_t>> visits(8 * 8);
+	parallelFor(8, 8, [&](size_t _outer) {
+		parallelFor(8, 8, [&](size_t _inner) { ++visits[_outer * 8 + _inner]; });
+	});
+	for (std::atomic<size_t> const& count: visits)
+		BOOST_CHECK_EQUAL(count.load(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(thread_pool_rethrows_exception_of_lowest_index)
+{
+	ThreadPool threadPool(3);
+	ThreadPool::Scope scope(&threadPool);
+	std::string message;
+	try
+	{
+		parallelFor(20, 4, [](size_t _index) {
+			if (_index == 7 || _index == 13)
+				throw std::runtime_error(std::to_string(_index));
+		});
+	}
+	catch (std::runtime_error const& _error)
+	{
+		message = _error.what();
+	}
+	BOOST_CHECK_EQUAL(message, "7");
+
+	// The pool is still usable afterwards.
+	std::atomic<size_t> calls = 0;
+	parallelFor(20, 4, [&](size_t) { ++calls; });
+	BOOST_CHECK_EQUAL(calls.load(), 20);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
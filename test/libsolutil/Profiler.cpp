@@ -0,0 +1,105 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+
+#include <libsolutil/Parallel.h>
+#include <libsolutil/Profiler.h>
+
+#include <boost/test/unit_test.hpp>
+
+namespace solidity::util::test
+{
+
+BOOST_AUTO_TEST_SUITE(ProfilerTests, *boost::unit_test::label("nooptions"))
+
+BOOST_AUTO_TEST_CASE(probes_without_active_profiler)
+{
+	BOOST_CHECK(Profiler::current() == nullptr);
+	PROFILER_PROBE("scope", probe);
+
+	Profiler profiler;
+	{
+		Profiler::Scope scope(&profiler);
+		BOOST_CHECK(Profiler::current() == &profiler);
+		Profiler::Scope innerScope(nullptr);
+		PROFILER_PROBE("scope", innerProbe);
+	}
+	BOOST_CHECK(Profiler::current() == nullptr);
+	BOOST_CHECK(profiler.metrics().empty());
+}
+
+BOOST_AUTO_TEST_CASE(metrics_aggregated_by_scope_name)
+{
+	Profiler profiler;
+	{
+		Profiler::Scope scope(&profiler);
+		for (size_t i = 0; i < 3; ++i)
+		{
+			PROFILER_PROBE("outer", outerProbe);
+			PROFILER_PROBE("inner", innerProbe);
+		}
+		PROFILER_PROBE(std::string("inner"), probe);
+	}
+
+	auto const metrics = profiler.metrics();
+	BOOST_REQUIRE_EQUAL(metrics.size(), 2);
+	BOOST_CHECK_EQUAL(metrics.at("outer").callCount, 3);
+	BOOST_CHECK_EQUAL(metrics.at("inner").callCount, 4);
+	BOOST_CHECK(metrics.at("outer").durationInMicroseconds >= std::chrono::microseconds(0));
+
+	Json const json = profiler.toJson();
+	BOOST_CHECK_EQUAL(json["outer"]["calls"], 3);
+	BOOST_CHECK(json["inner"]["time"].is_number_unsigned());
+	BOOST_CHECK(json["inner"]["peakMemoryIncrease"].is_number_unsigned());
+}
+
+BOOST_AUTO_TEST_CASE(nested_profilers)
+{
+	Profiler outer;
+	Profiler inner;
+	{
+		Profiler::Scope outerScope(&outer);
+		PROFILER_PROBE("a", outerProbe);
+		{
+			Profiler::Scope innerScope(&inner);
+			PROFILER_PROBE("b", innerProbe);
+		}
+		PROFILER_PROBE("c", anotherOuterProbe);
+	}
+	BOOST_CHECK_EQUAL(outer.metrics().count("a"), 1);
+	BOOST_CHECK_EQUAL(outer.metrics().count("b"), 0);
+	BOOST_CHECK_EQUAL(outer.metrics().count("c"), 1);
+	BOOST_CHECK_EQUAL(inner.metrics().size(), 1);
+	BOOST_CHECK_EQUAL(inner.metrics().count("b"), 1);
+}
+
+BOOST_AUTO_TEST_CASE(parallel_for_records_in_calling_profiler)
+{
+	Profiler profiler;
+	{
+		Profiler::Scope scope(&profiler);
+		parallelFor(40, 4, [](size_t) {
+			PROFILER_PROBE("task", probe);
+		});
+	}
+	BOOST_CHECK_EQUAL(profiler.metrics().at("task").callCount, 40);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -0,0 +1,121 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+
+#include <libsolutil/Parallel.h>
+#include <libsolutil/Profiler.h>
+#include <libsolutil/Tracer.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <set>
+
+namespace solidity::util::test
+{
+
+BOOST_AUTO_TEST_SUITE(TracerTests, *boost::unit_test::label("nooptions"))
+
+BOOST_AUTO_TEST_CASE(spans_without_active_tracer)
+{
+	Tracer tracer;
+	{
+		Tracer::Span span("ignored", "test");
+		Tracer::Scope scope(&tracer);
+		Tracer::Scope innerScope(nullptr);
+		Tracer::Span innerSpan("ignored", "test");
+	}
+	BOOST_CHECK(Tracer::current() == nullptr);
+	BOOST_CHECK(tracer.toJson()["traceEvents"].empty());
+}
+
+BOOST_AUTO_TEST_CASE(spans_and_probes_recorded_as_complete_events)
+{
+	Tracer tracer;
+	{
+		Tracer::Scope scope(&tracer);
+		Tracer::Span span("C", "contract");
+		PROFILER_PROBE("TypeChecker", probe);
+	}
+
+	Json const trace = tracer.toJson();
+	BOOST_CHECK_EQUAL(trace["displayTimeUnit"], "ms");
+	Json const& events = trace["traceEvents"];
+	BOOST_REQUIRE_EQUAL(events.size(), 2);
+	// Events are recorded when their spans end, i.e. inner ones first.
+	BOOST_CHECK_EQUAL(events[0]["name"], "TypeChecker");
+	BOOST_CHECK_EQUAL(events[0]["cat"], "phase");
+	BOOST_CHECK_EQUAL(events[1]["name"], "C");
+	BOOST_CHECK_EQUAL(events[1]["cat"], "contract");
+	for (Json const& event: events)
+	{
+		BOOST_CHECK_EQUAL(event["ph"], "X");
+		BOOST_CHECK_EQUAL(event["pid"], 1);
+		BOOST_CHECK_EQUAL(event["tid"], 0);
+		BOOST_CHECK(event["ts"].get<int64_t>() >= 0);
+		BOOST_CHECK(event["dur"].get<int64_t>() >= 0);
+	}
+	BOOST_CHECK(events[1]["ts"].get<int64_t>() <= events[0]["ts"].get<int64_t>());
+	BOOST_CHECK(
+		events[0]["ts"].get<int64_t>() + events[0]["dur"].get<int64_t>() <=
+		events[1]["ts"].get<int64_t>() + events[1]["dur"].get<int64_t>()
+	);
+}
+
+BOOST_AUTO_TEST_CASE(parallel_for_records_in_calling_tracer)
+{
+	Tracer tracer;
+	{
+		Tracer::Scope scope(&tracer);
+		parallelFor(40, 4, [](size_t) {
+			Tracer::Span span("task", "test");
+		});
+	}
+
+	Json const events = tracer.toJson()["traceEvents"];
+	BOOST_CHECK_EQUAL(events.size(), 40);
+	std::set<size_t> threadIDs;
+	for (Json const& event: events)
+		threadIDs.insert(event["tid"].get<size_t>());
+	BOOST_CHECK(!threadIDs.empty() && threadIDs.size() <= 4);
+	BOOST_CHECK(*threadIDs.rbegin() == threadIDs.size() - 1);
+}
+
+BOOST_AUTO_TEST_CASE(thread_pool_records_in_calling_tracer)
+{
+	ThreadPool threadPool(3);
+	ThreadPool::Scope threadPoolScope(&threadPool);
+	for (size_t call = 0; call < 2; ++call)
+	{
+		Tracer tracer;
+		{
+			Tracer::Scope scope(&tracer);
+			parallelFor(40, 4, [](size_t) {
+				Tracer::Span span("task", "test");
+			});
+		}
+		BOOST_CHECK_EQUAL(tracer.toJson()["traceEvents"].size(), 40);
+	}
+	// The workers must not keep using the tracers of earlier calls, which no longer exist.
+	parallelFor(40, 4, [](size_t) {
+		Tracer::Span span("task", "test");
+	});
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
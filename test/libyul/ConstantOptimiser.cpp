@@ -0,0 +1,136 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the sharing and parallelisation of the constant optimiser's search.
+ */
+
+#include <test/Common.h>
+
+#include <test/libyul/Common.h>
+
+#include <libyul/backends/evm/ConstantOptimiser.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/backends/evm/EVMMetrics.h>
+#include <libyul/AsmPrinter.h>
+#include <libyul/AST.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace solidity::langutil;
+
+namespace solidity::yul::test
+{
+
+namespace
+{
+
+EVMDialect const& evmDialect()
+{
+	return EVMDialect::strictAssemblyForEVM(
+		solidity::test::CommonOptions::get().evmVersion(),
+		solidity::test::CommonOptions::get().eofVersion()
+	);
+}
+
+/// Checks that @a _expression and all its sub-expressions are located at @a _location.
+void checkLocation(Expression const& _expression, SourceLocation const& _location)
+{
+	BOOST_CHECK(nativeLocationOf(_expression) == _location);
+	if (FunctionCall const* call = std::get_if<FunctionCall>(&_expression))
+		for (Expression const& argument: call->arguments)
+			checkLocation(argument, _location);
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(YulConstantOptimiser)
+
+BOOST_AUTO_TEST_CASE(same_result_for_all_thread_counts_and_cache_states)
+{
+	std::string const source = R"({
+		let a := 0x10000000000000000000000000000000000000000000
+		let x := 0x11000000000000000000000000000000000000ffffffffffffffffffffffff23
+		let y := 0xfffffffff00000000000000000000000000000000000000000000000000000ff
+		let z := 0xffff0000ffff0000ffff0000ffff0000ff00ff00ffff0000ffff0000ffff0000
+		let w := 0xffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff00
+		let s := 0xffff
+		function f(v) -> r {
+			r := add(v, 0x10000000000000000000000000000000000000000000)
+			if gt(r, 0xfffffffff00000000000000000000000000000000000000000000000000000ff) {
+				r := 0x8000000000000000000000000000000000000000000000000000000000000000
+			}
+		}
+		sstore(add(a, s), f(add(x, add(y, add(z, w)))))
+	})";
+	std::vector<GasMeter> const meters{
+		GasMeter(evmDialect(), false, 200),
+		GasMeter(evmDialect(), true, 200),
+		GasMeter(evmDialect(), false, 1),
+		GasMeter(evmDialect(), false, 100000),
+	};
+	auto optimise = [&](GasMeter const& _meter, size_t _maxThreads) {
+		Block block = disambiguate(source);
+		ConstantOptimiser{evmDialect(), _meter, _maxThreads}(block);
+		return AsmPrinter{evmDialect()}(block);
+	};
+
+	std::vector<std::string> coldResults;
+	for (GasMeter const& meter: meters)
+	{
+		ConstantOptimiser::clearRepresentationCache();
+		coldResults.emplace_back(optimise(meter, 1));
+		ConstantOptimiser::clearRepresentationCache();
+		BOOST_CHECK_EQUAL(optimise(meter, 4), coldResults.back());
+	}
+
+	// The cache is shared by all gas meters and filled by the ones that run earlier.
+	ConstantOptimiser::clearRepresentationCache();
+	for (size_t maxThreads: std::vector<size_t>{1, 4, 1, 8})
+		for (size_t i = 0; i < meters.size(); ++i)
+			BOOST_CHECK_EQUAL(optimise(meters[i], maxThreads), coldResults[i]);
+	ConstantOptimiser::clearRepresentationCache();
+}
+
+BOOST_AUTO_TEST_CASE(replacements_are_located_at_the_replaced_literal)
+{
+	Block block = disambiguate(R"({
+		let a := 0x10000000000000000000000000000000000000000000
+		let b := 0x10000000000000000000000000000000000000000000
+		sstore(a, b)
+	})");
+	std::vector<SourceLocation> locations;
+	for (size_t i = 0; i < 2; ++i)
+		locations.emplace_back(nativeLocationOf(*std::get<VariableDeclaration>(block.statements.at(i)).value));
+	BOOST_REQUIRE(locations[0] != locations[1]);
+
+	GasMeter meter(evmDialect(), false, 200);
+	ConstantOptimiser{evmDialect(), meter, 4}(block);
+
+	// Each replacement takes the location of the literal it replaces, not the one of the first literal
+	// with the same value.
+	for (size_t i = 0; i < 2; ++i)
+	{
+		Expression const& value = *std::get<VariableDeclaration>(block.statements.at(i)).value;
+		BOOST_REQUIRE(std::holds_alternative<FunctionCall>(value));
+		checkLocation(value, locations[i]);
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
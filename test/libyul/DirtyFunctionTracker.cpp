@@ -0,0 +1,284 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the tracking of functions that optimiser steps left unchanged.
+ */
+
+#include <test/libyul/Common.h>
+#include <test/Common.h>
+
+#include <libyul/optimiser/DirtyFunctionTracker.h>
+#include <libyul/optimiser/CommonSubexpressionEliminator.h>
+#include <libyul/optimiser/ExpressionSimplifier.h>
+#include <libyul/optimiser/ForLoopInitRewriter.h>
+#include <libyul/optimiser/FunctionGrouper.h>
+#include <libyul/optimiser/FunctionHoister.h>
+#include <libyul/optimiser/LoadResolver.h>
+#include <libyul/optimiser/NameDispenser.h>
+#include <libyul/optimiser/OptimiserStep.h>
+#include <libyul/optimiser/Suite.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/AsmPrinter.h>
+#include <libyul/AST.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <mutex>
+
+using namespace solidity;
+using namespace solidity::yul;
+using namespace solidity::yul::test;
+
+namespace
+{
+
+Dialect const& evmDialect()
+{
+	return EVMDialect::strictAssemblyForEVM(
+		solidity::test::CommonOptions::get().evmVersion(),
+		solidity::test::CommonOptions::get().eofVersion()
+	);
+}
+
+/// Runs the given step and records the names of the top-level functions it was run on.
+template <class Step>
+struct RecordingStep: public OptimiserStep
+{
+	RecordingStep(): OptimiserStep{Step::name} {}
+	void run(OptimiserStepContext& _context, Block& _ast) const override
+	{
+		std::vector<std::string> names;
+		for (Statement const& statement: _ast.statements)
+			if (auto const* function = std::get_if<FunctionDefinition>(&statement))
+				names.emplace_back(function->name.str());
+			else
+				names.emplace_back("{}");
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			seen.emplace_back(std::move(names));
+		}
+		Step::run(_context, _ast);
+	}
+	std::optional<std::string> invalidInCurrentEnvironment() const override { return std::nullopt; }
+
+	mutable std::mutex mutex;
+	mutable std::vector<std::vector<std::string>> seen;
+};
+
+/// Disambiguates, hoists and groups the given code, rewrites its for loop initialisers and provides a step context for it.
+struct Setup
+{
+	explicit Setup(std::string const& _source):
+		ast(disambiguate(_source)),
+		dispenser(evmDialect(), ast),
+		context{evmDialect(), dispenser, reserved, {}}
+	{
+		FunctionHoister::run(context, ast);
+		FunctionGrouper::run(context, ast);
+		ForLoopInitRewriter::run(context, ast);
+	}
+
+	Block ast;
+	NameDispenser dispenser;
+	std::set<YulName> reserved;
+	OptimiserStepContext context;
+};
+
+using Names = std::vector<std::string>;
+
+}
+
+BOOST_AUTO_TEST_SUITE(YulDirtyFunctionTracker)
+
+BOOST_AUTO_TEST_CASE(unchanged_functions_are_skipped)
+{
+	Setup setup(R"({
+		sstore(0, f(1))
+		function f(a) -> r { r := add(a, add(1, 2)) }
+		function g(a) -> r { r := a }
+	})");
+
+	RecordingStep<ExpressionSimplifier> step;
+	DirtyFunctionTracker tracker{evmDialect()};
+	for (size_t i = 0; i < 3; ++i)
+		tracker.run(step, setup.context, setup.ast);
+
+	BOOST_REQUIRE_EQUAL(step.seen.size(), 3);
+	BOOST_CHECK((step.seen[0] == Names{"{}", "f", "g"}));
+	// Only ``f`` was simplified by the first run.
+	BOOST_CHECK((step.seen[1] == Names{"f"}));
+	BOOST_CHECK((step.seen[2] == Names{}));
+}
+
+BOOST_AUTO_TEST_CASE(callers_of_changed_functions_are_revisited)
+{
+	Setup setup(R"({
+		sstore(0, f(1))
+		function f(a) -> r { r := g(a) }
+		function g(a) -> r { r := a }
+		function h(a) -> r { r := a }
+	})");
+
+	RecordingStep<CommonSubexpressionEliminator> step;
+	DirtyFunctionTracker tracker{evmDialect()};
+	tracker.run(step, setup.context, setup.ast);
+
+	// Change ``g`` behind the back of the tracker.
+	FunctionDefinition& g = std::get<FunctionDefinition>(setup.ast.statements.at(2));
+	BOOST_REQUIRE_EQUAL(g.name.str(), "g");
+	g.body.statements.clear();
+	tracker.resetCache();
+	tracker.run(step, setup.context, setup.ast);
+
+	BOOST_REQUIRE_EQUAL(step.seen.size(), 2);
+	BOOST_CHECK((step.seen[0] == Names{"{}", "f", "g", "h"}));
+	// The code block calls ``f``, which calls ``g``. ``h`` is not affected.
+	BOOST_CHECK((step.seen[1] == Names{"{}", "f", "g"}));
+}
+
+BOOST_AUTO_TEST_CASE(msize_outside_of_changed_functions_is_taken_into_account)
+{
+	Setup setup(R"({
+		sstore(0, msize())
+		sstore(1, f(2))
+		function f(a) -> r { r := a }
+	})");
+
+	RecordingStep<LoadResolver> step;
+	DirtyFunctionTracker tracker{evmDialect()};
+	tracker.run(step, setup.context, setup.ast);
+
+	// Change ``f`` behind the back of the tracker, so that only ``f`` is run on next time.
+	Block replacement = disambiguate(R"({
+		function f(a) -> r { let v := 7 mstore(a, v) r := mload(a) }
+	})");
+	FunctionDefinition& f = std::get<FunctionDefinition>(setup.ast.statements.at(1));
+	BOOST_REQUIRE_EQUAL(f.name.str(), "f");
+	f.body = std::move(std::get<FunctionDefinition>(replacement.statements.at(0)).body);
+	tracker.resetCache();
+	tracker.run(step, setup.context, setup.ast);
+
+	BOOST_REQUIRE_EQUAL(step.seen.size(), 2);
+	BOOST_CHECK((step.seen[1] == Names{"f"}));
+	// The code block uses msize, so the memory load must not be resolved.
+	BOOST_CHECK(AsmPrinter{evmDialect()}(setup.ast).find("mload(a)") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(small_asts_are_processed_serially)
+{
+	std::string const source = R"({
+		sstore(0, f(1))
+		function f(a) -> r { r := add(a, add(1, 2)) }
+		function g(a) -> r { r := add(a, add(3, 4)) }
+	})";
+
+	Setup serialSetup(source);
+	serialSetup.context.maxThreads = 4;
+	RecordingStep<ExpressionSimplifier> serialStep;
+	DirtyFunctionTracker{evmDialect()}.run(serialStep, serialSetup.context, serialSetup.ast);
+	BOOST_REQUIRE_EQUAL(serialStep.seen.size(), 1);
+	BOOST_CHECK((serialStep.seen[0] == Names{"{}", "f", "g"}));
+
+	Setup concurrentSetup(source);
+	concurrentSetup.context.maxThreads = 4;
+	RecordingStep<ExpressionSimplifier> concurrentStep;
+	DirtyFunctionTracker{evmDialect(), 1}.run(concurrentStep, concurrentSetup.context, concurrentSetup.ast);
+	std::sort(concurrentStep.seen.begin(), concurrentStep.seen.end());
+	BOOST_CHECK((concurrentStep.seen == std::vector<Names>{{"f"}, {"g"}, {"{}"}}));
+}
+
+BOOST_AUTO_TEST_CASE(same_result_as_without_tracking_and_threads)
+{
+	std::vector<std::string> const sources = {
+		R"({
+			let x := calldataload(0)
+			sstore(f(x), g(x))
+			function f(a) -> r {
+				let b := add(a, 0)
+				r := mul(b, add(2, 3))
+				if gt(r, 7) { r := g(r) }
+			}
+			function g(a) -> r {
+				for { let i := 0 } lt(i, a) { i := add(i, 1) } { r := add(r, mload(mul(i, 0x20))) }
+			}
+			function h(a) -> r { r := f(add(a, 1)) }
+		})",
+		// ``msize`` in the code block affects how memory is optimised in all functions.
+		R"({
+			let x := calldataload(0)
+			sstore(f(x), g(x))
+			sstore(1, msize())
+			function f(a) -> r {
+				mstore(a, 7)
+				r := mload(a)
+				if gt(r, 7) { r := g(r) }
+			}
+			function g(a) -> r {
+				let t := mload(0x80)
+				mstore(0x80, a)
+				r := add(t, mload(0x80))
+			}
+		})",
+		// ``msize`` in a function that is not called by the others.
+		R"({
+			let x := calldataload(0)
+			sstore(f(x), h(x))
+			function f(a) -> r {
+				mstore(a, 7)
+				r := mload(a)
+			}
+			function g(a) -> r {
+				mstore(0x80, a)
+				r := mload(0x80)
+			}
+			function h(a) -> r {
+				mstore(a, 1)
+				r := add(msize(), g(a))
+			}
+		})",
+	};
+	std::vector<std::string> steps;
+	for (size_t round = 0; round < 3; ++round)
+		for (char abbreviation: std::string_view{"xasCcLMTDtnfVscrSEU"})
+			steps.emplace_back(OptimiserSuite::stepAbbreviationToNameMap().at(abbreviation));
+
+	auto optimise = [&](std::string const& _source, bool _tracked, size_t _maxThreads, size_t _minSizePerThread) {
+		Setup setup(_source);
+		setup.context.maxThreads = _maxThreads;
+		DirtyFunctionTracker tracker{evmDialect(), _minSizePerThread};
+		for (std::string const& step: steps)
+			if (_tracked)
+				tracker.run(*OptimiserSuite::allSteps().at(step), setup.context, setup.ast);
+			else
+				OptimiserSuite::allSteps().at(step)->run(setup.context, setup.ast);
+		return AsmPrinter{evmDialect()}(setup.ast);
+	};
+
+	size_t const defaultSize = DirtyFunctionTracker::defaultMinSizePerThread;
+	for (std::string const& source: sources)
+	{
+		std::string expectation = optimise(source, false, 1, defaultSize);
+		BOOST_CHECK_EQUAL(optimise(source, true, 1, defaultSize), expectation);
+		BOOST_CHECK_EQUAL(optimise(source, true, 4, defaultSize), expectation);
+		// Forces the functions of these small sources to be processed concurrently.
+		BOOST_CHECK_EQUAL(optimise(source, true, 4, 1), expectation);
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
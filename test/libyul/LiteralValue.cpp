@@ -0,0 +1,182 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the values of Yul literals.
+ */
+
+#include <libyul/optimiser/BlockHasher.h>
+#include <libyul/optimiser/SyntacticalEquality.h>
+#include <libyul/AST.h>
+#include <libyul/Utilities.h>
+
+#include <libsolutil/FixedHash.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <set>
+#include <string>
+
+using namespace solidity::util;
+
+namespace solidity::yul::test
+{
+
+namespace
+{
+
+Literal makeLiteral(std::string const& _text, LiteralKind _kind, bool _unlimited = false)
+{
+	return Literal{{}, _kind, valueOfLiteral(_text, _kind, _unlimited)};
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(YulLiteralValue, *boost::unit_test::label("nooptions"))
+
+BOOST_AUTO_TEST_CASE(format_and_value_round_trip)
+{
+	struct Case
+	{
+		std::string text;
+		LiteralKind kind;
+		u256 value;
+	};
+	for (Case const& testCase: std::vector<Case>{
+		{"0x0a", LiteralKind::Number, 10},
+		{"0xffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff", LiteralKind::Number, ~u256(0)},
+		{"10", LiteralKind::Number, 10},
+		{"0", LiteralKind::Number, 0},
+		{"abc", LiteralKind::String, u256(h256("abc", h256::FromBinary, h256::AlignLeft))},
+		{"", LiteralKind::String, 0},
+		{"true", LiteralKind::Boolean, 1},
+		{"false", LiteralKind::Boolean, 0},
+	})
+	{
+		BOOST_TEST_CONTEXT(testCase.text)
+		{
+			Literal const literal = makeLiteral(testCase.text, testCase.kind);
+			BOOST_CHECK(validLiteral(literal));
+			BOOST_CHECK(!literal.value.unlimited());
+			BOOST_CHECK_EQUAL(literal.value.value(), testCase.value);
+			BOOST_CHECK_EQUAL(formatLiteral(literal), testCase.text);
+
+			// Copies share the representation hint.
+			Literal const copy = literal;
+			BOOST_CHECK(copy.value.hint() == literal.value.hint());
+			BOOST_CHECK_EQUAL(copy.value.value(), testCase.value);
+			BOOST_CHECK_EQUAL(formatLiteral(copy), testCase.text);
+
+			// Parsing the formatted literal gives the same value again.
+			BOOST_CHECK_EQUAL(valueOfLiteral(formatLiteral(literal), testCase.kind).value(), testCase.value);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(value_without_hint)
+{
+	Literal const number{{}, LiteralKind::Number, LiteralValue{u256(0xff)}};
+	BOOST_CHECK(!number.value.unlimited());
+	BOOST_CHECK(number.value.hint() == nullptr);
+	BOOST_CHECK(validLiteral(number));
+	BOOST_CHECK_EQUAL(formatLiteral(number), "255");
+
+	Literal const boolean{{}, LiteralKind::Boolean, LiteralValue{true}};
+	BOOST_CHECK(boolean.value.hint() == nullptr);
+	BOOST_CHECK_EQUAL(formatLiteral(boolean), "true");
+
+	Literal const hexOnly{{}, LiteralKind::Number, LiteralValue{u256(0xff), std::string("0xff")}};
+	BOOST_REQUIRE(hexOnly.value.hint() != nullptr);
+	BOOST_CHECK_EQUAL(*hexOnly.value.hint(), "0xff");
+	BOOST_CHECK_EQUAL(formatLiteral(hexOnly), "0xff");
+}
+
+BOOST_AUTO_TEST_CASE(unlimited_string)
+{
+	std::string const text = "a builtin argument that is longer than thirty-two bytes";
+	Literal const literal = makeLiteral(text, LiteralKind::String, true);
+	BOOST_CHECK(literal.value.unlimited());
+	BOOST_CHECK(validLiteral(literal));
+	BOOST_CHECK_EQUAL(literal.value.builtinStringLiteralValue(), text);
+	BOOST_CHECK_EQUAL(formatLiteral(literal), text);
+
+	Literal const copy = literal;
+	BOOST_CHECK(copy.value.unlimited());
+	BOOST_CHECK_EQUAL(copy.value.builtinStringLiteralValue(), text);
+
+	// Short builtin arguments are unlimited as well, regardless of their length.
+	Literal const shortLiteral = makeLiteral("abc", LiteralKind::String, true);
+	BOOST_CHECK(shortLiteral.value.unlimited());
+	BOOST_CHECK_EQUAL(formatLiteral(shortLiteral), "abc");
+}
+
+BOOST_AUTO_TEST_CASE(equality_ignores_hint)
+{
+	LiteralValue const hex = valueOfNumberLiteral("0x0a");
+	LiteralValue const decimal = valueOfNumberLiteral("10");
+	LiteralValue const withoutHint{u256(10)};
+	BOOST_CHECK(hex == decimal);
+	BOOST_CHECK(hex == withoutHint);
+	BOOST_CHECK(!(hex < decimal) && !(decimal < hex));
+	BOOST_CHECK(valueOfNumberLiteral("9") < hex);
+
+	// Strings and numbers with the same value are equal.
+	BOOST_CHECK(valueOfStringLiteral("a") == LiteralValue{u256(u256(0x61) << 248)});
+	BOOST_CHECK(valueOfBoolLiteral("true") == valueOfNumberLiteral("1"));
+}
+
+BOOST_AUTO_TEST_CASE(unlimited_and_limited_are_distinct)
+{
+	LiteralValue const limited = valueOfStringLiteral("abc");
+	LiteralValue const unlimited = valueOfBuiltinStringLiteralArgument("abc");
+	BOOST_CHECK(!(limited == unlimited));
+	BOOST_CHECK(limited < unlimited);
+	BOOST_CHECK(!(unlimited < limited));
+	BOOST_CHECK(unlimited == valueOfBuiltinStringLiteralArgument("abc"));
+	BOOST_CHECK(valueOfBuiltinStringLiteralArgument("abb") < unlimited);
+
+	std::set<LiteralValue> const values{
+		limited,
+		unlimited,
+		valueOfBuiltinStringLiteralArgument("abc"),
+		valueOfNumberLiteral(u256(h256("abc", h256::FromBinary, h256::AlignLeft)).str()),
+	};
+	BOOST_CHECK_EQUAL(values.size(), 2u);
+}
+
+BOOST_AUTO_TEST_CASE(hashing_and_syntactic_equality)
+{
+	Expression const hex = makeLiteral("0x0a", LiteralKind::Number);
+	Expression const decimal = makeLiteral("10", LiteralKind::Number);
+	Expression const eleven = makeLiteral("11", LiteralKind::Number);
+	BOOST_CHECK_EQUAL(ExpressionHasher::run(hex), ExpressionHasher::run(decimal));
+	BOOST_CHECK(SyntacticallyEqual{}(hex, decimal));
+	BOOST_CHECK(ExpressionHasher::run(hex) != ExpressionHasher::run(eleven));
+	BOOST_CHECK(!SyntacticallyEqual{}(hex, eleven));
+
+	Expression const limited = makeLiteral("abc", LiteralKind::String);
+	Expression const unlimited = makeLiteral("abc", LiteralKind::String, true);
+	Expression const unlimitedCopy = makeLiteral("abc", LiteralKind::String, true);
+	BOOST_CHECK(ExpressionHasher::run(limited) != ExpressionHasher::run(unlimited));
+	BOOST_CHECK(!SyntacticallyEqual{}(limited, unlimited));
+	BOOST_CHECK_EQUAL(ExpressionHasher::run(unlimited), ExpressionHasher::run(unlimitedCopy));
+	BOOST_CHECK(SyntacticallyEqual{}(unlimited, unlimitedCopy));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
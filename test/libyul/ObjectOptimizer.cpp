@@ -0,0 +1,144 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the concurrent optimization of object hierarchies by ObjectOptimizer.
+ */
+
+#include <libyul/ObjectOptimizer.h>
+#include <libyul/YulStack.h>
+
+#include <libsolutil/Profiler.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <memory>
+#include <optional>
+#include <string>
+
+using namespace solidity::frontend;
+using namespace solidity::langutil;
+using namespace solidity::util;
+
+namespace solidity::yul::test
+{
+
+namespace
+{
+
+/// Object hierarchy in which "B", "C" and "E" have the same code and are all creation objects,
+/// so they share a cache key. "A", "A_deployed" and the shared code of the siblings are three
+/// distinct keys.
+std::string const hierarchy = R"(
+	object "A" {
+		code {
+			sstore(0, calldataload(0))
+		}
+		object "B" {
+			code {
+				function f(a) -> r { r := add(a, mul(2, 3)) }
+				sstore(f(calldataload(0)), f(calldataload(32)))
+			}
+			object "E" {
+				code {
+					function f(a) -> r { r := add(a, mul(2, 3)) }
+					sstore(f(calldataload(0)), f(calldataload(32)))
+				}
+			}
+		}
+		object "C" {
+			code {
+				function f(a) -> r { r := add(a, mul(2, 3)) }
+				sstore(f(calldataload(0)), f(calldataload(32)))
+			}
+		}
+		object "A_deployed" {
+			code {
+				function f(a) -> r { r := add(a, mul(2, 3)) }
+				sstore(f(calldataload(0)), f(calldataload(32)))
+			}
+		}
+	}
+)";
+
+size_t const distinctCacheKeys = 3;
+
+struct OptimizationResult
+{
+	std::string output;
+	/// Number of times the optimiser suite was run.
+	size_t optimizedObjects;
+	size_t cachedObjects;
+};
+
+OptimizationResult optimize(size_t _maxThreads)
+{
+	auto objectOptimizer = std::make_shared<ObjectOptimizer>();
+	YulStack stack(
+		EVMVersion{},
+		std::nullopt,
+		Language::StrictAssembly,
+		OptimiserSettings::full(),
+		DebugInfoSelection::Default(),
+		nullptr,
+		objectOptimizer
+	);
+	stack.setMaxThreads(_maxThreads);
+	BOOST_REQUIRE(stack.parseAndAnalyze("", hierarchy));
+
+	Profiler profiler;
+	{
+		Profiler::Scope scope(&profiler);
+		stack.optimize();
+	}
+	BOOST_REQUIRE(!stack.hasErrors());
+
+	// The suite disambiguates every AST it is run on exactly once.
+	auto const metrics = profiler.metrics();
+	BOOST_REQUIRE(metrics.count("Disambiguator"));
+	return {stack.print(), metrics.at("Disambiguator").callCount, objectOptimizer->size()};
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(YulObjectOptimizer, *boost::unit_test::label("nooptions"))
+
+BOOST_AUTO_TEST_CASE(identical_siblings_are_optimized_once)
+{
+	OptimizationResult const serial = optimize(1);
+	BOOST_CHECK_EQUAL(serial.optimizedObjects, distinctCacheKeys);
+	BOOST_CHECK_EQUAL(serial.cachedObjects, distinctCacheKeys);
+
+	for (size_t maxThreads: {2u, 4u, 8u})
+	{
+		BOOST_TEST_CONTEXT("maxThreads = " << maxThreads)
+		{
+			// Repeat to give the threads a chance to claim the shared key in different orders.
+			for (size_t run = 0; run < 10; ++run)
+			{
+				OptimizationResult const parallel = optimize(maxThreads);
+				BOOST_CHECK_EQUAL(parallel.output, serial.output);
+				BOOST_CHECK_EQUAL(parallel.optimizedObjects, distinctCacheKeys);
+				BOOST_CHECK_EQUAL(parallel.cachedObjects, distinctCacheKeys);
+			}
+		}
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
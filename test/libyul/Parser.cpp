@@ -30,6 +30,10 @@
 #include <libyul/AsmAnalysis.h>
 #include <libyul/AsmAnalysisInfo.h>
 #include <libyul/Dialect.h>
+#include <libyul/optimiser/ASTCopier.h>
+#include <libyul/optimiser/ExpressionSplitter.h>
+#include <libyul/optimiser/NameDispenser.h>
+#include <libyul/optimiser/OptimiserStep.h>
 #include <liblangutil/ErrorReporter.h>
 
 #include <boost/algorithm/string/replace.hpp>
@@ -39,7 +43,9 @@
 
 #include <memory>
 #include <optional>
+#include <set>
 #include <string>
+#include <tuple>
 
 using namespace solidity;
 using namespace solidity::util;
@@ -1049,6 +1055,95 @@ BOOST_AUTO_TEST_CASE(customSourceLocations_multiple_src_tags_on_one_line)
 	CHECK_LOCATION(varX.debugData->originLocation, "source1", 4, 5);
 }
 
+BOOST_AUTO_TEST_CASE(customSourceLocations_ast_copy_rewrite)
+{
+	ErrorList errorList;
+	ErrorReporter reporter(errorList);
+	auto const sourceText =
+		"/// @src 0:234:543\n"
+		"{\n"
+			"let x := calldataload(0)\n"
+			"/// @src 1:123:432\n"
+			"let y := add(x, mul(2, x))\n"
+			"/// @src 0:10:20\n"
+			"sstore(x, y)\n"
+		"}\n";
+	auto const& dialect = EVMDialect::strictAssemblyForEVM(solidity::test::CommonOptions::get().evmVersion(),
+		solidity::test::CommonOptions::get().eofVersion());
+	std::shared_ptr<AST> result = parse(sourceText, dialect, reporter);
+	BOOST_REQUIRE(!!result && errorList.size() == 0);
+	Block const& original = result->root();
+	BOOST_REQUIRE_EQUAL(original.statements.size(), 3);
+
+	// The copy shares the immutable debug data of the original nodes.
+	Block copy = ASTCopier{}.translate(original);
+	BOOST_REQUIRE_EQUAL(copy.statements.size(), 3);
+	for (size_t i = 0; i < copy.statements.size(); ++i)
+		BOOST_CHECK(debugDataOf(copy.statements[i]) == debugDataOf(original.statements[i]));
+
+	// The statements split off a statement keep its location.
+	NameDispenser dispenser(dialect, copy);
+	std::set<YulName> reserved;
+	OptimiserStepContext context{dialect, dispenser, reserved, {}};
+	ExpressionSplitter::run(context, copy);
+	std::vector<std::tuple<std::string, int, int>> const expectedLocations{
+		// let _1 := 0 let x := calldataload(_1)
+		{"source0", 234, 543},
+		{"source0", 234, 543},
+		// let _2 := 2 let _3 := mul(_2, x) let y := add(x, _3)
+		{"source1", 123, 432},
+		{"source1", 123, 432},
+		{"source1", 123, 432},
+		// sstore(x, y)
+		{"source0", 10, 20},
+	};
+	BOOST_REQUIRE_EQUAL(copy.statements.size(), expectedLocations.size());
+	for (size_t i = 0; i < copy.statements.size(); ++i)
+		CHECK_LOCATION(
+			originLocationOf(copy.statements[i]),
+			std::get<0>(expectedLocations[i]),
+			std::get<1>(expectedLocations[i]),
+			std::get<2>(expectedLocations[i])
+		);
+
+	// The original is not affected by the rewrite of the copy.
+	BOOST_REQUIRE_EQUAL(original.statements.size(), 3);
+	CHECK_LOCATION(originLocationOf(original.statements.at(0)), "source0", 234, 543);
+	CHECK_LOCATION(originLocationOf(original.statements.at(1)), "source1", 123, 432);
+	CHECK_LOCATION(originLocationOf(original.statements.at(2)), "source0", 10, 20);
+	FunctionCall const& add = std::get<FunctionCall>(*std::get<VariableDeclaration>(original.statements.at(1)).value);
+	BOOST_REQUIRE_EQUAL(add.arguments.size(), 2);
+	BOOST_CHECK(std::holds_alternative<FunctionCall>(add.arguments.at(1)));
+	CHECK_LOCATION(originLocationOf(add.arguments.at(1)), "source1", 123, 432);
+}
+
+BOOST_AUTO_TEST_CASE(locationOverride_ast_copy_rewrite)
+{
+	ErrorList errorList;
+	ErrorReporter reporter(errorList);
+	auto const& dialect = EVMDialect::strictAssemblyForEVM(solidity::test::CommonOptions::get().evmVersion(),
+		solidity::test::CommonOptions::get().eofVersion());
+	auto const sourceName = std::make_shared<std::string const>("source0");
+	CharStream stream("{ let x := calldataload(0) sstore(x, add(x, 1)) }", "");
+	std::unique_ptr<AST> result = yul::Parser(reporter, dialect, SourceLocation{10, 20, sourceName}).parse(stream);
+	BOOST_REQUIRE(!!result && errorList.size() == 0);
+	Block const& original = result->root();
+	BOOST_REQUIRE_EQUAL(original.statements.size(), 2);
+	// All nodes share the debug data of the overriding location.
+	BOOST_CHECK(debugDataOf(original.statements.at(0)) == original.debugData);
+	BOOST_CHECK(debugDataOf(original.statements.at(1)) == original.debugData);
+
+	Block copy = ASTCopier{}.translate(original);
+	std::get<VariableDeclaration>(copy.statements.at(0)).debugData =
+		DebugData::create(SourceLocation{30, 40, sourceName}, SourceLocation{30, 40, sourceName});
+
+	CHECK_LOCATION(originLocationOf(copy.statements.at(0)), "source0", 30, 40);
+	CHECK_LOCATION(originLocationOf(copy.statements.at(1)), "source0", 10, 20);
+	CHECK_LOCATION(originLocationOf(original.statements.at(0)), "source0", 10, 20);
+	CHECK_LOCATION(originLocationOf(original.statements.at(1)), "source0", 10, 20);
+	CHECK_LOCATION(original.debugData->originLocation, "source0", 10, 20);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
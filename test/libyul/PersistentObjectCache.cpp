@@ -0,0 +1,161 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for PersistentObjectCache.
+ */
+
+#include <libyul/PersistentObjectCache.h>
+
+#include <libsolutil/Keccak256.h>
+#include <libsolutil/TemporaryDirectory.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <ctime>
+#include <fstream>
+
+using namespace solidity::util;
+
+namespace fs = boost::filesystem;
+
+namespace solidity::yul::test
+{
+
+namespace
+{
+
+/// Sets the modification time of all entries that were modified after @a _threshold to @a _time.
+void setLastUseOfNewEntries(fs::path const& _directory, std::time_t _threshold, std::time_t _time)
+{
+	for (fs::directory_entry const& entry: fs::directory_iterator(_directory))
+		if (fs::last_write_time(entry.path()) > _threshold)
+			fs::last_write_time(entry.path(), _time);
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(PersistentObjectCacheTest, *boost::unit_test::label("nooptions"))
+
+BOOST_AUTO_TEST_CASE(store_and_load)
+{
+	TemporaryDirectory tempDir("yul-cache-test");
+	PersistentObjectCache cache(tempDir.path() / "cache", "version", 1024 * 1024);
+
+	BOOST_CHECK(!cache.load(keccak256("a")).has_value());
+	cache.store(keccak256("a"), "{ sstore(0, 1) }");
+	BOOST_CHECK(cache.load(keccak256("a")) == "{ sstore(0, 1) }");
+	BOOST_CHECK(!cache.load(keccak256("b")).has_value());
+
+	cache.store(keccak256("a"), "{ }");
+	BOOST_CHECK(cache.load(keccak256("a")) == "{ }");
+}
+
+BOOST_AUTO_TEST_CASE(entries_are_specific_to_version)
+{
+	TemporaryDirectory tempDir("yul-cache-test");
+	PersistentObjectCache(tempDir.path(), "version 1", 1024 * 1024).store(keccak256("a"), "{ }");
+
+	BOOST_CHECK(PersistentObjectCache(tempDir.path(), "version 1", 1024 * 1024).load(keccak256("a")) == "{ }");
+	BOOST_CHECK(!PersistentObjectCache(tempDir.path(), "version 2", 1024 * 1024).load(keccak256("a")).has_value());
+}
+
+BOOST_AUTO_TEST_CASE(damaged_entries_are_ignored)
+{
+	TemporaryDirectory tempDir("yul-cache-test");
+	PersistentObjectCache cache(tempDir.path(), "version", 1024 * 1024);
+	cache.store(keccak256("a"), "{ sstore(0, 1) }");
+
+	for (fs::directory_entry const& entry: fs::directory_iterator(tempDir.path()))
+		std::ofstream(entry.path().string(), std::ios::app) << "}";
+
+	BOOST_CHECK(!cache.load(keccak256("a")).has_value());
+	BOOST_CHECK(fs::is_empty(tempDir.path()));
+}
+
+BOOST_AUTO_TEST_CASE(evicts_least_recently_used_entries)
+{
+	TemporaryDirectory tempDir("yul-cache-test");
+	// Every entry consists of a line with the checksum and the content.
+	std::string content(100, 'x');
+	std::uint64_t entrySize = 65 + content.size();
+	PersistentObjectCache cache(tempDir.path(), "version", 3 * entrySize + 5);
+
+	std::time_t now = std::time(nullptr);
+	cache.store(keccak256("1"), content);
+	setLastUseOfNewEntries(tempDir.path(), now - 100, now - 30);
+	cache.store(keccak256("2"), content);
+	setLastUseOfNewEntries(tempDir.path(), now - 25, now - 20);
+	cache.store(keccak256("3"), content);
+	setLastUseOfNewEntries(tempDir.path(), now - 15, now - 10);
+	BOOST_TEST(cache.totalSize() == 3 * entrySize);
+
+	// Loading an entry marks it as recently used.
+	BOOST_CHECK(cache.load(keccak256("1")) == content);
+	cache.store(keccak256("4"), content);
+
+	BOOST_TEST(cache.totalSize() == 2 * entrySize);
+	BOOST_CHECK(cache.load(keccak256("1")) == content);
+	BOOST_CHECK(!cache.load(keccak256("2")).has_value());
+	BOOST_CHECK(!cache.load(keccak256("3")).has_value());
+	BOOST_CHECK(cache.load(keccak256("4")) == content);
+}
+
+BOOST_AUTO_TEST_CASE(replacing_entries_does_not_grow_total_size)
+{
+	TemporaryDirectory tempDir("yul-cache-test");
+	std::string content(100, 'x');
+	std::uint64_t entrySize = 65 + content.size();
+	PersistentObjectCache cache(tempDir.path(), "version", 3 * entrySize + 5);
+
+	cache.store(keccak256("1"), content);
+	cache.store(keccak256("2"), content);
+	for (size_t i = 0; i < 5; ++i)
+		cache.store(keccak256("1"), content);
+	BOOST_TEST(cache.totalSize() == 2 * entrySize);
+
+	cache.store(keccak256("2"), "");
+	BOOST_TEST(cache.totalSize() == entrySize + 65);
+	BOOST_CHECK(cache.load(keccak256("1")) == content);
+	BOOST_CHECK(cache.load(keccak256("2")) == "");
+}
+
+BOOST_AUTO_TEST_CASE(only_stale_temporary_files_are_evicted)
+{
+	TemporaryDirectory tempDir("yul-cache-test");
+	std::string content(100, 'x');
+	std::uint64_t entrySize = 65 + content.size();
+
+	// Temporary files that other processes may still be writing.
+	std::time_t now = std::time(nullptr);
+	std::ofstream((tempDir.path() / "recent.tmp").string()) << std::string(10 * entrySize, 'x');
+	std::ofstream((tempDir.path() / "stale.tmp").string()) << std::string(10 * entrySize, 'x');
+	fs::last_write_time(tempDir.path() / "stale.tmp", now - 2 * 60 * 60);
+
+	PersistentObjectCache cache(tempDir.path(), "version", 3 * entrySize + 5);
+	BOOST_CHECK(fs::exists(tempDir.path() / "recent.tmp"));
+	BOOST_CHECK(!fs::exists(tempDir.path() / "stale.tmp"));
+	BOOST_TEST(cache.totalSize() == 0);
+
+	cache.store(keccak256("1"), content);
+	BOOST_CHECK(cache.load(keccak256("1")) == content);
+	BOOST_CHECK(fs::exists(tempDir.path() / "recent.tmp"));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
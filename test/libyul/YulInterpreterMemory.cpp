@@ -0,0 +1,284 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the paged memory of the Yul interpreter.
+ */
+
+#include <test/tools/yulInterpreter/Interpreter.h>
+#include <test/tools/yulInterpreter/Memory.h>
+
+#include <test/libyul/Common.h>
+
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/AST.h>
+#include <libyul/Object.h>
+
+#include <libsolutil/FixedHash.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <map>
+#include <random>
+#include <set>
+#include <sstream>
+
+using namespace solidity::langutil;
+using namespace solidity::util;
+
+namespace solidity::yul::test
+{
+
+namespace
+{
+
+u256 const pageSize = Memory::pageSize;
+u256 const lastByte = ~u256(0);
+
+/// 32 distinct non-zero bytes, 0x01 to 0x20.
+u256 const testWord("0x0102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f20");
+
+std::set<u256> pageIndices(Memory const& _memory)
+{
+	std::set<u256> indices;
+	for (auto const& [index, page]: _memory.pages())
+		indices.insert(index);
+	return indices;
+}
+
+/// Reference implementation of the memory, storing only the bytes that were written.
+class MemoryModel
+{
+public:
+	uint8_t read(u256 const& _offset) const
+	{
+		auto it = m_bytes.find(_offset);
+		return it != m_bytes.end() ? it->second : 0;
+	}
+	bytes read(u256 const& _offset, size_t _size) const
+	{
+		bytes data;
+		for (size_t i = 0; i < _size; ++i)
+			data.push_back(read(_offset + i));
+		return data;
+	}
+	void write(u256 const& _offset, bytes const& _data)
+	{
+		for (size_t i = 0; i < _data.size(); ++i)
+		{
+			m_bytes[_offset + i] = _data[i];
+			if (_data[i] != 0)
+				m_nonZeroPages.insert((_offset + i) / pageSize);
+		}
+	}
+	/// @returns the indices of the pages a non-zero byte was ever written to.
+	std::set<u256> const& nonZeroPages() const { return m_nonZeroPages; }
+
+private:
+	std::map<u256, uint8_t> m_bytes;
+	std::set<u256> m_nonZeroPages;
+};
+
+}
+
+BOOST_AUTO_TEST_SUITE(YulInterpreterMemory, *boost::unit_test::label("nooptions"))
+
+BOOST_AUTO_TEST_CASE(reads_do_not_allocate)
+{
+	Memory memory;
+	BOOST_CHECK_EQUAL(int(memory.read(0)), 0);
+	BOOST_CHECK_EQUAL(int(memory.read(lastByte)), 0);
+	BOOST_CHECK(memory.read(pageSize - 16, 2 * Memory::pageSize) == bytes(2 * Memory::pageSize, 0));
+	BOOST_CHECK_EQUAL(memory.readWord(pageSize - 16), 0);
+	BOOST_CHECK(memory.pages().empty());
+}
+
+BOOST_AUTO_TEST_CASE(zeros_do_not_allocate)
+{
+	Memory memory;
+	memory.write(0, uint8_t(0));
+	memory.writeWord(pageSize - 16, 0);
+	bytes const zeros(2 * Memory::pageSize, 0);
+	memory.write(3 * pageSize, bytesConstRef(&zeros));
+	BOOST_CHECK(memory.pages().empty());
+
+	// Zeros written to an allocated page are stored, but do not free it.
+	memory.write(pageSize, uint8_t(1));
+	memory.write(pageSize, uint8_t(0));
+	BOOST_CHECK_EQUAL(int(memory.read(pageSize)), 0);
+	BOOST_CHECK(pageIndices(memory) == std::set<u256>{1});
+}
+
+BOOST_AUTO_TEST_CASE(page_boundaries)
+{
+	Memory memory;
+	memory.write(pageSize - 1, uint8_t(0xaa));
+	BOOST_CHECK(pageIndices(memory) == std::set<u256>{0});
+	memory.write(pageSize, uint8_t(0xbb));
+	BOOST_CHECK(pageIndices(memory) == (std::set<u256>{0, 1}));
+
+	BOOST_CHECK(memory.read(pageSize - 2, 4) == (bytes{0, 0xaa, 0xbb, 0}));
+	BOOST_CHECK_EQUAL(int(memory.pages().at(0)[Memory::pageSize - 1]), 0xaa);
+	BOOST_CHECK_EQUAL(int(memory.pages().at(1)[0]), 0xbb);
+}
+
+BOOST_AUTO_TEST_CASE(words_crossing_pages)
+{
+	Memory memory;
+	memory.writeWord(pageSize - 16, testWord);
+	BOOST_CHECK(pageIndices(memory) == (std::set<u256>{0, 1}));
+	BOOST_CHECK_EQUAL(memory.readWord(pageSize - 16), testWord);
+	BOOST_CHECK(memory.read(pageSize - 16, 32) == h256(testWord).asBytes());
+	BOOST_CHECK_EQUAL(memory.readWord(pageSize - 15), testWord << 8);
+	BOOST_CHECK_EQUAL(memory.readWord(pageSize - 17), testWord >> 8);
+
+	// A range spanning an unallocated page between two allocated ones.
+	memory.writeWord(4 * pageSize - 16, testWord);
+	bytes const range = memory.read(pageSize - 16, 3 * Memory::pageSize + 32);
+	BOOST_CHECK(pageIndices(memory) == (std::set<u256>{0, 1, 3, 4}));
+	BOOST_CHECK(bytes(range.begin(), range.begin() + 32) == h256(testWord).asBytes());
+	BOOST_CHECK(bytes(range.begin() + 32, range.end() - 32) == bytes(3 * Memory::pageSize - 32, 0));
+	BOOST_CHECK(bytes(range.end() - 32, range.end()) == h256(testWord).asBytes());
+}
+
+BOOST_AUTO_TEST_CASE(end_of_address_space)
+{
+	Memory memory;
+	memory.writeWord(lastByte - 15, testWord);
+	BOOST_CHECK(pageIndices(memory) == (std::set<u256>{0, lastByte / pageSize}));
+	BOOST_CHECK_EQUAL(int(memory.read(lastByte)), 0x10);
+	BOOST_CHECK_EQUAL(int(memory.read(0)), 0x11);
+	BOOST_CHECK_EQUAL(memory.readWord(lastByte - 15), testWord);
+	bytes const word = h256(testWord).asBytes();
+	BOOST_CHECK(memory.read(0, 16) == bytes(word.begin() + 16, word.end()));
+}
+
+BOOST_AUTO_TEST_CASE(memory_dump)
+{
+	InterpreterState state;
+	state.memory.writeWord(pageSize - 16, testWord);
+	state.memory.write(5 * pageSize, uint8_t(1));
+	// Allocates a page, but only with zero words, which are not printed.
+	state.memory.write(3 * pageSize, uint8_t(1));
+	state.memory.write(3 * pageSize, uint8_t(0));
+
+	std::ostringstream dump;
+	state.dumpTraceAndState(dump, false);
+	BOOST_CHECK_EQUAL(
+		dump.str(),
+		"Trace:\n"
+		"Memory dump:\n"
+		"   3E0: 000000000000000000000000000000000102030405060708090a0b0c0d0e0f10\n"
+		"   400: 1112131415161718191a1b1c1d1e1f2000000000000000000000000000000000\n"
+		"  1400: 0100000000000000000000000000000000000000000000000000000000000000\n"
+		"Storage dump:\n"
+		"Transient storage dump:\n"
+	);
+
+	std::ostringstream dumpWithoutMemory;
+	state.dumpTraceAndState(dumpWithoutMemory, true);
+	BOOST_CHECK_EQUAL(dumpWithoutMemory.str(), "Trace:\nStorage dump:\nTransient storage dump:\n");
+}
+
+BOOST_AUTO_TEST_CASE(range_size_limit)
+{
+	Dialect const& dialect = EVMDialect::strictAssemblyForEVMObjects(EVMVersion{}, std::nullopt);
+	ErrorList errors;
+	auto [object, analysisInfo] = parse(R"({
+		calldatacopy(0x3f0, 0, 0xffff)
+		calldatacopy(0x2000, 0, 0x10000)
+	})", dialect, errors);
+	BOOST_REQUIRE(object && errors.empty());
+
+	InterpreterState state;
+	state.maxTraceSize = 32;
+	state.maxSteps = 512;
+	state.maxExprNesting = 64;
+	state.calldata = h256(testWord).asBytes();
+	Interpreter::run(state, dialect, object->code()->root(), true, false);
+
+	// Copies of at most 0xffff bytes are carried out, larger ones only expand the memory.
+	BOOST_CHECK_EQUAL(state.memory.readWord(0x3f0), testWord);
+	BOOST_CHECK(pageIndices(state.memory) == (std::set<u256>{0, 1}));
+	BOOST_CHECK_EQUAL(state.msize, 0x12000);
+	BOOST_CHECK_EQUAL(state.trace.size(), 2u);
+}
+
+BOOST_AUTO_TEST_CASE(random_accesses)
+{
+	// Regions around page boundaries, including the end of the address space.
+	std::vector<u256> const regions{0, 7 * pageSize, lastByte - pageSize};
+	std::mt19937 generator(42);
+	auto randomNumber = [&](size_t _max) { return std::uniform_int_distribution<size_t>(0, _max)(generator); };
+	auto randomOffset = [&]() { return regions[randomNumber(regions.size() - 1)] + randomNumber(2 * Memory::pageSize); };
+	auto randomBytes = [&](size_t _size)
+	{
+		bytes data(_size);
+		for (uint8_t& byte: data)
+			// Make zeros frequent to also cover writes that do not allocate.
+			byte = randomNumber(3) == 0 ? 0 : static_cast<uint8_t>(randomNumber(0xff));
+		return data;
+	};
+
+	Memory memory;
+	MemoryModel model;
+	for (size_t step = 0; step < 10000; ++step)
+	{
+		u256 const offset = randomOffset();
+		switch (randomNumber(5))
+		{
+		case 0:
+		{
+			bytes const data = randomBytes(1);
+			memory.write(offset, data.front());
+			model.write(offset, data);
+			break;
+		}
+		case 1:
+		{
+			bytes const data = randomBytes(randomNumber(100));
+			memory.write(offset, bytesConstRef(&data));
+			model.write(offset, data);
+			break;
+		}
+		case 2:
+		{
+			bytes const data = randomBytes(32);
+			memory.writeWord(offset, u256(h256(data)));
+			model.write(offset, data);
+			break;
+		}
+		case 3:
+			BOOST_REQUIRE_EQUAL(int(memory.read(offset)), int(model.read(offset)));
+			break;
+		case 4:
+		{
+			size_t const size = randomNumber(100);
+			BOOST_REQUIRE(memory.read(offset, size) == model.read(offset, size));
+			break;
+		}
+		case 5:
+			BOOST_REQUIRE_EQUAL(memory.readWord(offset), u256(h256(model.read(offset, 32))));
+			break;
+		}
+	}
+	BOOST_CHECK(pageIndices(memory) == model.nonZeroPages());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -0,0 +1,115 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the repository of interned Yul strings.
+ */
+
+#include <libyul/YulString.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace solidity::yul::test
+{
+
+BOOST_AUTO_TEST_SUITE(YulStringRepositoryTest, *boost::unit_test::label("nooptions"))
+
+BOOST_AUTO_TEST_CASE(concurrent_interning)
+{
+	size_t const threadCount = 8;
+	size_t const stringCount = 2000;
+	std::vector<std::vector<YulString>> shared(threadCount);
+	std::vector<std::vector<YulString>> own(threadCount);
+	std::vector<std::thread> threads;
+	for (size_t thread = 0; thread < threadCount; ++thread)
+		threads.emplace_back([&, thread]() {
+			for (size_t i = 0; i < stringCount; ++i)
+			{
+				// Each thread interns the shared strings in a different order.
+				shared[thread].emplace_back("shared_" + std::to_string((i * (thread + 1)) % stringCount));
+				own[thread].emplace_back("own_" + std::to_string(thread) + "_" + std::to_string(i));
+			}
+		});
+	for (std::thread& thread: threads)
+		thread.join();
+
+	for (size_t thread = 0; thread < threadCount; ++thread)
+		for (size_t i = 0; i < stringCount; ++i)
+		{
+			YulString const& name = shared[thread][i];
+			std::string const expectation = "shared_" + std::to_string((i * (thread + 1)) % stringCount);
+			BOOST_REQUIRE_EQUAL(name.str(), expectation);
+			BOOST_REQUIRE(name == YulString(expectation));
+			BOOST_REQUIRE_EQUAL(name.hash(), YulStringRepository::hash(expectation));
+			BOOST_REQUIRE_EQUAL(own[thread][i].str(), "own_" + std::to_string(thread) + "_" + std::to_string(i));
+		}
+}
+
+BOOST_AUTO_TEST_CASE(reset_is_deferred_until_scopes_end)
+{
+	{
+		YulStringRepository::Scope scope;
+		YulString name("deferred");
+		YulStringRepository::reset();
+		BOOST_CHECK_EQUAL(name.str(), "deferred");
+		BOOST_CHECK(YulString("deferred") == name);
+		BOOST_CHECK(YulStringRepository::instance().size() > 0);
+	}
+	BOOST_CHECK_EQUAL(YulStringRepository::instance().size(), 0);
+
+	YulStringRepository::reset();
+	BOOST_CHECK_EQUAL(YulStringRepository::instance().size(), 0);
+	BOOST_CHECK(YulString().empty());
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_scopes_and_resets)
+{
+	size_t const threadCount = 4;
+	std::atomic<size_t> runningThreads = threadCount;
+	std::atomic<bool> failed = false;
+	std::vector<std::thread> threads;
+	for (size_t thread = 0; thread < threadCount; ++thread)
+		threads.emplace_back([&, thread]() {
+			for (size_t i = 0; i < 500; ++i)
+			{
+				YulStringRepository::Scope scope;
+				std::string const value = "name_" + std::to_string(thread) + "_" + std::to_string(i % 7);
+				YulString name(value);
+				for (size_t j = 0; j < 20; ++j)
+					if (YulString(value) != name || name.str() != value)
+						failed = true;
+			}
+			--runningThreads;
+		});
+	while (runningThreads > 0)
+		YulStringRepository::reset();
+	for (std::thread& thread: threads)
+		thread.join();
+
+	BOOST_CHECK(!failed);
+	YulStringRepository::reset();
+	BOOST_CHECK_EQUAL(YulStringRepository::instance().size(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -225,7 +225,7 @@ class JsonRpcProcess:
         self.trace('receive_message', json.dumps(json_object, indent=4, sort_keys=True))
         return json_object
 
-    def send_message(self, method_name: str, params: Optional[dict]) -> None:
+    def send_message(self, method_name: str, params: Optional[dict], message_id: Optional[int] = None) -> None:
         if self.process.stdin is None:
             return
         message = {
@@ -233,6 +233,8 @@ class JsonRpcProcess:
             'method': method_name,
             'params': params
         }
+        if message_id is not None:
+            message['id'] = message_id
         json_string = json.dumps(obj=message)
         rpc_message = f"Content-Length: {len(json_string)}\r\n\r\n{json_string}"
         self.trace(f'send_message ({method_name})', json.dumps(message, indent=4, sort_keys=True))
@@ -994,9 +996,17 @@ class SolidityLSPTestSuite: # {{{
         """
         Return all published diagnostic reports sorted by file URI.
         """
+        return self.wait_for_diagnostics_and_analyzed_files(solc)[0]
+
+    def wait_for_diagnostics_and_analyzed_files(self, solc: JsonRpcProcess) -> Tuple[List[dict], List[str]]:
+        """
+        Return all published diagnostic reports sorted by file URI,
+        together with the sorted URIs of the files analyzed since the previous report.
+        """
         reports = []
 
-        num_files = solc.receive_message()["params"]["openFileCount"]
+        trace = solc.receive_message()["params"]
+        num_files = trace["openFileCount"]
 
         for _ in range(0, num_files):
             message = solc.receive_message()
@@ -1010,7 +1020,25 @@ class SolidityLSPTestSuite: # {{{
                 )
             )
 
-        return sorted(reports, key=lambda x: x['uri'])
+        return sorted(reports, key=lambda x: x['uri']), sorted(trace["analyzedFiles"])
+
+    def receive_responses(self, solc: JsonRpcProcess, request_ids: List[int]) -> Tuple[List[dict], List[dict]]:
+        """
+        Receives messages until the responses to all given requests arrived.
+        Returns all received messages in order, split into the responses and the notifications.
+        """
+        responses = []
+        notifications = []
+        pending_ids = set(request_ids)
+        while len(pending_ids) > 0:
+            message = solc.receive_message()
+            assert message is not None # This can happen if the server aborts early.
+            if 'method' in message:
+                notifications.append(message)
+            else:
+                responses.append(message)
+                pending_ids.discard(message.get('id'))
+        return responses, notifications
 
     def normalizeUri(self, uri):
         return uri.replace(self.project_root_uri + "/", "")[:-len(".sol")]
@@ -1610,6 +1638,164 @@ class SolidityLSPTestSuite: # {{{
         self.expect_equal(len(report['diagnostics']), 0)
         # The warning went away because the compiler aborts further processing after the error.
 
+    def test_didChange_reanalyzes_only_changed_file_and_importers(self, solc: JsonRpcProcess) -> None:
+        self.setup_lsp(solc)
+        self.open_file_and_wait_for_diagnostics(solc, 'publish_diagnostics_3')
+        self.open_file_and_wait_for_diagnostics(solc, 'didOpen_with_import')
+        self.open_file_and_wait_for_diagnostics(solc, 'lib', 'goto')
+
+        lib_uri = self.get_test_file_uri('lib', 'goto')
+        importer_uri = self.get_test_file_uri('didOpen_with_import')
+        unrelated_uri = self.get_test_file_uri('publish_diagnostics_3')
+        marker = self.get_test_tags('lib', 'goto')['@addFunction']
+        lib_lines = self.get_test_file_contents('lib', 'goto').split('\n')
+        add_function = '\n'.join(lib_lines[marker['start']['line']:marker['end']['line']]) + '\n'
+
+        # Deleting function `add` from the imported file causes an error in the importing one.
+        solc.send_message('textDocument/didChange', {
+            'textDocument': {'uri': lib_uri},
+            'contentChanges': [{'range': marker, 'text': ''}]
+        })
+        published_diagnostics, analyzed_files = self.wait_for_diagnostics_and_analyzed_files(solc)
+        self.expect_equal(analyzed_files, sorted([importer_uri, lib_uri]), "only the changed file and its importer are analyzed")
+        self.expect_equal(
+            [report['uri'] for report in published_diagnostics],
+            sorted([importer_uri, lib_uri, unrelated_uri]),
+            "diagnostics are published for all files"
+        )
+        reports = {report['uri']: report['diagnostics'] for report in published_diagnostics}
+        self.expect_equal(len(reports[importer_uri]), 1)
+        self.expect_diagnostic(reports[importer_uri][0], code=9582, marker=self.get_test_tags('didOpen_with_import')['@diagnostics'])
+        self.expect_equal(len(reports[lib_uri]), 0)
+        # The diagnostics of the file that was not analyzed again are kept.
+        self.expect_equal(len(reports[unrelated_uri]), 1)
+        self.expect_equal(reports[unrelated_uri][0]['code'], 3656)
+
+        # Restoring the function brings back the original diagnostics.
+        solc.send_message('textDocument/didChange', {
+            'textDocument': {'uri': lib_uri},
+            'contentChanges': [{'range': {'start': marker['start'], 'end': marker['start']}, 'text': add_function}]
+        })
+        published_diagnostics, analyzed_files = self.wait_for_diagnostics_and_analyzed_files(solc)
+        self.expect_equal(analyzed_files, sorted([importer_uri, lib_uri]), "only the changed file and its importer are analyzed")
+        reports = {report['uri']: report['diagnostics'] for report in published_diagnostics}
+        self.expect_equal(len(reports[importer_uri]), 0)
+        self.expect_equal(len(reports[lib_uri]), 1)
+        self.expect_diagnostic(reports[lib_uri][0], code=2072, marker=self.get_test_tags('lib', 'goto')['@diagnostics'])
+        self.expect_equal(len(reports[unrelated_uri]), 1)
+        self.expect_equal(reports[unrelated_uri][0]['code'], 3656)
+
+    def open_virtual_file(self, solc: JsonRpcProcess, uri: str, lines: List[str]) -> None:
+        solc.send_message('textDocument/didOpen', {
+            'textDocument': {
+                'uri': uri,
+                'languageId': 'Solidity',
+                'version': 1,
+                'text': ''.join(line + '\n' for line in lines)
+            }
+        })
+
+    def big_file_lines(self) -> List[str]:
+        """
+        Returns the lines of a file that takes long enough to analyze for the client
+        to send further messages in the meantime.
+        """
+        return [
+            '// SPDX-License-Identifier: UNLICENSED',
+            'pragma solidity >=0.8.0;',
+            'contract Big {',
+            *[f'    function f{i}(uint x) public pure returns (uint) {{ return x * {i} + {i}; }}' for i in range(3000)],
+            '}',
+        ]
+
+    def test_requests_are_answered_in_order_after_changes(self, solc: JsonRpcProcess) -> None:
+        self.setup_lsp(solc)
+        FILE_URI = 'file:///a.sol'
+        lines = [
+            '// SPDX-License-Identifier: UNLICENSED',
+            'pragma solidity >=0.8.0;',
+            'contract C {',
+            '    function f() public pure returns (uint) { return 1; }',
+            '    function g() public pure returns (uint) { return f(); }',
+            '}',
+        ]
+        self.open_virtual_file(solc, FILE_URI, lines)
+        self.wait_for_diagnostics(solc)
+
+        # Moves everything one line down. The requests sent right after the change have to be answered
+        # against the new content, after the diagnostics of the change were published.
+        solc.send_message('textDocument/didChange', {
+            'textDocument': {'uri': FILE_URI},
+            'contentChanges': [{'range': {'start': {'line': 0, 'character': 0}, 'end': {'line': 0, 'character': 0}}, 'text': '\n'}]
+        })
+        call_position = {'line': 5, 'character': lines[4].index('f()')}
+        for request_id, method in enumerate(['textDocument/definition', 'textDocument/hover', 'textDocument/definition'], start=1):
+            solc.send_message(method, {'textDocument': {'uri': FILE_URI}, 'position': call_position}, message_id=request_id)
+
+        responses, notifications = self.receive_responses(solc, [1, 2, 3])
+        self.expect_equal([response['id'] for response in responses], [1, 2, 3], "responses are sent in order")
+        self.expect_true(
+            any(notification['method'] == 'textDocument/publishDiagnostics' for notification in notifications),
+            "diagnostics of the change are published before the responses"
+        )
+        for response in [responses[0], responses[2]]:
+            self.expect_equal(len(response['result']), 1, "definition found")
+            self.expect_equal(response['result'][0]['range']['start']['line'], 4, "definition in the changed content")
+        self.expect_true('function () pure returns (uint256)' in responses[1]['result']['contents']['value'], "hover over f")
+
+    def test_cancel_queued_request(self, solc: JsonRpcProcess) -> None:
+        self.setup_lsp(solc)
+        FILE_URI = 'file:///big.sol'
+        position = {'line': 3, 'character': 13}
+
+        # The requests are queued while the opened file is analyzed.
+        self.open_virtual_file(solc, FILE_URI, self.big_file_lines())
+        solc.send_message('textDocument/hover', {'textDocument': {'uri': FILE_URI}, 'position': position}, message_id=1)
+        solc.send_message('$/cancelRequest', {'id': 1})
+        solc.send_message('textDocument/hover', {'textDocument': {'uri': FILE_URI}, 'position': position}, message_id=2)
+        # Unknown and already handled requests are ignored.
+        solc.send_message('$/cancelRequest', {'id': 42})
+
+        responses, _ = self.receive_responses(solc, [1, 2])
+        self.expect_equal([response['id'] for response in responses], [1, 2], "one response per request")
+        self.expect_equal(responses[0]['error']['code'], -32800, "request cancelled")
+        self.expect_true('function (uint256) pure returns (uint256)' in responses[1]['result']['contents']['value'], "hover over f0")
+
+        solc.send_message('$/cancelRequest', {'id': 2})
+        solc.send_message('textDocument/hover', {'textDocument': {'uri': FILE_URI}, 'position': position}, message_id=3)
+        responses, _ = self.receive_responses(solc, [3])
+        self.expect_equal([response['id'] for response in responses], [3], "no response to late cancellations")
+
+    def test_cancel_request_in_progress(self, solc: JsonRpcProcess) -> None:
+        self.setup_lsp(solc)
+        SMALL_FILE_URI = 'file:///a.sol'
+        BIG_FILE_URI = 'file:///big.sol'
+        position = {'line': 3, 'character': 13}
+        self.open_virtual_file(solc, SMALL_FILE_URI, ['// SPDX-License-Identifier: UNLICENSED', 'pragma solidity >=0.8.0;'])
+        self.wait_for_diagnostics(solc)
+        self.open_virtual_file(solc, BIG_FILE_URI, self.big_file_lines())
+        self.wait_for_diagnostics(solc)
+
+        # After a change of the small file, the big one has to be analyzed again by the request itself.
+        solc.send_message('textDocument/didChange', {
+            'textDocument': {'uri': SMALL_FILE_URI},
+            'contentChanges': [{'range': {'start': {'line': 2, 'character': 0}, 'end': {'line': 2, 'character': 0}}, 'text': 'contract C {}\n'}]
+        })
+        self.wait_for_diagnostics(solc)
+        solc.send_message('textDocument/hover', {'textDocument': {'uri': BIG_FILE_URI}, 'position': position}, message_id=1)
+        solc.send_message('$/cancelRequest', {'id': 1})
+
+        # Depending on how far the handling got, the request is cancelled or answered, but never both.
+        responses, _ = self.receive_responses(solc, [1])
+        self.expect_equal(len(responses), 1, "one response")
+        if 'error' in responses[0]:
+            self.expect_equal(responses[0]['error']['code'], -32800, "request cancelled")
+
+        solc.send_message('textDocument/hover', {'textDocument': {'uri': BIG_FILE_URI}, 'position': position}, message_id=2)
+        responses, _ = self.receive_responses(solc, [2])
+        self.expect_equal([response['id'] for response in responses], [2])
+        self.expect_true('function (uint256) pure returns (uint256)' in responses[0]['result']['contents']['value'], "hover over f0")
+
     def test_textDocument_didOpen_with_relative_import_without_project_url(self, solc: JsonRpcProcess) -> None:
         self.setup_lsp(solc, expose_project_root=False)
         TEST_NAME = 'didOpen_with_import'
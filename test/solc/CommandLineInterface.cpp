@@ -32,6 +32,8 @@
 #include <libsolutil/JSON.h>
 #include <libsolutil/TemporaryDirectory.h>
 
+#include <libyul/YulString.h>
+
 #include <boost/algorithm/string.hpp>
 
 #include <range/v3/view/transform.hpp>
@@ -153,6 +155,7 @@ BOOST_AUTO_TEST_CASE(multiple_input_modes)
 		"--license",
 		"--version",
 		"--standard-json",
+		"--server",
 		"--link",
 		"--assemble",
 		"--strict-assembly",
@@ -161,7 +164,7 @@ BOOST_AUTO_TEST_CASE(multiple_input_modes)
 	};
 	std::string expectedMessage =
 		"The following options are mutually exclusive: "
-		"--help, --license, --version, --standard-json, --link, --assemble, --strict-assembly, --import-ast, --lsp, --import-asm-json. "
+		"--help, --license, --version, --standard-json, --server, --link, --assemble, --strict-assembly, --import-ast, --lsp, --import-asm-json. "
 		"Select at most one.";
 
 	for (auto const& mode1: inputModeOptions)
@@ -345,6 +348,91 @@ BOOST_AUTO_TEST_CASE(standard_json_base_path)
 	BOOST_TEST(result.reader.basePath() == "/" / tempDir.path().relative_path());
 }
 
+BOOST_AUTO_TEST_CASE(server_mode)
+{
+	std::string const preamble = "// SPDX-License-Identifier: GPL-3.0\\npragma solidity >=0.0;";
+	std::string input =
+		"{\"language\": \"Solidity\", \"sources\": {\"A\": {\"content\": \"" + preamble + " contract C {}\"}}}\n"
+		"\n"
+		"{\"language\": \"Solidity\", \"sources\": {\"B\": {\"content\": \"" + preamble + " contract D {}\"}}}\n"
+		"not JSON\n";
+
+	OptionsReaderAndMessages result = runCLI({"solc", "--server"}, input);
+	BOOST_TEST(result.success);
+	BOOST_TEST(result.stderrContent == "");
+	BOOST_TEST(result.options.input.mode == InputMode::Server);
+
+	std::vector<std::string> lines;
+	boost::split(lines, result.stdoutContent, boost::is_any_of("\n"));
+	BOOST_REQUIRE(lines.size() == 4);
+	BOOST_TEST(lines[3] == "");
+
+	Json output;
+	BOOST_REQUIRE(jsonParseStrict(lines[0], output));
+	BOOST_TEST(output["sources"]["A"]["id"] == 0);
+	BOOST_REQUIRE(jsonParseStrict(lines[1], output));
+	BOOST_TEST(output["sources"]["B"]["id"] == 0);
+	BOOST_TEST(!output["sources"].contains("A"));
+	BOOST_REQUIRE(jsonParseStrict(lines[2], output));
+	BOOST_TEST(output["errors"][0]["type"] == "JSONError");
+}
+
+BOOST_AUTO_TEST_CASE(server_mode_bounds_yul_strings)
+{
+	std::string const preamble = "// SPDX-License-Identifier: GPL-3.0\\npragma solidity >=0.0;";
+	size_t const inputCount = 50;
+	size_t const variablesPerInput = 20;
+	unsigned const yulStringLimit = 300;
+
+	// Every input uses different identifiers, which would pile up in the Yul string repository.
+	std::string input;
+	for (size_t i = 0; i < inputCount; ++i)
+	{
+		std::string assembly;
+		for (size_t j = 0; j < variablesPerInput; ++j)
+			assembly += "let v" + std::to_string(i) + "_" + std::to_string(j) + " := " + std::to_string(j) + " ";
+		assembly += "r := v" + std::to_string(i) + "_1";
+		input +=
+			"{\"language\": \"Solidity\", "
+			"\"settings\": {\"viaIR\": true, \"optimizer\": {\"enabled\": true}, \"outputSelection\": {\"*\": {\"*\": [\"irOptimized\"]}}}, "
+			"\"sources\": {\"A\": {\"content\": \"" + preamble +
+			" contract C { function f() public pure returns (uint r) { assembly { " + assembly + " } } }\"}}}\n";
+	}
+
+	OptionsReaderAndMessages result = runCLI({"solc", "--server", "--yul-string-limit=" + std::to_string(yulStringLimit)}, input);
+	BOOST_TEST(result.success);
+	BOOST_TEST(result.stderrContent == "");
+
+	std::vector<std::string> lines;
+	boost::split(lines, result.stdoutContent, boost::is_any_of("\n"));
+	BOOST_REQUIRE(lines.size() == inputCount + 1);
+	for (size_t i = 0; i < inputCount; ++i)
+	{
+		Json output;
+		BOOST_REQUIRE(jsonParseStrict(lines[i], output));
+		BOOST_TEST(!output.contains("errors"));
+		BOOST_TEST(output["contracts"]["A"]["C"]["irOptimized"].get<std::string>().find("function") != std::string::npos);
+	}
+
+	// The inputs used far more strings than the limit, but the server did not keep them.
+	BOOST_TEST(inputCount * variablesPerInput > 2 * yulStringLimit);
+	BOOST_TEST(yul::YulStringRepository::instance().size() <= yulStringLimit);
+}
+
+BOOST_AUTO_TEST_CASE(server_mode_input_files)
+{
+	std::string expectedMessage =
+		"Input files are not accepted in --server mode.\n"
+		"Please send the Standard JSON inputs to standard input, one per line.";
+
+	for (std::string const& inputFile: {"input.json", "-"})
+		BOOST_CHECK_EXCEPTION(
+			parseCommandLineAndReadInputFiles({"solc", "--server", inputFile}),
+			CommandLineValidationError,
+			[&](auto const& _exception) { BOOST_TEST(_exception.what() == expectedMessage); return true; }
+		);
+}
+
 BOOST_AUTO_TEST_CASE(standard_json_no_input_file)
 {
 	OptionsReaderAndMessages result = parseCommandLineAndReadInputFiles({"solc", "--standard-json"});
@@ -1104,6 +1192,103 @@ BOOST_AUTO_TEST_CASE(cli_no_output)
 	BOOST_REQUIRE(result.success);
 }
 
+BOOST_AUTO_TEST_CASE(cli_yul_cache_does_not_change_output)
+{
+	TemporaryDirectory tempDir(TEST_CASE_NAME);
+	std::string const contractSource = R"(
+		// SPDX-License-Identifier: GPL-3.0
+		pragma solidity >=0.0;
+		contract C {
+			uint[] a;
+			function f(uint x) public returns (uint) {
+				for (uint i = 0; i < x; ++i)
+					a.push(i * 3);
+				return a.length + x / 7;
+			}
+		}
+		contract D {
+			function g(uint x) public pure returns (uint) { return x * 0x1234567890 + 1; }
+		}
+	)";
+	std::vector<std::string> const commandLine = {
+		"solc",
+		"-",
+		"--via-ir",
+		"--optimize",
+		"--yul-cache-dir",
+		(tempDir.path() / "cache").string(),
+		"--debug-info",
+		"location,snippet",
+		"--ir-optimized",
+		"--asm",
+		"--bin",
+		"--combined-json",
+		"bin,srcmap,srcmap-runtime,generated-sources,generated-sources-runtime",
+	};
+
+	OptionsReaderAndMessages coldResult = runCLI(commandLine, contractSource);
+	BOOST_REQUIRE(coldResult.success);
+	BOOST_REQUIRE(!boost::filesystem::is_empty(tempDir.path() / "cache"));
+	BOOST_TEST(coldResult.stdoutContent.find("@src") != std::string::npos);
+
+	OptionsReaderAndMessages warmResult = runCLI(commandLine, contractSource);
+	BOOST_REQUIRE(warmResult.success);
+	BOOST_TEST(warmResult.stdoutContent == coldResult.stdoutContent);
+	BOOST_TEST(warmResult.stderrContent == coldResult.stderrContent);
+}
+
+BOOST_AUTO_TEST_CASE(cli_trace_out)
+{
+	TemporaryDirectory tempDir(TEST_CASE_NAME);
+	boost::filesystem::path const traceFile = tempDir.path() / "trace.json";
+	std::string const contractSource = R"(
+		// SPDX-License-Identifier: GPL-3.0
+		pragma solidity >=0.0;
+		contract C {
+			function f() public pure returns (uint) { return 1; }
+		}
+	)";
+	std::string const invalidSource = R"(
+		// SPDX-License-Identifier: GPL-3.0
+		pragma solidity >=0.0;
+		contract C {
+			function f() public pure returns (uint) { return true; }
+		}
+	)";
+	std::vector<std::string> const commandLine = {"solc", "-", "--bin", "--trace-out", traceFile.string()};
+	std::vector<std::string> commandLineWithOverwrite = commandLine;
+	commandLineWithOverwrite.emplace_back("--overwrite");
+
+	OptionsReaderAndMessages result = runCLI(commandLine, contractSource);
+	BOOST_REQUIRE(result.success);
+	BOOST_TEST(readFileAsString(traceFile).find("\"traceEvents\"") != std::string::npos);
+
+	createFileWithContent(traceFile, "old");
+	result = runCLI(commandLine, contractSource);
+	BOOST_TEST(!result.success);
+	BOOST_TEST(result.stderrContent.find("Refusing to overwrite existing file") != std::string::npos);
+	BOOST_TEST(readFileAsString(traceFile) == "old");
+
+	result = runCLI(commandLineWithOverwrite, contractSource);
+	BOOST_REQUIRE(result.success);
+	BOOST_TEST(readFileAsString(traceFile).find("\"traceEvents\"") != std::string::npos);
+
+	// The trace shows how far a failed compilation got.
+	boost::filesystem::remove(traceFile);
+	result = runCLI(commandLine, invalidSource);
+	BOOST_TEST(!result.success);
+	BOOST_TEST(result.stderrContent.find("TypeError") != std::string::npos);
+	BOOST_TEST(readFileAsString(traceFile).find("\"traceEvents\"") != std::string::npos);
+
+	// Failing to write the trace does not hide the compilation errors.
+	createFileWithContent(traceFile, "old");
+	result = runCLI(commandLine, invalidSource);
+	BOOST_TEST(!result.success);
+	BOOST_TEST(result.stderrContent.find("TypeError") != std::string::npos);
+	BOOST_TEST(result.stderrContent.find("Refusing to overwrite existing file") != std::string::npos);
+	BOOST_TEST(readFileAsString(traceFile) == "old");
+}
+
 BOOST_AUTO_TEST_CASE(standard_json_include_paths)
 {
 	TemporaryDirectory tempDir({"base/", "include/", "lib/nested/"}, TEST_CASE_NAME);
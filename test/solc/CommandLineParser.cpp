@@ -120,6 +120,9 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 			"--evm-version=spuriousDragon",
 			"--via-ir",
 			"--experimental-via-ir",
+			"--threads=4",
+			"--profile",
+			"--trace-out=/tmp/trace.json",
 			"--revert-strings=strip",
 			"--debug-info=location",
 			"--pretty-json",
@@ -143,6 +146,8 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 			"--optimize-yul",
 			"--optimize-runs=1000",
 			"--yul-optimizations=agf",
+			"--yul-cache-dir=/tmp/yul-cache",
+			"--yul-cache-size-limit=64",
 			"--model-checker-bmc-loop-iterations=2",
 			"--model-checker-contracts=contract1.yul:A,contract2.yul:B",
 			"--model-checker-div-mod-no-slacks",
@@ -181,6 +186,9 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 		expectedOptions.output.overwriteFiles = true;
 		expectedOptions.output.evmVersion = EVMVersion::spuriousDragon();
 		expectedOptions.output.viaIR = true;
+		expectedOptions.output.threads = 4;
+		expectedOptions.output.profile = true;
+		expectedOptions.output.traceFile = "/tmp/trace.json";
 		expectedOptions.output.revertStrings = RevertStrings::Strip;
 		expectedOptions.output.debugInfoSelection = DebugInfoSelection::fromString("location");
 		expectedOptions.formatting.json = JsonFormat{JsonFormat::Pretty, 7};
@@ -209,6 +217,8 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 		expectedOptions.optimizer.optimizeYul = true;
 		expectedOptions.optimizer.expectedExecutionsPerDeployment = 1000;
 		expectedOptions.optimizer.yulSteps = "agf";
+		expectedOptions.optimizer.yulCacheDir = "/tmp/yul-cache";
+		expectedOptions.optimizer.yulCacheSizeLimit = 64;
 
 		expectedOptions.modelChecker.initialize = true;
 		expectedOptions.modelChecker.settings = {
@@ -267,6 +277,49 @@ BOOST_AUTO_TEST_CASE(via_ir_options)
 		BOOST_TEST(parseCommandLine({"solc", viaIrOption, "contract.sol"}).output.viaIR);
 }
 
+BOOST_AUTO_TEST_CASE(threads_option)
+{
+	BOOST_TEST(parseCommandLine({"solc", "contract.sol"}).output.threads == 1);
+	BOOST_TEST(parseCommandLine({"solc", "--threads=8", "contract.sol"}).output.threads == 8);
+
+	std::string expectedMessage = "The number of threads must be at least 1.";
+	auto hasCorrectMessage = [&](CommandLineValidationError const& _exception) { return _exception.what() == expectedMessage; };
+	BOOST_CHECK_EXCEPTION(parseCommandLine({"solc", "--threads=0", "contract.sol"}), CommandLineValidationError, hasCorrectMessage);
+}
+
+BOOST_AUTO_TEST_CASE(yul_cache_options)
+{
+	CommandLineOptions options = parseCommandLine({"solc", "contract.sol"});
+	BOOST_TEST(!options.optimizer.yulCacheDir.has_value());
+	BOOST_TEST(options.optimizer.yulCacheSizeLimit == 1024);
+
+	options = parseCommandLine({"solc", "--yul-cache-dir=cache", "contract.sol"});
+	BOOST_CHECK(options.optimizer.yulCacheDir == boost::filesystem::path("cache"));
+	BOOST_TEST(options.optimizer.yulCacheSizeLimit == 1024);
+
+	std::string expectedMessage = "Option --yul-cache-size-limit can only be used together with --yul-cache-dir.";
+	auto hasCorrectMessage = [&](CommandLineValidationError const& _exception) { return _exception.what() == expectedMessage; };
+	BOOST_CHECK_EXCEPTION(
+		parseCommandLine({"solc", "--yul-cache-size-limit=10", "contract.sol"}),
+		CommandLineValidationError,
+		hasCorrectMessage
+	);
+}
+
+BOOST_AUTO_TEST_CASE(server_mode_options)
+{
+	CommandLineOptions options = parseCommandLine({"solc", "--server"});
+	BOOST_TEST(options.input.mode == InputMode::Server);
+	BOOST_TEST(options.optimizer.yulObjectCacheLimit == 1000);
+	BOOST_TEST(options.optimizer.yulStringLimit == 1000000);
+
+	options = parseCommandLine({"solc", "--server", "--yul-object-cache-limit=10", "--yul-string-limit=500", "--base-path=/home/user/"});
+	BOOST_TEST(options.input.mode == InputMode::Server);
+	BOOST_TEST(options.optimizer.yulObjectCacheLimit == 10);
+	BOOST_TEST(options.optimizer.yulStringLimit == 500);
+	BOOST_CHECK(options.input.basePath == boost::filesystem::path("/home/user/"));
+}
+
 BOOST_AUTO_TEST_CASE(assembly_mode_options)
 {
 	static std::vector<std::tuple<std::vector<std::string>, YulStack::Machine, YulStack::Language>> const allowedCombinations = {
@@ -423,6 +476,9 @@ BOOST_AUTO_TEST_CASE(invalid_options_input_modes_combinations)
 		// TODO: This should eventually contain all options.
 		{"--experimental-via-ir", {"--assemble", "--strict-assembly", "--standard-json", "--link"}},
 		{"--via-ir", {"--assemble", "--strict-assembly", "--standard-json", "--link"}},
+		{"--threads=2", {"--assemble", "--strict-assembly", "--standard-json", "--link"}},
+		{"--yul-cache-dir=cache", {"--assemble", "--strict-assembly", "--standard-json", "--link"}},
+		{"--yul-object-cache-limit=10", {"--assemble", "--strict-assembly", "--standard-json", "--link"}},
 		{"--metadata-literal", {"--assemble", "--strict-assembly", "--standard-json", "--link"}},
 		{"--metadata-hash=swarm", {"--assemble", "--strict-assembly", "--standard-json", "--link"}},
 		{"--model-checker-show-proved-safe", {"--assemble", "--strict-assembly", "--standard-json", "--link"}},
@@ -0,0 +1,334 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Benchmarks of the individual stages of the compiler over a fixed corpus of contracts.
+ * The results can be stored as JSON and compared with those of another commit.
+ */
+
+#include <libsolidity/interface/CompilerStack.h>
+#include <libsolidity/interface/OptimiserSettings.h>
+#include <libsolidity/interface/Version.h>
+#include <libsolidity/parsing/Parser.h>
+
+#include <libyul/optimiser/Suite.h>
+
+#include <liblangutil/CharStream.h>
+#include <liblangutil/ErrorReporter.h>
+#include <liblangutil/Scanner.h>
+
+#include <libsolutil/CommonIO.h>
+#include <libsolutil/JSON.h>
+#include <libsolutil/Keccak256.h>
+#include <libsolutil/Profiler.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <numeric>
+#include <optional>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace solidity;
+using namespace solidity::frontend;
+using namespace solidity::langutil;
+using namespace solidity::util;
+
+namespace po = boost::program_options;
+
+namespace
+{
+
+/// The contracts the benchmarks run on. Their hashes are stored along with the results, so that
+/// results obtained on a different corpus are not compared by accident.
+std::vector<std::string> const corpus{"OptimizorClub.sol", "chains.sol", "verifier.sol"};
+
+/// Sizes of the inputs of the keccak256 benchmarks, in bytes.
+std::vector<size_t> const keccakInputSizes{32, 1024, 65536};
+
+using Clock = std::chrono::steady_clock;
+
+/// Time per operation, in nanoseconds, measured in each repetition of a benchmark.
+using Samples = std::vector<double>;
+
+class Benchmarks
+{
+public:
+	explicit Benchmarks(std::string _filter): m_filter(std::move(_filter)) {}
+
+	bool selected(std::string const& _name) const
+	{
+		return _name.find(m_filter) != std::string::npos;
+	}
+
+	void record(std::string const& _name, double _nanoseconds)
+	{
+		if (selected(_name))
+			m_samples[_name].push_back(_nanoseconds);
+	}
+
+	/// Runs @a _operation @a _count times and records the average time it took.
+	template <typename Operation>
+	void measure(std::string const& _name, size_t _count, Operation const& _operation)
+	{
+		if (!selected(_name))
+			return;
+		Clock::time_point start = Clock::now();
+		for (size_t i = 0; i < _count; ++i)
+			_operation();
+		auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start);
+		record(_name, double(duration.count()) / double(_count));
+	}
+
+	std::map<std::string, Samples> const& samples() const { return m_samples; }
+
+private:
+	std::string m_filter;
+	std::map<std::string, Samples> m_samples;
+};
+
+double median(Samples _samples)
+{
+	std::sort(_samples.begin(), _samples.end());
+	size_t middle = _samples.size() / 2;
+	return _samples.size() % 2 == 1 ? _samples[middle] : (_samples[middle - 1] + _samples[middle]) / 2;
+}
+
+void benchmarkScannerAndParser(Benchmarks& _benchmarks, std::string const& _name, std::string const& _source)
+{
+	_benchmarks.measure("Scanner/" + _name, 1, [&]() {
+		CharStream stream(_source, _name);
+		Scanner scanner(stream);
+		while (scanner.next() != Token::EOS) {}
+	});
+	_benchmarks.measure("Parser/" + _name, 1, [&]() {
+		ErrorList errors;
+		ErrorReporter errorReporter(errors);
+		CharStream stream(_source, _name);
+		if (!Parser(errorReporter, EVMVersion{}, std::nullopt).parse(stream))
+			throw std::runtime_error("Failed to parse " + _name + ".");
+	});
+}
+
+/// @returns the names of all phases the profiler can report for a compilation, i.e. the names of
+/// the profiler probes of the compiler and of all Yul optimizer steps.
+std::set<std::string> pipelinePhases()
+{
+	std::set<std::string> phases{
+		"ASTJsonImporter", "AsmAnalyzer", "Assembler", "ConstantOptimiser", "ContractCompiler",
+		"ContractLevelChecker", "ControlFlowAnalyzer", "DeclarationTypeChecker", "Disambiguator",
+		"DocStringAnalyser", "DocStringTagParser", "EVMObjectCompiler", "FunctionCallGraphBuilder",
+		"IRGenerator", "ImmutableValidator", "ModelChecker", "NameAndTypeResolver", "NameSimplifier",
+		"ObjectOptimizer", "ObjectParser", "Parser", "PostTypeChecker", "PostTypeContractLevelChecker",
+		"Scoper", "StackCompressor", "StackLayoutGenerator", "StackLimitEvader", "StaticAnalyzer",
+		"SyntaxChecker", "TypeChecker", "VarNameCleaner", "ViewPureChecker",
+		"experimental::Analysis", "experimental::IRGenerator"
+	};
+	for (auto const& step: yul::OptimiserSuite::allSteps())
+		phases.insert(step.first);
+	return phases;
+}
+
+/// Compiles the source via the IR with the optimizer enabled and records the time spent in each
+/// compilation phase, as reported by the profiler, summed over all contracts.
+void benchmarkPipeline(Benchmarks& _benchmarks, std::string const& _name, std::string const& _source)
+{
+	// The compilation takes long, so it is skipped if none of its benchmarks is selected.
+	static std::set<std::string> const phases = pipelinePhases();
+	if (std::none_of(phases.begin(), phases.end(), [&](std::string const& _phase) {
+		return _benchmarks.selected(_phase + "/" + _name);
+	}))
+		return;
+
+	CompilerStack compiler;
+	compiler.setSources({{_name, _source}});
+	compiler.setViaIR(true);
+	compiler.setOptimiserSettings(OptimiserSettings::standard());
+	compiler.setProfiling(true);
+	if (!compiler.compile())
+		throw std::runtime_error("Failed to compile " + _name + ".");
+
+	std::map<std::string, Profiler::Metrics> phases = compiler.profiler()->metrics();
+	for (std::string const& contract: compiler.contractNames())
+		for (auto const& [phase, metrics]: compiler.contractProfiler(contract)->metrics())
+		{
+			Profiler::Metrics& total = phases[phase];
+			total.durationInMicroseconds += metrics.durationInMicroseconds;
+			total.callCount += metrics.callCount;
+		}
+	for (auto const& [phase, metrics]: phases)
+		_benchmarks.record(phase + "/" + _name, double(metrics.durationInMicroseconds.count()) * 1000.0);
+}
+
+void benchmarkKeccak256(Benchmarks& _benchmarks)
+{
+	for (size_t size: keccakInputSizes)
+	{
+		bytes input(size, 0xab);
+		h256 hash;
+		// Hash about 16 MiB in total, but at least a thousand times.
+		size_t count = std::max<size_t>(1000, (size_t(16) << 20) / size);
+		_benchmarks.measure("keccak256/" + std::to_string(size), count, [&]() {
+			hash = keccak256(input);
+			input[0] = hash[0];
+		});
+	}
+}
+
+Json toJson(Benchmarks const& _benchmarks, Json _context)
+{
+	Json benchmarks = Json::array();
+	for (auto const& [name, samples]: _benchmarks.samples())
+		benchmarks.push_back({
+			{"name", name},
+			{"repetitions", Json::number_unsigned_t(samples.size())},
+			{"real_time", median(samples)},
+			{"min_time", *std::min_element(samples.begin(), samples.end())},
+			{"mean_time", std::accumulate(samples.begin(), samples.end(), 0.0) / double(samples.size())},
+			{"time_unit", "ns"}
+		});
+	return {{"context", std::move(_context)}, {"benchmarks", std::move(benchmarks)}};
+}
+
+void printResults(Json const& _results, std::optional<Json> const& _baseline)
+{
+	std::map<std::string, double> baselineTimes;
+	if (_baseline)
+		for (Json const& benchmark: _baseline->value("benchmarks", Json::array()))
+			baselineTimes[benchmark["name"].get<std::string>()] = benchmark["real_time"].get<double>();
+
+	std::cout << std::left << std::setw(48) << "benchmark" << std::right << std::setw(16) << "median" << std::setw(16) << "min";
+	if (_baseline)
+		std::cout << std::setw(16) << "baseline" << std::setw(10) << "change";
+	std::cout << std::endl;
+	for (Json const& benchmark: _results["benchmarks"])
+	{
+		std::string name = benchmark["name"].get<std::string>();
+		double time = benchmark["real_time"].get<double>();
+		std::cout <<
+			std::left << std::setw(48) << name <<
+			std::right << std::fixed << std::setprecision(0) <<
+			std::setw(13) << time << " ns" <<
+			std::setw(13) << benchmark["min_time"].get<double>() << " ns";
+		if (_baseline && baselineTimes.count(name) && baselineTimes.at(name) > 0)
+			std::cout <<
+				std::setw(13) << baselineTimes.at(name) << " ns" <<
+				std::setw(9) << std::showpos << std::setprecision(1) << (time / baselineTimes.at(name) - 1) * 100 << std::noshowpos << "%";
+		std::cout << std::endl;
+	}
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	po::options_description options(
+		R"(solbench, benchmarks of the compiler stages over a fixed corpus.
+Usage: solbench [Options]
+
+Allowed options)",
+		po::options_description::m_default_line_length,
+		po::options_description::m_default_line_length - 23
+	);
+	options.add_options()
+		("corpus", po::value<std::string>()->default_value(SOLBENCH_CORPUS_DIR), "directory containing the benchmark contracts")
+		("repetitions", po::value<size_t>()->default_value(5), "number of measured runs of each benchmark")
+		("filter", po::value<std::string>()->default_value(""), "only run the benchmarks whose name contains the given string")
+		("output", po::value<std::string>(), "write the results as JSON to the given file")
+		("compare", po::value<std::string>(), "compare the results with the ones stored in the given file")
+		("help", "Show this help screen.");
+	po::variables_map arguments;
+	try
+	{
+		po::store(po::parse_command_line(argc, argv, options), arguments);
+		po::notify(arguments);
+	}
+	catch (po::error const& _exception)
+	{
+		std::cerr << _exception.what() << std::endl;
+		return 1;
+	}
+	if (arguments.count("help"))
+	{
+		std::cout << options;
+		return 0;
+	}
+
+	try
+	{
+		std::optional<Json> baseline;
+		if (arguments.count("compare"))
+		{
+			baseline = Json{};
+			std::string error;
+			if (!jsonParseStrict(readFileAsString(arguments["compare"].as<std::string>()), *baseline, &error))
+				throw std::runtime_error("Invalid baseline: " + error);
+		}
+
+		boost::filesystem::path corpusDirectory = arguments["corpus"].as<std::string>();
+		std::map<std::string, std::string> sources;
+		Json context;
+		context["version"] = VersionString;
+		for (std::string const& name: corpus)
+		{
+			sources[name] = readFileAsString(corpusDirectory / name);
+			context["corpus"][name] = keccak256(sources[name]).hex();
+		}
+		if (baseline && (*baseline)["context"]["corpus"] != context["corpus"])
+			std::cerr << "Warning: The baseline was measured on a different corpus." << std::endl;
+
+		Benchmarks benchmarks(arguments["filter"].as<std::string>());
+		size_t repetitions = std::max<size_t>(arguments["repetitions"].as<size_t>(), 1);
+		context["repetitions"] = repetitions;
+		// The first run only warms up the caches and is not recorded.
+		for (size_t repetition = 0; repetition <= repetitions; ++repetition)
+		{
+			Benchmarks warmup(arguments["filter"].as<std::string>());
+			Benchmarks& recorder = repetition == 0 ? warmup : benchmarks;
+			for (auto const& [name, source]: sources)
+			{
+				benchmarkScannerAndParser(recorder, name, source);
+				benchmarkPipeline(recorder, name, source);
+			}
+			benchmarkKeccak256(recorder);
+		}
+
+		Json results = toJson(benchmarks, std::move(context));
+		printResults(results, baseline);
+		if (arguments.count("output"))
+		{
+			std::ofstream outputFile(arguments["output"].as<std::string>());
+			outputFile << jsonPrettyPrint(results) << std::endl;
+			if (!outputFile)
+				throw std::runtime_error("Could not write to " + arguments["output"].as<std::string>() + ".");
+		}
+	}
+	catch (std::exception const& _exception)
+	{
+		std::cerr << _exception.what() << std::endl;
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,182 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Microbenchmark comparing the boost::multiprecision based evaluation of EVM arithmetic,
+ * as used by constant folding before, with the allocation-free NativeU256.
+ */
+
+#include <libsolutil/NativeU256.h>
+#include <libsolutil/Numeric.h>
+
+#include <boost/program_options.hpp>
+
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace solidity;
+using namespace solidity::util;
+
+namespace po = boost::program_options;
+
+namespace
+{
+
+struct Operands
+{
+	std::vector<u256> boostValues;
+	std::vector<NativeU256> nativeValues;
+};
+
+Operands randomOperands(size_t _count)
+{
+	std::mt19937_64 generator(1);
+	Operands operands;
+	for (size_t i = 0; i < _count; ++i)
+	{
+		u256 value;
+		for (size_t j = 0; j < 4; ++j)
+			value = (value << 64) | generator();
+		// Mix full-width values with short ones, which are the most common in practice.
+		value >>= unsigned(generator() % 256);
+		operands.boostValues.emplace_back(value);
+		operands.nativeValues.emplace_back(value);
+	}
+	return operands;
+}
+
+/// Runs @a _operation on all consecutive pairs of operands @a _iterations times
+/// and @returns the time per operation in nanoseconds.
+template <class Value>
+double measure(std::vector<Value> const& _values, size_t _iterations, std::function<Value(Value const&, Value const&)> const& _operation)
+{
+	Value sink{};
+	auto start = std::chrono::steady_clock::now();
+	for (size_t iteration = 0; iteration < _iterations; ++iteration)
+		for (size_t i = 0; i + 1 < _values.size(); ++i)
+			sink ^= _operation(_values[i], _values[i + 1]);
+	auto duration = std::chrono::steady_clock::now() - start;
+	// Prevent the computation from being optimized away.
+	if (sink == Value(1))
+		std::cerr << "";
+	double operations = double(_iterations) * double(_values.size() - 1);
+	return double(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count()) / operations;
+}
+
+void report(
+	std::string const& _name,
+	Operands const& _operands,
+	size_t _iterations,
+	std::function<u256(u256 const&, u256 const&)> const& _boostOperation,
+	std::function<NativeU256(NativeU256 const&, NativeU256 const&)> const& _nativeOperation
+)
+{
+	double boostTime = measure(_operands.boostValues, _iterations, _boostOperation);
+	double nativeTime = measure(_operands.nativeValues, _iterations, _nativeOperation);
+	std::cout <<
+		std::left << std::setw(8) << _name <<
+		std::right << std::fixed << std::setprecision(1) <<
+		std::setw(12) << boostTime << " ns" <<
+		std::setw(12) << nativeTime << " ns" <<
+		std::setw(10) << boostTime / nativeTime << "x" <<
+		std::endl;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	po::options_description options(
+		R"(u256bench, microbenchmark of 256-bit EVM arithmetic.
+Usage: u256bench [Options]
+
+Allowed options)",
+		po::options_description::m_default_line_length,
+		po::options_description::m_default_line_length - 23
+	);
+	options.add_options()
+		("iterations", po::value<size_t>()->default_value(200), "number of passes over the operands")
+		("operands", po::value<size_t>()->default_value(1000), "number of random operands")
+		("help", "Show this help screen.");
+	po::variables_map arguments;
+	try
+	{
+		po::store(po::parse_command_line(argc, argv, options), arguments);
+		po::notify(arguments);
+	}
+	catch (po::error const& _exception)
+	{
+		std::cerr << _exception.what() << std::endl;
+		return 1;
+	}
+	if (arguments.count("help"))
+	{
+		std::cout << options;
+		return 0;
+	}
+
+	size_t iterations = arguments["iterations"].as<size_t>();
+	Operands operands = randomOperands(std::max<size_t>(arguments["operands"].as<size_t>(), 2));
+	bigint const modulus = bigint(1) << 256;
+
+	std::cout << std::left << std::setw(8) << "op" << std::right << std::setw(15) << "boost" << std::setw(15) << "native" << std::setw(11) << "speedup" << std::endl;
+	report(
+		"add", operands, iterations,
+		[](u256 const& _a, u256 const& _b) { return u256(_a + _b); },
+		[](NativeU256 const& _a, NativeU256 const& _b) { return _a + _b; }
+	);
+	report(
+		"mul", operands, iterations,
+		[](u256 const& _a, u256 const& _b) { return u256(_a * _b); },
+		[](NativeU256 const& _a, NativeU256 const& _b) { return _a * _b; }
+	);
+	report(
+		"div", operands, iterations,
+		[](u256 const& _a, u256 const& _b) { return _b == 0 ? u256(0) : u256(bigint(_a) / bigint(_b)); },
+		[](NativeU256 const& _a, NativeU256 const& _b) { return _a / _b; }
+	);
+	report(
+		"sdiv", operands, iterations,
+		[](u256 const& _a, u256 const& _b) { return _b == 0 ? u256(0) : s2u(s256(bigint(u2s(_a)) / bigint(u2s(_b)))); },
+		[](NativeU256 const& _a, NativeU256 const& _b) { return sdiv(_a, _b); }
+	);
+	report(
+		"slt", operands, iterations,
+		[](u256 const& _a, u256 const& _b) { return u256(u2s(_a) < u2s(_b) ? 1 : 0); },
+		[](NativeU256 const& _a, NativeU256 const& _b) { return NativeU256(slt(_a, _b) ? 1 : 0); }
+	);
+	report(
+		"exp", operands, iterations,
+		[&](u256 const& _a, u256 const& _b) { return u256(boost::multiprecision::powm(bigint(_a), bigint(_b), modulus)); },
+		[](NativeU256 const& _a, NativeU256 const& _b) { return exp(_a, _b); }
+	);
+	report(
+		"mulmod", operands, iterations,
+		[](u256 const& _a, u256 const& _b) { return _b == 0 ? u256(0) : u256((bigint(_a) * bigint(_b)) % _b); },
+		[](NativeU256 const& _a, NativeU256 const& _b) { return mulmod(_a, _b, _b); }
+	);
+	report(
+		"addmod", operands, iterations,
+		[](u256 const& _a, u256 const& _b) { return _b == 0 ? u256(0) : u256((bigint(_a) + bigint(_b)) % _b); },
+		[](NativeU256 const& _a, NativeU256 const& _b) { return addmod(_a, _b, _b); }
+	);
+	return 0;
+}
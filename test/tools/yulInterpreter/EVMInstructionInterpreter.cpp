@@ -32,9 +32,11 @@
 
 #include <liblangutil/Exceptions.h>
 #include <libsolutil/Keccak256.h>
+#include <libsolutil/NativeU256.h>
 #include <libsolutil/Numeric.h>
 #include <libsolutil/picosha2.h>
 
+#include <algorithm>
 #include <limits>
 
 using namespace solidity;
@@ -45,6 +47,7 @@ using namespace solidity::yul::test;
 using solidity::util::h160;
 using solidity::util::h256;
 using solidity::util::keccak256;
+using solidity::util::NativeU256;
 
 namespace
 {
@@ -78,31 +81,33 @@ namespace solidity::yul::test
 {
 
 void copyZeroExtended(
-	std::map<u256, uint8_t>& _target,
+	Memory& _target,
 	bytes const& _source,
 	size_t _targetOffset,
 	size_t _sourceOffset,
 	size_t _size
 )
 {
-	for (size_t i = 0; i < _size; ++i)
-		_target[_targetOffset + i] = (_sourceOffset + i < _source.size() ? _source[_sourceOffset + i] : 0);
+	bytes data(_size, 0);
+	if (_sourceOffset < _source.size())
+		std::copy_n(
+			_source.data() + _sourceOffset,
+			std::min(_size, _source.size() - _sourceOffset),
+			data.data()
+		);
+	_target.write(_targetOffset, bytesConstRef(data.data(), data.size()));
 }
 
 void copyZeroExtendedWithOverlap(
-	std::map<u256, uint8_t>& _target,
-	std::map<u256, uint8_t> const& _source,
+	Memory& _target,
+	Memory const& _source,
 	size_t _targetOffset,
 	size_t _sourceOffset,
 	size_t _size
 )
 {
-	if (_targetOffset >= _sourceOffset)
-		for (size_t i = _size; i > 0; --i)
-			_target[_targetOffset + i - 1] = (_source.count(_sourceOffset + i - 1) != 0 ? _source.at(_sourceOffset + i - 1) : 0);
-	else
-		for (size_t i = 0; i < _size; ++i)
-			_target[_targetOffset + i] = (_source.count(_sourceOffset + i) != 0 ? _source.at(_sourceOffset + i) : 0);
+	bytes const data = _source.read(_sourceOffset, _size);
+	_target.write(_targetOffset, bytesConstRef(data.data(), data.size()));
 }
 
 }
@@ -134,13 +139,13 @@ u256 EVMInstructionInterpreter::eval(
 	case Instruction::DIV:
 		return arg[1] == 0 ? 0 : arg[0] / arg[1];
 	case Instruction::SDIV:
-		return arg[1] == 0 ? 0 : s2u(u2s(arg[0]) / u2s(arg[1]));
+		return util::sdiv(NativeU256(arg[0]), NativeU256(arg[1])).toU256();
 	case Instruction::MOD:
 		return arg[1] == 0 ? 0 : arg[0] % arg[1];
 	case Instruction::SMOD:
-		return arg[1] == 0 ? 0 : s2u(u2s(arg[0]) % u2s(arg[1]));
+		return util::smod(NativeU256(arg[0]), NativeU256(arg[1])).toU256();
 	case Instruction::EXP:
-		return exp256(arg[0], arg[1]);
+		return util::exp(NativeU256(arg[0]), NativeU256(arg[1])).toU256();
 	case Instruction::NOT:
 		return ~arg[0];
 	case Instruction::LT:
@@ -148,9 +153,9 @@ u256 EVMInstructionInterpreter::eval(
 	case Instruction::GT:
 		return arg[0] > arg[1] ? 1 : 0;
 	case Instruction::SLT:
-		return u2s(arg[0]) < u2s(arg[1]) ? 1 : 0;
+		return util::slt(NativeU256(arg[0]), NativeU256(arg[1])) ? 1 : 0;
 	case Instruction::SGT:
-		return u2s(arg[0]) > u2s(arg[1]) ? 1 : 0;
+		return util::sgt(NativeU256(arg[0]), NativeU256(arg[1])) ? 1 : 0;
 	case Instruction::EQ:
 		return arg[0] == arg[1] ? 1 : 0;
 	case Instruction::ISZERO:
@@ -168,37 +173,13 @@ u256 EVMInstructionInterpreter::eval(
 	case Instruction::SHR:
 		return arg[0] > 255 ? 0 : (arg[1] >> unsigned(arg[0]));
 	case Instruction::SAR:
-	{
-		static u256 const hibit = u256(1) << 255;
-		if (arg[0] >= 256)
-			return arg[1] & hibit ? u256(-1) : 0;
-		else
-		{
-			unsigned amount = unsigned(arg[0]);
-			u256 v = arg[1] >> amount;
-			if (arg[1] & hibit)
-				v |= u256(-1) << (256 - amount);
-			return v;
-		}
-	}
+		return util::sar(NativeU256(arg[1]), arg[0] >= 256 ? 256 : unsigned(arg[0])).toU256();
 	case Instruction::ADDMOD:
-		return arg[2] == 0 ? 0 : u256((u512(arg[0]) + u512(arg[1])) % arg[2]);
+		return util::addmod(NativeU256(arg[0]), NativeU256(arg[1]), NativeU256(arg[2])).toU256();
 	case Instruction::MULMOD:
-		return arg[2] == 0 ? 0 : u256((u512(arg[0]) * u512(arg[1])) % arg[2]);
+		return util::mulmod(NativeU256(arg[0]), NativeU256(arg[1]), NativeU256(arg[2])).toU256();
 	case Instruction::SIGNEXTEND:
-		if (arg[0] >= 31)
-			return arg[1];
-		else
-		{
-			unsigned testBit = unsigned(arg[0]) * 8 + 7;
-			u256 ret = arg[1];
-			u256 mask = ((u256(1) << testBit) - 1);
-			if (boost::multiprecision::bit_test(ret, testBit))
-				ret |= ~mask;
-			else
-				ret &= mask;
-			return ret;
-		}
+		return util::signextend(arg[0] >= 31 ? 31 : unsigned(arg[0]), NativeU256(arg[1])).toU256();
 	// --------------- blockchain stuff ---------------
 	case Instruction::KECCAK256:
 	{
@@ -314,7 +295,7 @@ u256 EVMInstructionInterpreter::eval(
 		return 0;
 	case Instruction::MSTORE8:
 		accessMemory(arg[0], 1);
-		m_state.memory[arg[0]] = uint8_t(arg[1] & 0xff);
+		m_state.memory.write(arg[0], uint8_t(arg[1] & 0xff));
 		return 0;
 	case Instruction::SLOAD:
 		return m_state.storage[h256(arg[0])];
@@ -575,21 +556,17 @@ bool EVMInstructionInterpreter::accessMemory(u256 const& _offset, u256 const& _s
 bytes EVMInstructionInterpreter::readMemory(u256 const& _offset, u256 const& _size)
 {
 	yulAssert(_size <= s_maxRangeSize, "Too large read.");
-	bytes data(size_t(_size), uint8_t(0));
-	for (size_t i = 0; i < data.size(); ++i)
-		data[i] = m_state.memory[_offset + i];
-	return data;
+	return m_state.memory.read(_offset, size_t(_size));
 }
 
 u256 EVMInstructionInterpreter::readMemoryWord(u256 const& _offset)
 {
-	return u256(h256(m_state.readMemory(_offset, 32)));
+	return m_state.memory.readWord(_offset);
 }
 
 void EVMInstructionInterpreter::writeMemoryWord(u256 const& _offset, u256 const& _value)
 {
-	for (size_t i = 0; i < 32; i++)
-		m_state.memory[_offset + i] = uint8_t((_value >> (8 * (31 - i))) & 0xff);
+	m_state.memory.writeWord(_offset, _value);
 }
 
 
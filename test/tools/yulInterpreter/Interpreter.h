@@ -21,6 +21,8 @@
 
 #pragma once
 
+#include <test/tools/yulInterpreter/Memory.h>
+
 #include <libyul/ASTForward.h>
 #include <libyul/optimiser/ASTWalker.h>
 
@@ -77,8 +79,8 @@ struct InterpreterState
 {
 	bytes calldata;
 	bytes returndata;
-	std::map<u256, uint8_t> memory;
-	/// This is different than memory.size() because we ignore gas.
+	Memory memory;
+	/// This is different than the extent of the memory written to because we ignore gas.
 	u256 msize;
 	std::map<util::h256, util::h256> storage;
 	std::map<util::h256, util::h256> transientStorage;
@@ -132,10 +134,7 @@ struct InterpreterState
 	bytes readMemory(u256 const& _offset, u256 const& _size)
 	{
 		yulAssert(_size <= 0xffff, "Too large read.");
-		bytes data(size_t(_size), uint8_t(0));
-		for (size_t i = 0; i < data.size(); ++i)
-			data[i] = memory[_offset + i];
-		return data;
+		return memory.read(_offset, size_t(_size));
 	}
 };
 
@@ -0,0 +1,116 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <test/tools/yulInterpreter/Memory.h>
+
+#include <libsolutil/FixedHash.h>
+
+#include <algorithm>
+
+using namespace solidity;
+using namespace solidity::yul::test;
+
+using solidity::util::h256;
+
+namespace
+{
+
+size_t constexpr pageBits = 10;
+static_assert(Memory::pageSize == size_t(1) << pageBits);
+
+u256 pageIndex(u256 const& _offset)
+{
+	return _offset >> pageBits;
+}
+
+size_t offsetInPage(u256 const& _offset)
+{
+	return static_cast<size_t>(_offset & (Memory::pageSize - 1));
+}
+
+}
+
+uint8_t Memory::read(u256 const& _offset) const
+{
+	Page const* page = findPage(_offset);
+	return page ? (*page)[offsetInPage(_offset)] : 0;
+}
+
+bytes Memory::read(u256 const& _offset, size_t _size) const
+{
+	bytes data(_size, 0);
+	u256 offset = _offset;
+	for (size_t position = 0; position < _size;)
+	{
+		size_t const chunkOffset = offsetInPage(offset);
+		size_t const chunkSize = std::min(pageSize - chunkOffset, _size - position);
+		if (Page const* page = findPage(offset))
+			std::copy_n(page->data() + chunkOffset, chunkSize, data.data() + position);
+		position += chunkSize;
+		offset += chunkSize;
+	}
+	return data;
+}
+
+u256 Memory::readWord(u256 const& _offset) const
+{
+	size_t const wordOffset = offsetInPage(_offset);
+	if (wordOffset + 32 > pageSize)
+		return u256(h256(read(_offset, 32)));
+
+	Page const* page = findPage(_offset);
+	return page ? u256(h256(bytesConstRef(page->data() + wordOffset, 32))) : 0;
+}
+
+void Memory::write(u256 const& _offset, uint8_t _value)
+{
+	write(_offset, bytesConstRef(&_value, 1));
+}
+
+void Memory::write(u256 const& _offset, bytesConstRef _data)
+{
+	u256 offset = _offset;
+	for (size_t position = 0; position < _data.size();)
+	{
+		size_t const chunkOffset = offsetInPage(offset);
+		size_t const chunkSize = std::min(pageSize - chunkOffset, _data.size() - position);
+		uint8_t const* chunk = _data.data() + position;
+
+		auto page = m_pages.find(pageIndex(offset));
+		// Writing zeros to a page that is not allocated does not change anything.
+		if (page == m_pages.end() && std::any_of(chunk, chunk + chunkSize, [](uint8_t _byte) { return _byte != 0; }))
+			page = m_pages.emplace(pageIndex(offset), Page{}).first;
+		if (page != m_pages.end())
+			std::copy_n(chunk, chunkSize, page->second.data() + chunkOffset);
+
+		position += chunkSize;
+		offset += chunkSize;
+	}
+}
+
+void Memory::writeWord(u256 const& _offset, u256 const& _value)
+{
+	h256 const value(_value);
+	write(_offset, value.ref());
+}
+
+Memory::Page const* Memory::findPage(u256 const& _offset) const
+{
+	auto page = m_pages.find(pageIndex(_offset));
+	return page != m_pages.end() ? &page->second : nullptr;
+}
@@ -0,0 +1,71 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Memory of the Yul interpreter.
+ */
+
+#pragma once
+
+#include <libsolutil/Common.h>
+#include <libsolutil/CommonData.h>
+#include <libsolutil/Numeric.h>
+
+#include <array>
+#include <map>
+
+namespace solidity::yul::test
+{
+
+/**
+ * Byte-addressable memory covering the whole 256-bit address space, with addresses wrapping around.
+ *
+ * The memory is stored in zero-initialized pages that are only allocated once a non-zero byte is
+ * written to them, so reading never allocates and an access of a contiguous range only touches
+ * the pages it spans.
+ */
+class Memory
+{
+public:
+	static constexpr size_t pageSize = 0x400;
+	using Page = std::array<uint8_t, pageSize>;
+
+	/// @returns the byte at @a _offset.
+	uint8_t read(u256 const& _offset) const;
+	/// @returns the @a _size bytes starting at @a _offset.
+	bytes read(u256 const& _offset, size_t _size) const;
+	/// @returns the 32 bytes starting at @a _offset as a big-endian number.
+	u256 readWord(u256 const& _offset) const;
+
+	/// Sets the byte at @a _offset to @a _value.
+	void write(u256 const& _offset, uint8_t _value);
+	/// Copies @a _data to the memory starting at @a _offset.
+	void write(u256 const& _offset, bytesConstRef _data);
+	/// Stores @a _value as a big-endian number in the 32 bytes starting at @a _offset.
+	void writeWord(u256 const& _offset, u256 const& _value);
+
+	/// @returns the allocated pages by their index, i.e. the offset of their first byte divided by pageSize.
+	std::map<u256, Page> const& pages() const { return m_pages; }
+
+private:
+	/// @returns the page containing the byte at @a _offset or nullptr if it is not allocated.
+	Page const* findPage(u256 const& _offset) const;
+
+	std::map<u256, Page> m_pages;
+};
+
+}